@@ -0,0 +1,232 @@
+#include "BenchmarkHarness.h"
+#include "corpus/CorpusGenerator.h"
+#include "shared/utils/FileSystem.h"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+namespace artic::bench {
+
+// ============================================================================
+// Inputs
+// ============================================================================
+
+BenchmarkRunner::BenchmarkRunner(int argc, char** argv) {
+    std::vector<std::filesystem::path> paths;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--min-time" && i + 1 < argc) {
+            m_minTime = std::chrono::milliseconds(std::atoi(argv[++i]));
+        } else if (arg == "--json") {
+            m_json = true;
+        } else if (arg == "--help" || arg == "-h") {
+            std::cout << "Usage: " << argv[0] << " [--min-time <ms>] [--json] [file.atc | dir ...]\n";
+            std::exit(0);
+        } else {
+            paths.emplace_back(arg);
+        }
+    }
+
+    if (paths.empty()) {
+        addInputs(ARTIC_BENCH_EXAMPLES_DIR);
+        addGeneratedInput();
+    }
+    for (const auto& path : paths) {
+        addInputs(path);
+    }
+
+    if (m_inputs.empty()) {
+        std::cerr << "No .atc inputs found\n";
+        std::exit(1);
+    }
+}
+
+BenchmarkRunner::~BenchmarkRunner() {
+    if (!m_tempDir.empty()) {
+        std::error_code ec;
+        std::filesystem::remove_all(m_tempDir, ec);
+    }
+}
+
+void BenchmarkRunner::addInputs(const std::filesystem::path& path) {
+    std::vector<std::filesystem::path> files;
+    if (std::filesystem::is_directory(path)) {
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(path)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".atc") {
+                files.push_back(entry.path());
+            }
+        }
+        std::sort(files.begin(), files.end());
+    } else {
+        files.push_back(path);
+    }
+
+    for (const auto& file : files) {
+        auto contents = FileSystem::readFile(file);
+        if (!contents) {
+            std::cerr << "Cannot read " << file.string() << "\n";
+            continue;
+        }
+
+        // Label relative to the directory given ("with_imports/App.atc")
+        std::string name = std::filesystem::is_directory(path)
+            ? std::filesystem::relative(file, path).generic_string()
+            : file.filename().string();
+        m_inputs.push_back({name, file, std::move(*contents)});
+    }
+}
+
+void BenchmarkRunner::addGeneratedInput() {
+    auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+    m_tempDir = std::filesystem::temp_directory_path() / ("artic_bench_" + std::to_string(stamp));
+    std::filesystem::create_directories(m_tempDir);
+
+    // One large page using a small component library
+    CorpusOptions options;
+    options.components = 30;
+    options.pages = 1;
+    options.fanOut = 4;
+    options.sections = 60;
+
+    auto files = CorpusGenerator(options).generate();
+    std::string error;
+    if (!CorpusGenerator::write(files, m_tempDir, error)) {
+        std::cerr << error << "\n";
+        return;
+    }
+
+    const CorpusFile& page = files.back();
+    m_inputs.push_back({"generated/" + CorpusGenerator::pageName(0) + ".atc", m_tempDir / page.path, page.source});
+}
+
+// ============================================================================
+// Reporting
+// ============================================================================
+
+namespace {
+
+std::string formatTime(double ns) {
+    char buffer[32];
+    if (ns >= 1e6) {
+        std::snprintf(buffer, sizeof(buffer), "%.2f ms", ns / 1e6);
+    } else if (ns >= 1e3) {
+        std::snprintf(buffer, sizeof(buffer), "%.2f us", ns / 1e3);
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "%.0f ns", ns);
+    }
+    return buffer;
+}
+
+// 1.2G, 34.5M, 678K, 9.1
+std::string formatRate(double perSecond) {
+    char buffer[32];
+    if (perSecond >= 1e9) {
+        std::snprintf(buffer, sizeof(buffer), "%.2fG", perSecond / 1e9);
+    } else if (perSecond >= 1e6) {
+        std::snprintf(buffer, sizeof(buffer), "%.2fM", perSecond / 1e6);
+    } else if (perSecond >= 1e3) {
+        std::snprintf(buffer, sizeof(buffer), "%.2fK", perSecond / 1e3);
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "%.1f", perSecond);
+    }
+    return buffer;
+}
+
+std::string jsonString(const std::string& value) {
+    std::string result = "\"";
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+        }
+        result += c;
+    }
+    return result + "\"";
+}
+
+} // namespace
+
+int BenchmarkRunner::finish() {
+    if (m_json) {
+        printJson();
+    } else {
+        printTable();
+    }
+    return 0;
+}
+
+void BenchmarkRunner::printTable() const {
+    std::printf("%-32s %-28s %12s %10s %22s %10s %12s\n",
+                "benchmark", "input", "time/op", "MB/s", "items/s", "allocs/op", "alloc B/op");
+
+    for (const auto& m : m_results) {
+        double seconds = m.nsPerOp / 1e9;
+
+        char throughput[32] = "-";
+        if (m.bytesPerOp > 0) {
+            std::snprintf(throughput, sizeof(throughput), "%.1f",
+                          static_cast<double>(m.bytesPerOp) / 1e6 / seconds);
+        }
+
+        std::string itemRate = formatRate(static_cast<double>(m.itemsPerOp) / seconds) + " " + m.itemLabel;
+
+        // Allocations are only counted in ARTIC_MEMORY_PROFILING builds
+        std::string allocations = MemoryStats::available() ? std::to_string(m.allocationsPerOp) : "-";
+        std::string allocatedBytes = MemoryStats::available() ? std::to_string(m.allocatedBytesPerOp) : "-";
+
+        std::printf("%-32s %-28s %12s %10s %22s %10s %12s\n",
+                    m.benchmark.c_str(), m.input.c_str(), formatTime(m.nsPerOp).c_str(), throughput, itemRate.c_str(),
+                    allocations.c_str(), allocatedBytes.c_str());
+    }
+}
+
+void BenchmarkRunner::printJson() const {
+    std::cout << "[\n";
+    for (size_t i = 0; i < m_results.size(); i++) {
+        const auto& m = m_results[i];
+        std::cout << "  {\"benchmark\": " << jsonString(m.benchmark)
+                  << ", \"input\": " << jsonString(m.input)
+                  << ", \"iterations\": " << m.iterations
+                  << ", \"ns_per_op\": " << m.nsPerOp
+                  << ", \"min_ns_per_op\": " << m.minNsPerOp
+                  << ", \"bytes_per_op\": " << m.bytesPerOp
+                  << ", \"items_per_op\": " << m.itemsPerOp
+                  << ", \"item\": " << jsonString(m.itemLabel)
+                  << ", \"allocs_per_op\": " << (MemoryStats::available() ? std::to_string(m.allocationsPerOp) : "null")
+                  << ", \"alloc_bytes_per_op\": "
+                  << (MemoryStats::available() ? std::to_string(m.allocatedBytesPerOp) : "null") << "}"
+                  << (i + 1 < m_results.size() ? ",\n" : "\n");
+    }
+    std::cout << "]\n";
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+size_t countTemplateNodes(const Component& component) {
+    size_t count = 0;
+    std::vector<const TemplateNode*> pending;
+    for (const auto& node : component.templateNodes) {
+        pending.push_back(node.get());
+    }
+
+    while (!pending.empty()) {
+        const TemplateNode* node = pending.back();
+        pending.pop_back();
+        count++;
+
+        if (node->type == ASTNodeType::ELEMENT) {
+            for (const auto& child : static_cast<const Element*>(node)->children) {
+                pending.push_back(child.get());
+            }
+        } else if (node->type == ASTNodeType::SLOT_NODE) {
+            for (const auto& child : static_cast<const SlotNode*>(node)->fallback) {
+                pending.push_back(child.get());
+            }
+        }
+    }
+    return count;
+}
+
+} // namespace artic::bench
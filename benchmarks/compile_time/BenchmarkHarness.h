@@ -0,0 +1,152 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "frontend/ast/Component.h"
+#include "shared/utils/MemoryStats.h"
+
+namespace artic::bench {
+
+/**
+ * @brief One .atc file to benchmark
+ */
+struct BenchmarkInput {
+    std::string name;              // Short label for reports
+    std::filesystem::path path;    // On disk (imports resolve relative to it)
+    std::string source;
+};
+
+/**
+ * @brief Result of one benchmark on one input
+ */
+struct Measurement {
+    std::string benchmark;
+    std::string input;
+    size_t iterations = 0;         // Calls timed across all samples
+    double nsPerOp = 0;            // Median of the samples
+    double minNsPerOp = 0;
+    size_t bytesPerOp = 0;         // Bytes processed per call (0 = not reported)
+    size_t itemsPerOp = 0;         // Tokens, nodes, declarations... per call
+    std::string itemLabel;
+    std::uint64_t allocationsPerOp = 0;
+    std::uint64_t allocatedBytesPerOp = 0;
+};
+
+/**
+ * @brief Minimal benchmark driver shared by the per-phase executables
+ *
+ * Each benchmark calls a function repeatedly in batches sized to run for
+ * a fraction of --min-time, takes SAMPLE_COUNT samples and reports the
+ * median time per call. Allocations are counted over one separate call
+ * after a warm-up call, so they reflect steady state.
+ *
+ * Usage: bench_<phase> [--min-time <ms>] [--json] [file.atc | dir ...]
+ *
+ * Without paths the examples/ projects and a generated page (see
+ * CorpusGenerator) are used.
+ */
+class BenchmarkRunner {
+public:
+    static constexpr int SAMPLE_COUNT = 10;
+
+    BenchmarkRunner(int argc, char** argv);
+    ~BenchmarkRunner();
+
+    /**
+     * @brief Inputs selected on the command line (or the defaults)
+     */
+    const std::vector<BenchmarkInput>& inputs() const { return m_inputs; }
+
+    /**
+     * @brief Time fn, which returns the number of items it processed
+     * @param benchmark Benchmark name (e.g. "Lexer::tokenize")
+     * @param input Input label
+     * @param bytes Bytes processed per call, for MB/s (0 = not reported)
+     * @param itemLabel What fn's return value counts ("tokens", "nodes")
+     */
+    template <typename Fn>
+    void run(const std::string& benchmark, const std::string& input, size_t bytes,
+             const std::string& itemLabel, Fn&& fn);
+
+    /**
+     * @brief Print the report
+     * @return Process exit code
+     */
+    int finish();
+
+private:
+    std::vector<BenchmarkInput> m_inputs;
+    std::vector<Measurement> m_results;
+    std::chrono::milliseconds m_minTime{500};
+    bool m_json = false;
+    std::filesystem::path m_tempDir;     // Generated inputs, removed on exit
+    volatile size_t m_sink = 0;          // Keeps results observable to the optimizer
+
+    void addInputs(const std::filesystem::path& path);
+    void addGeneratedInput();
+    void printTable() const;
+    void printJson() const;
+};
+
+/**
+ * @brief Template nodes in a component, including nested children and slot fallbacks
+ */
+size_t countTemplateNodes(const Component& component);
+
+template <typename Fn>
+void BenchmarkRunner::run(const std::string& benchmark, const std::string& input, size_t bytes,
+                          const std::string& itemLabel, Fn&& fn) {
+    using Clock = std::chrono::steady_clock;
+
+    // Warm-up call (fills caches), then one call with allocations counted
+    m_sink = m_sink + fn();
+    AllocationCounts before = MemoryStats::allocations();
+    size_t items = fn();
+    AllocationCounts after = MemoryStats::allocations();
+    m_sink = m_sink + items;
+
+    // Batch size: enough calls for one sample to take ~min-time / SAMPLE_COUNT
+    auto sampleTarget = std::chrono::duration_cast<Clock::duration>(m_minTime) / SAMPLE_COUNT;
+    size_t batch = 1;
+    while (true) {
+        auto start = Clock::now();
+        for (size_t i = 0; i < batch; i++) {
+            m_sink = m_sink + fn();
+        }
+        auto elapsed = Clock::now() - start;
+        if (elapsed >= sampleTarget || batch >= (size_t(1) << 30)) {
+            break;
+        }
+        batch *= 2;
+    }
+
+    std::vector<double> samples;
+    for (int s = 0; s < SAMPLE_COUNT; s++) {
+        auto start = Clock::now();
+        for (size_t i = 0; i < batch; i++) {
+            m_sink = m_sink + fn();
+        }
+        std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+        samples.push_back(elapsed.count() / static_cast<double>(batch));
+    }
+    std::sort(samples.begin(), samples.end());
+
+    Measurement m;
+    m.benchmark = benchmark;
+    m.input = input;
+    m.iterations = batch * SAMPLE_COUNT;
+    m.nsPerOp = samples[SAMPLE_COUNT / 2];
+    m.minNsPerOp = samples.front();
+    m.bytesPerOp = bytes;
+    m.itemsPerOp = items;
+    m.itemLabel = itemLabel;
+    m.allocationsPerOp = after.count - before.count;
+    m.allocatedBytesPerOp = after.bytes - before.bytes;
+    m_results.push_back(std::move(m));
+}
+
+} // namespace artic::bench
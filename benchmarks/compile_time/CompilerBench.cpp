@@ -0,0 +1,26 @@
+#include "BenchmarkHarness.h"
+#include "compiler/Compiler.h"
+
+using namespace artic;
+
+int main(int argc, char** argv) {
+    bench::BenchmarkRunner runner(argc, argv);
+
+    for (const auto& input : runner.inputs()) {
+        CompilerOptions options;
+        options.inputFile = input.path.string();
+        options.silent = true;
+
+        if (!Compiler(options).compileToString().success) {
+            continue;
+        }
+
+        // End to end from disk: read, lex, parse (with imports), CSS, HTML
+        runner.run("Compiler::compileToString", input.name, input.source.size(), "pages", [&] {
+            Compiler compiler(options);
+            return compiler.compileToString().success ? size_t(1) : size_t(0);
+        });
+    }
+
+    return runner.finish();
+}
@@ -0,0 +1,36 @@
+#include "BenchmarkHarness.h"
+#include "backend/css/CssGenerator.h"
+#include "backend/css/UtilityCache.h"
+#include "compiler/ComponentRegistry.h"
+
+using namespace artic;
+
+int main(int argc, char** argv) {
+    bench::BenchmarkRunner runner(argc, argv);
+
+    for (const auto& input : runner.inputs()) {
+        ComponentRegistry registry;
+        Component* component = registry.loadComponent(input.path.string());
+        if (!component || component->utilities.empty()) {
+            continue;
+        }
+
+        // Throughput in generated CSS bytes
+        size_t cssBytes = CssGenerator().generate(component).size();
+
+        // Steady state: the process-wide utility cache is warm
+        runner.run("CssGenerator::generate", input.name, cssBytes, "utilities", [&] {
+            CssGenerator generator;
+            return generator.generate(component).size() > 0 ? component->utilities.size() : 0;
+        });
+
+        // Every utility token resolved again
+        runner.run("CssGenerator::generate (cold)", input.name, cssBytes, "utilities", [&] {
+            UtilityCache::shared().clear();
+            CssGenerator generator;
+            return generator.generate(component).size() > 0 ? component->utilities.size() : 0;
+        });
+    }
+
+    return runner.finish();
+}
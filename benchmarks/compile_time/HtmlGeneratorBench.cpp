@@ -0,0 +1,44 @@
+#include "BenchmarkHarness.h"
+#include "backend/html/HtmlGenerator.h"
+#include "compiler/ComponentRegistry.h"
+
+using namespace artic;
+
+int main(int argc, char** argv) {
+    bench::BenchmarkRunner runner(argc, argv);
+
+    for (const auto& input : runner.inputs()) {
+        ComponentRegistry registry;
+        Component* component = registry.loadComponent(input.path.string());
+        if (!component) {
+            continue;
+        }
+
+        size_t nodes = bench::countTemplateNodes(*component);
+
+        // Throughput in generated HTML bytes
+        size_t htmlBytes = HtmlGenerator(HtmlGeneratorOptions(), &registry).generate(component).size();
+
+        // Fresh generator: template compilation + rendering
+        runner.run("HtmlGenerator::generate", input.name, htmlBytes, "nodes", [&] {
+            HtmlGenerator generator(HtmlGeneratorOptions(), &registry);
+            return generator.generate(component).size() > 0 ? nodes : 0;
+        });
+
+        // Reused generator: compiled programs and fragments are cached
+        HtmlGenerator warm(HtmlGeneratorOptions(), &registry);
+        runner.run("HtmlGenerator::generate (warm)", input.name, htmlBytes, "nodes", [&] {
+            return warm.generate(component).size() > 0 ? nodes : 0;
+        });
+
+        HtmlGeneratorOptions minified;
+        minified.minify = true;
+        size_t minifiedBytes = HtmlGenerator(minified, &registry).generate(component).size();
+        runner.run("HtmlGenerator::generate (minify)", input.name, minifiedBytes, "nodes", [&] {
+            HtmlGenerator generator(minified, &registry);
+            return generator.generate(component).size() > 0 ? nodes : 0;
+        });
+    }
+
+    return runner.finish();
+}
@@ -0,0 +1,17 @@
+#include "BenchmarkHarness.h"
+#include "frontend/lexer/Lexer.h"
+
+using namespace artic;
+
+int main(int argc, char** argv) {
+    bench::BenchmarkRunner runner(argc, argv);
+
+    for (const auto& input : runner.inputs()) {
+        runner.run("Lexer::tokenize", input.name, input.source.size(), "tokens", [&] {
+            Lexer lexer(input.source);
+            return lexer.tokenize().size();
+        });
+    }
+
+    return runner.finish();
+}
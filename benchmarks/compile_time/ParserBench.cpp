@@ -0,0 +1,23 @@
+#include "BenchmarkHarness.h"
+#include "frontend/lexer/Lexer.h"
+#include "frontend/parser/Parser.h"
+
+using namespace artic;
+
+int main(int argc, char** argv) {
+    bench::BenchmarkRunner runner(argc, argv);
+
+    for (const auto& input : runner.inputs()) {
+        Lexer lexer(input.source);
+        auto tokens = lexer.tokenize();
+
+        // Throughput in source bytes, so it lines up with the lexer numbers
+        runner.run("Parser::parse", input.name, input.source.size(), "nodes", [&] {
+            Parser parser(tokens);
+            auto component = parser.parse();
+            return bench::countTemplateNodes(*component) + component->utilities.size();
+        });
+    }
+
+    return runner.finish();
+}
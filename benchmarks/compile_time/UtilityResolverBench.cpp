@@ -0,0 +1,42 @@
+#include "BenchmarkHarness.h"
+#include "backend/css/UtilityResolver.h"
+#include "compiler/ComponentRegistry.h"
+
+using namespace artic;
+
+int main(int argc, char** argv) {
+    bench::BenchmarkRunner runner(argc, argv);
+
+    for (const auto& input : runner.inputs()) {
+        ComponentRegistry registry;
+        if (!registry.loadComponent(input.path.string())) {
+            continue;
+        }
+
+        // Every utility token of the page and its imports
+        std::vector<const UtilityToken*> utilityTokens;
+        size_t bytes = 0;
+        for (const auto& [name, component] : registry.getAllComponents()) {
+            for (const auto& utility : component->utilities) {
+                for (const auto& token : utility->tokens) {
+                    utilityTokens.push_back(token.get());
+                    bytes += token->property.size() + token->value.size();
+                }
+            }
+        }
+        if (utilityTokens.empty()) {
+            continue;
+        }
+
+        const UtilityResolver& resolver = UtilityResolver::instance();
+        runner.run("UtilityResolver::resolve", input.name, bytes, "tokens", [&] {
+            size_t declarations = 0;
+            for (const UtilityToken* token : utilityTokens) {
+                declarations += resolver.resolve(token->property, token->value).size();
+            }
+            return declarations > 0 ? utilityTokens.size() : 0;
+        });
+    }
+
+    return runner.finish();
+}
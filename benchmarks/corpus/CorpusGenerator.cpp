@@ -0,0 +1,275 @@
+#include "CorpusGenerator.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+namespace artic::bench {
+
+namespace {
+
+// xorshift32: tiny, fast and identical on every platform (unlike std:: distributions)
+std::uint32_t nextRandom(std::uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+int randomBelow(std::uint32_t& state, int bound) {
+    return bound <= 0 ? 0 : static_cast<int>(nextRandom(state) % static_cast<std::uint32_t>(bound));
+}
+
+const char* const COLORS[] = {"blue", "gray", "green", "red", "indigo", "amber", "teal", "pink"};
+const char* const TEXT_SIZES[] = {"sm", "base", "lg", "xl", "2xl"};
+const char* const TAGS[] = {"div", "section", "article", "aside", "nav"};
+
+const char* const WORDS[] = {
+    "lorem", "ipsum", "dolor", "sit", "amet", "consectetur", "adipiscing", "elit",
+    "sed", "do", "eiusmod", "tempor", "incididunt", "ut", "labore", "et", "dolore",
+    "magna", "aliqua", "enim", "ad", "minim", "veniam", "quis", "nostrud"
+};
+
+std::string padded(int value) {
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "%04d", value);
+    return buffer;
+}
+
+std::string indent(int level) {
+    return std::string(static_cast<size_t>(level) * 4, ' ');
+}
+
+std::string sentence(std::uint32_t& rng, int words) {
+    std::string result;
+    for (int i = 0; i < words; i++) {
+        if (i > 0) {
+            result += ' ';
+        }
+        result += WORDS[randomBelow(rng, static_cast<int>(std::size(WORDS)))];
+    }
+    return result;
+}
+
+} // namespace
+
+CorpusGenerator::CorpusGenerator(const CorpusOptions& options)
+    : m_options(options) {
+    m_options.components = std::max(m_options.components, 0);
+    m_options.pages = std::max(m_options.pages, 0);
+    m_options.hubs = std::clamp(m_options.hubs, 0, m_options.components);
+    m_options.depth = std::max(m_options.depth, 1);
+    m_options.levels = std::clamp(m_options.levels, 1, std::max(m_options.components, 1));
+    if (m_options.seed == 0) {
+        m_options.seed = 1;  // xorshift state must be non-zero
+    }
+}
+
+std::string CorpusGenerator::componentName(int index) {
+    return "Widget" + padded(index);
+}
+
+std::string CorpusGenerator::pageName(int index) {
+    return "Page" + padded(index);
+}
+
+std::vector<CorpusFile> CorpusGenerator::generate() const {
+    std::vector<CorpusFile> files;
+    std::uint32_t rng = m_options.seed;
+
+    for (int i = 0; i < m_options.components; i++) {
+        files.push_back({"components/" + componentName(i) + ".atc", generateComponent(i, rng)});
+    }
+    for (int i = 0; i < m_options.pages; i++) {
+        files.push_back({"pages/" + pageName(i) + ".atc", generatePage(i, rng)});
+    }
+
+    return files;
+}
+
+bool CorpusGenerator::write(const std::vector<CorpusFile>& files, const std::filesystem::path& root,
+                            std::string& error) {
+    for (const auto& file : files) {
+        std::filesystem::path path = root / file.path;
+
+        std::error_code ec;
+        std::filesystem::create_directories(path.parent_path(), ec);
+        if (ec) {
+            error = "Cannot create " + path.parent_path().string() + ": " + ec.message();
+            return false;
+        }
+
+        std::ofstream out(path, std::ios::binary);
+        out << file.source;
+        if (!out) {
+            error = "Cannot write " + path.string();
+            return false;
+        }
+    }
+    return true;
+}
+
+std::pair<int, int> CorpusGenerator::layerRange(int layer) const {
+    int n = m_options.components;
+    int levels = m_options.levels;
+    if (layer >= levels) {
+        return {n, n};  // Below the last layer: nothing
+    }
+    return {(layer * n + levels - 1) / levels, ((layer + 1) * n + levels - 1) / levels};
+}
+
+std::vector<int> CorpusGenerator::pickComponents(int first, int end, int count, std::uint32_t& rng) const {
+    std::vector<int> picked;
+    count = std::min(count, std::max(end - first, 0));
+
+    while (static_cast<int>(picked.size()) < count) {
+        int candidate = first + randomBelow(rng, end - first);
+        if (std::find(picked.begin(), picked.end(), candidate) == picked.end()) {
+            picked.push_back(candidate);
+        }
+    }
+
+    std::sort(picked.begin(), picked.end());
+    return picked;
+}
+
+void CorpusGenerator::appendUtilities(std::string& out, const std::string& prefix, std::uint32_t& rng) const {
+    for (int u = 0; u < m_options.utilities; u++) {
+        const char* color = COLORS[randomBelow(rng, static_cast<int>(std::size(COLORS)))];
+        out += "@utility\n" + prefix + "_" + std::to_string(u) + " {\n";
+        out += "    px:" + std::to_string(randomBelow(rng, 12) + 1) + "\n";
+        out += "    py:" + std::to_string(randomBelow(rng, 8) + 1) + "\n";
+        out += "    bg:" + std::string(color) + "-" + std::to_string((randomBelow(rng, 9) + 1) * 100) + "\n";
+        out += "    text:" + std::string(TEXT_SIZES[randomBelow(rng, static_cast<int>(std::size(TEXT_SIZES)))]) + "\n";
+        out += "    rounded:md\n";
+        out += "}\n\n";
+    }
+}
+
+void CorpusGenerator::appendSection(std::string& out, int section, bool text, std::uint32_t& rng) const {
+    std::string n = std::to_string(section);
+    out += indent(1) + "<section id=\"section-" + n + "\">\n";
+    out += indent(2) + "<h2>Section " + n + "</h2>\n";
+
+    if (text) {
+        for (int p = 0; p < 3; p++) {
+            out += indent(2) + "<p>" + sentence(rng, 40) + "</p>\n";
+        }
+    } else {
+        out += indent(2) + "<ul>\n";
+        for (int item = 0; item < 8; item++) {
+            std::string href = "/" + n + "/" + std::to_string(item);
+            out += indent(3) + "<li><a href=\"" + href + "\"><span>" + sentence(rng, 2) + "</span></a></li>\n";
+        }
+        out += indent(2) + "</ul>\n";
+    }
+
+    out += indent(1) + "</section>\n";
+}
+
+std::string CorpusGenerator::generateComponent(int index, std::uint32_t& rng) const {
+    std::string name = componentName(index);
+    std::string prefix = "w" + padded(index);
+    // Uses components of the next layer only (the last layer uses none)
+    int layer = index * m_options.levels / std::max(m_options.components, 1);
+    auto [first, end] = layerRange(layer + 1);
+    std::vector<int> children = pickComponents(first, end, m_options.fanOut, rng);
+
+    std::string out = "// Generated component " + std::to_string(index) + "\n\n";
+
+    if (!children.empty()) {
+        out += "use { ";
+        for (size_t i = 0; i < children.size(); i++) {
+            out += (i > 0 ? ", " : "") + componentName(children[i]);
+        }
+        out += " } from \".\"\n\n";
+    }
+
+    out += "props {\n";
+    out += "    title: string = \"" + name + "\",\n";
+    out += "    count: number = " + std::to_string(index) + "\n";
+    out += "}\n\n";
+
+    appendUtilities(out, prefix, rng);
+
+    // Nested wrappers down to the configured depth
+    std::string rootClasses;
+    for (int u = 0; u < std::min(m_options.utilities, 2); u++) {
+        rootClasses += (u > 0 ? " " : "") + prefix + "_" + std::to_string(u);
+    }
+    out += "<div" + (rootClasses.empty() ? std::string() : " class:(" + rootClasses + ")") + ">\n";
+    out += indent(1) + "<h3>{title}</h3>\n";
+
+    for (int level = 1; level < m_options.depth; level++) {
+        const char* tag = TAGS[level % static_cast<int>(std::size(TAGS))];
+        out += indent(level) + "<" + tag + " id=\"" + prefix + "-" + std::to_string(level) + "\">\n";
+    }
+
+    int inner = m_options.depth;
+    out += indent(inner) + "<p>" + sentence(rng, 12) + " {count + 1}</p>\n";
+    for (int child : children) {
+        out += indent(inner) + "<" + componentName(child) + " title=\"" + sentence(rng, 2) + "\" />\n";
+    }
+    out += indent(inner) + "<slot />\n";
+
+    for (int level = m_options.depth - 1; level >= 1; level--) {
+        const char* tag = TAGS[level % static_cast<int>(std::size(TAGS))];
+        out += indent(level) + "</" + tag + ">\n";
+    }
+    out += "</div>\n";
+
+    return out;
+}
+
+std::string CorpusGenerator::generatePage(int index, std::uint32_t& rng) const {
+    std::string prefix = "p" + padded(index);
+
+    // Hubs on every page, plus a random selection of the rest
+    std::vector<int> used;
+    for (int h = 0; h < m_options.hubs; h++) {
+        used.push_back(h);
+    }
+    for (int pick : pickComponents(m_options.hubs, m_options.components, m_options.fanOut, rng)) {
+        used.push_back(pick);
+    }
+
+    std::string out = "// Generated page " + std::to_string(index) + "\n\n";
+    out += "@route(\"/" + std::to_string(index) + "\")\n\n";
+
+    if (!used.empty()) {
+        out += "use { ";
+        for (size_t i = 0; i < used.size(); i++) {
+            out += (i > 0 ? ", " : "") + componentName(used[i]);
+        }
+        out += " } from \"../components\"\n\n";
+    }
+
+    appendUtilities(out, prefix, rng);
+
+    out += "<main>\n";
+    out += indent(1) + "<h1>" + pageName(index) + "</h1>\n";
+
+    for (int s = 0; s < m_options.sections; s++) {
+        bool text = m_options.content == ContentStyle::Text ||
+                    (m_options.content == ContentStyle::Mixed && s % 2 == 0);
+        appendSection(out, s, text, rng);
+
+        // Spread component instances over the sections
+        if (!used.empty() && s < m_options.repeat * static_cast<int>(used.size())) {
+            int component = used[static_cast<size_t>(s) % used.size()];
+            out += indent(1) + "<" + componentName(component) + " title=\"" + sentence(rng, 3) + "\">\n";
+            out += indent(2) + "<p>" + sentence(rng, 8) + "</p>\n";
+            out += indent(1) + "</" + componentName(component) + ">\n";
+        }
+    }
+
+    // Remaining instances when there are fewer sections than uses
+    for (int i = m_options.sections; i < m_options.repeat * static_cast<int>(used.size()); i++) {
+        int component = used[static_cast<size_t>(i) % used.size()];
+        out += indent(1) + "<" + componentName(component) + " count=\"" + std::to_string(i) + "\" />\n";
+    }
+
+    out += "</main>\n";
+    return out;
+}
+
+} // namespace artic::bench
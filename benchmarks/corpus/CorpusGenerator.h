@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace artic::bench {
+
+/**
+ * @brief What page sections are mostly made of
+ */
+enum class ContentStyle : std::uint8_t {
+    Text,    // Long paragraphs, little markup (lexer/text path heavy)
+    Markup,  // Lists, links and nested elements with short text
+    Mixed    // Alternates between the two
+};
+
+/**
+ * @brief Shape of a generated project
+ */
+struct CorpusOptions {
+    int components = 50;       // Reusable components in components/
+    int pages = 10;            // Pages in pages/, each with @route
+    int fanOut = 3;            // Other components each file uses
+    int levels = 3;            // Component layers (bounds nested expansion)
+    int hubs = 2;              // Components every page uses (high fan-in)
+    int depth = 4;             // Element nesting inside each component
+    int utilities = 5;         // @utility blocks per file
+    int sections = 10;         // Content sections per page
+    int repeat = 3;            // Instances of each used component per page
+    ContentStyle content = ContentStyle::Mixed;
+    std::uint32_t seed = 1;    // Same seed and options give the same corpus
+};
+
+/**
+ * @brief One generated source file
+ */
+struct CorpusFile {
+    std::string path;    // Relative to the corpus root ("pages/Page0001.atc")
+    std::string source;
+};
+
+/**
+ * @brief Generates parameterized .atc projects for scaling tests
+ *
+ * Components are split into layers; a component uses fanOut components of
+ * the next layer, so there are no import cycles and one use expands to at
+ * most fanOut^(levels-1) nested components. The hubs (the first components)
+ * are used by every page. Each component declares props with defaults,
+ * utilities, a nested template, an expression and a slot:
+ *
+ *   components/Widget0000.atc ... Widget<N-1>.atc
+ *   pages/Page0000.atc ...        Page<P-1>.atc   (use { ... } from "../components")
+ *
+ * Output is deterministic for a given seed and options.
+ */
+class CorpusGenerator {
+public:
+    explicit CorpusGenerator(const CorpusOptions& options);
+
+    /**
+     * @brief Generate every file of the corpus
+     */
+    std::vector<CorpusFile> generate() const;
+
+    /**
+     * @brief Write files below root (directories are created)
+     * @return false on I/O error (message in error)
+     */
+    static bool write(const std::vector<CorpusFile>& files, const std::filesystem::path& root,
+                      std::string& error);
+
+    static std::string componentName(int index);
+    static std::string pageName(int index);
+
+private:
+    CorpusOptions m_options;
+
+    std::string generateComponent(int index, std::uint32_t& rng) const;
+    std::string generatePage(int index, std::uint32_t& rng) const;
+    void appendUtilities(std::string& out, const std::string& prefix, std::uint32_t& rng) const;
+    void appendSection(std::string& out, int section, bool text, std::uint32_t& rng) const;
+    std::pair<int, int> layerRange(int layer) const;
+    std::vector<int> pickComponents(int first, int end, int count, std::uint32_t& rng) const;
+};
+
+} // namespace artic::bench
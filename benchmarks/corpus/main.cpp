@@ -0,0 +1,97 @@
+#include "CorpusGenerator.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace artic::bench;
+
+namespace {
+
+void printUsage() {
+    std::cout << "Usage: artic_corpus <output-dir> [options]\n\n"
+              << "Generate a synthetic Artic project for scaling tests.\n\n"
+              << "Options:\n"
+              << "  --components <n>   Reusable components (default: 50)\n"
+              << "  --pages <n>        Pages with @route (default: 10)\n"
+              << "  --fan-out <n>      Components used by each file (default: 3)\n"
+              << "  --levels <n>       Component layers; bounds nesting (default: 3)\n"
+              << "  --hubs <n>         Components used by every page (default: 2)\n"
+              << "  --depth <n>        Element nesting per component (default: 4)\n"
+              << "  --utilities <n>    @utility blocks per file (default: 5)\n"
+              << "  --sections <n>     Content sections per page (default: 10)\n"
+              << "  --repeat <n>       Instances of each used component per page (default: 3)\n"
+              << "  --content <style>  text, markup or mixed (default: mixed)\n"
+              << "  --seed <n>         Random seed (default: 1)\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2 || std::string(argv[1]) == "--help" || std::string(argv[1]) == "-h") {
+        printUsage();
+        return argc < 2 ? 1 : 0;
+    }
+
+    std::string outputDir = argv[1];
+    CorpusOptions options;
+
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Error: " << arg << " requires a value\n";
+            return 1;
+        }
+        std::string value = argv[++i];
+
+        if (arg == "--components") {
+            options.components = std::atoi(value.c_str());
+        } else if (arg == "--pages") {
+            options.pages = std::atoi(value.c_str());
+        } else if (arg == "--fan-out") {
+            options.fanOut = std::atoi(value.c_str());
+        } else if (arg == "--levels") {
+            options.levels = std::atoi(value.c_str());
+        } else if (arg == "--hubs") {
+            options.hubs = std::atoi(value.c_str());
+        } else if (arg == "--depth") {
+            options.depth = std::atoi(value.c_str());
+        } else if (arg == "--utilities") {
+            options.utilities = std::atoi(value.c_str());
+        } else if (arg == "--sections") {
+            options.sections = std::atoi(value.c_str());
+        } else if (arg == "--repeat") {
+            options.repeat = std::atoi(value.c_str());
+        } else if (arg == "--seed") {
+            options.seed = static_cast<std::uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        } else if (arg == "--content") {
+            if (value == "text") {
+                options.content = ContentStyle::Text;
+            } else if (value == "markup") {
+                options.content = ContentStyle::Markup;
+            } else if (value == "mixed") {
+                options.content = ContentStyle::Mixed;
+            } else {
+                std::cerr << "Error: unknown content style: " << value << "\n";
+                return 1;
+            }
+        } else {
+            std::cerr << "Error: unknown option: " << arg << "\n";
+            return 1;
+        }
+    }
+
+    auto files = CorpusGenerator(options).generate();
+
+    std::string error;
+    if (!CorpusGenerator::write(files, outputDir, error)) {
+        std::cerr << "Error: " << error << "\n";
+        return 1;
+    }
+
+    size_t bytes = 0;
+    for (const auto& file : files) {
+        bytes += file.source.size();
+    }
+    std::cout << "Generated " << files.size() << " files (" << bytes << " bytes) in " << outputDir << "\n";
+    return 0;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+
+namespace artic {
+
+/**
+ * @brief Output formatting mode shared by the CSS and HTML generators
+ */
+enum class FormatMode : std::uint8_t {
+    Pretty,    // Newlines and indentation
+    Compact,   // No insignificant whitespace added, content kept as written
+    Minified   // Compact, plus content-level minification
+};
+
+/**
+ * @brief Compile-time formatting policies
+ *
+ * Emitters are templated on one of these, so every `if constexpr` on a
+ * policy flag folds away and each mode gets its own straight-line code:
+ *
+ *   generateElement<PrettyFormat>    → indents, newlines
+ *   generateElement<MinifiedFormat>  → neither, and no checks for them
+ *
+ * The runtime options pick the instantiation once per generate() call
+ * via dispatchFormat().
+ */
+struct PrettyFormat {
+    static constexpr FormatMode mode = FormatMode::Pretty;
+    static constexpr bool pretty = true;
+    static constexpr bool minify = false;
+};
+
+struct CompactFormat {
+    static constexpr FormatMode mode = FormatMode::Compact;
+    static constexpr bool pretty = false;
+    static constexpr bool minify = false;
+};
+
+struct MinifiedFormat {
+    static constexpr FormatMode mode = FormatMode::Minified;
+    static constexpr bool pretty = false;
+    static constexpr bool minify = true;
+};
+
+/**
+ * @brief Select the formatting mode from runtime flags (minify wins over pretty)
+ */
+constexpr FormatMode selectFormatMode(bool pretty, bool minify) {
+    if (minify) {
+        return FormatMode::Minified;
+    }
+    return pretty ? FormatMode::Pretty : FormatMode::Compact;
+}
+
+/**
+ * @brief Invoke fn with the policy type matching a runtime mode
+ * @param fn Callable taking a policy tag (PrettyFormat, CompactFormat or MinifiedFormat)
+ */
+template <typename Fn>
+decltype(auto) dispatchFormat(FormatMode mode, Fn&& fn) {
+    switch (mode) {
+        case FormatMode::Pretty:
+            return fn(PrettyFormat{});
+        case FormatMode::Compact:
+            return fn(CompactFormat{});
+        case FormatMode::Minified:
+        default:
+            return fn(MinifiedFormat{});
+    }
+}
+
+} // namespace artic
@@ -0,0 +1,174 @@
+#include "backend/css/ClassNameMangler.h"
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+
+namespace artic {
+
+namespace {
+
+constexpr char ALPHABET[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+constexpr size_t BASE = sizeof(ALPHABET) - 1;
+
+// Split a class list on whitespace
+std::vector<std::string> splitClasses(const std::string& classList) {
+    std::vector<std::string> classes;
+    std::istringstream stream(classList);
+    std::string className;
+    while (stream >> className) {
+        classes.push_back(className);
+    }
+    return classes;
+}
+
+// Quote a string as a JSON string literal
+std::string jsonString(const std::string& value) {
+    std::string quoted = "\"";
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            quoted += '\\';
+            quoted += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escape[7];
+            std::snprintf(escape, sizeof(escape), "\\u%04x", static_cast<unsigned char>(c));
+            quoted += escape;
+        } else {
+            quoted += c;
+        }
+    }
+    return quoted + "\"";
+}
+
+} // namespace
+
+void ClassNameMangler::addUtilities(const Component* component) {
+    if (!component) {
+        return;
+    }
+
+    for (const auto& utility : component->utilities) {
+        m_usage.try_emplace(utility->name, 0);
+        m_foreignClasses.erase(utility->name);
+    }
+}
+
+void ClassNameMangler::countUsage(const Component* component) {
+    if (!component) {
+        return;
+    }
+
+    countNodes(component->templateNodes);
+}
+
+void ClassNameMangler::countNodes(const std::vector<std::unique_ptr<TemplateNode>>& nodes) {
+    for (const auto& node : nodes) {
+        if (node->type == ASTNodeType::ELEMENT) {
+            auto* element = static_cast<Element*>(node.get());
+
+            for (const auto& directive : element->classDirectives) {
+                countClasses(directive->tokens);
+            }
+
+            // Plain class="..." attributes are rewritten too; {expressions} are not
+            for (const auto& attr : element->attributes) {
+                if (attr->name == "class" && !attr->isDynamic) {
+                    countClasses(attr->value);
+                }
+            }
+
+            countNodes(element->children);
+        } else if (node->type == ASTNodeType::SLOT_NODE) {
+            countNodes(static_cast<SlotNode*>(node.get())->fallback);
+        }
+    }
+}
+
+void ClassNameMangler::countClasses(const std::string& classList) {
+    for (const auto& className : splitClasses(classList)) {
+        auto it = m_usage.find(className);
+        if (it != m_usage.end()) {
+            it->second++;
+        } else {
+            m_foreignClasses.insert(className);
+        }
+    }
+}
+
+void ClassNameMangler::assignNames() {
+    m_order.clear();
+    m_names.clear();
+
+    for (const auto& [className, count] : m_usage) {
+        m_order.push_back(className);
+    }
+
+    // Most used first; ties broken by name for stable output
+    std::sort(m_order.begin(), m_order.end(), [this](const std::string& a, const std::string& b) {
+        size_t countA = m_usage.at(a);
+        size_t countB = m_usage.at(b);
+        if (countA != countB) {
+            return countA > countB;
+        }
+        return a < b;
+    });
+
+    size_t index = 0;
+    for (const auto& className : m_order) {
+        std::string shortName;
+        do {
+            shortName = encode(index++);
+        } while (m_foreignClasses.count(shortName));
+
+        m_names[className] = shortName;
+    }
+}
+
+const std::string& ClassNameMangler::mangle(const std::string& className) const {
+    auto it = m_names.find(className);
+    if (it != m_names.end()) {
+        return it->second;
+    }
+    return className;
+}
+
+std::string ClassNameMangler::mangleClassList(const std::string& classList) const {
+    std::string result;
+
+    for (const auto& className : splitClasses(classList)) {
+        if (!result.empty()) {
+            result += " ";
+        }
+        result += mangle(className);
+    }
+
+    return result;
+}
+
+std::string ClassNameMangler::toJson() const {
+    std::ostringstream json;
+
+    json << "{\n";
+    for (size_t i = 0; i < m_order.size(); i++) {
+        const std::string& className = m_order[i];
+        json << "  " << jsonString(className) << ": " << jsonString(m_names.at(className));
+        json << (i + 1 < m_order.size() ? ",\n" : "\n");
+    }
+    json << "}\n";
+
+    return json.str();
+}
+
+std::string ClassNameMangler::encode(size_t index) {
+    // Bijective base-52: a..Z, aa..ZZ, aaa..
+    std::string name;
+    size_t n = index + 1;
+    while (n > 0) {
+        n--;
+        name += ALPHABET[n % BASE];
+        n /= BASE;
+    }
+    std::reverse(name.begin(), name.end());
+    return name;
+}
+
+} // namespace artic
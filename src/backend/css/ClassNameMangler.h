@@ -0,0 +1,85 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "frontend/ast/Component.h"
+
+namespace artic {
+
+/**
+ * @brief Assigns short identifiers to utility classes for production builds
+ *
+ * Only classes declared with @utility are renamed (other class names may
+ * belong to external stylesheets). The most frequently used class gets the
+ * shortest name, using bijective base-52 over [a-zA-Z]:
+ *
+ *   card_content (used 40x) → a
+ *   page_title   (used 12x) → b
+ *   ...                      → Z, aa, ab, ...
+ *
+ * Ties are broken by name, so the mapping is stable for a given input.
+ * The same mangler is shared by CssGenerator (selectors) and HtmlGenerator
+ * (class="..."), which keeps both outputs consistent.
+ */
+class ClassNameMangler {
+public:
+    /**
+     * @brief Register utility classes declared by a component
+     */
+    void addUtilities(const Component* component);
+
+    /**
+     * @brief Count class usages in a component's template
+     */
+    void countUsage(const Component* component);
+
+    /**
+     * @brief Assign short names (call after all add/count calls)
+     */
+    void assignNames();
+
+    /**
+     * @brief Get the short name for a class (or the class itself if not mangled)
+     */
+    const std::string& mangle(const std::string& className) const;
+
+    /**
+     * @brief Rewrite a space-separated class list ("card px:4" → "a px:4")
+     */
+    std::string mangleClassList(const std::string& classList) const;
+
+    /**
+     * @brief Number of mangled classes
+     */
+    size_t size() const { return m_order.size(); }
+
+    /**
+     * @brief Serialize the mapping as JSON ({"original": "short", ...})
+     */
+    std::string toJson() const;
+
+    /**
+     * @brief Encode an index as a bijective base-52 identifier (0 → a, 52 → aa)
+     */
+    static std::string encode(size_t index);
+
+private:
+    // Utility class name -> usage count
+    std::unordered_map<std::string, size_t> m_usage;
+
+    // Non-utility class names seen in templates (short names must avoid them)
+    std::unordered_set<std::string> m_foreignClasses;
+
+    // Utility class name -> short name
+    std::unordered_map<std::string, std::string> m_names;
+
+    // Utility class names in assignment order (for stable serialization)
+    std::vector<std::string> m_order;
+
+    void countNodes(const std::vector<std::unique_ptr<TemplateNode>>& nodes);
+    void countClasses(const std::string& classList);
+};
+
+} // namespace artic
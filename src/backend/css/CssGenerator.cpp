@@ -1,187 +1,382 @@
 #include "backend/css/CssGenerator.h"
-#include <sstream>
+#include "backend/css/CssMinifier.h"
+#include "backend/FormatPolicy.h"
 #include <unordered_map>
+#include <algorithm>
 
 namespace artic {
 
-CssGenerator::CssGenerator() : m_options{} {}
+CssGenerator::CssGenerator()
+    : m_options{}, m_cache(UtilityCache::shared()) {}
 
 CssGenerator::CssGenerator(const CssGeneratorOptions& options)
-    : m_options(options) {}
+    : m_options(options), m_cache(options.cache ? *options.cache : UtilityCache::shared()) {}
 
 std::string CssGenerator::generate(Component* component) {
     if (!component) {
         return "";
     }
 
-    std::ostringstream css;
-    bool first = true;
+    // Rough size hint: a rule header plus a few declarations per utility
+    StringSink out(component->utilities.size() * 128);
+    generate(component, out);
+    return out.take();
+}
 
-    // Generate CSS for each @utility declaration
-    for (const auto& utility : component->utilities) {
-        if (!first && m_options.pretty) {
-            css << "\n";
-        }
-        css << generateUtility(utility.get());
-        first = false;
+void CssGenerator::generate(Component* component, OutputSink& out) {
+    if (!component) {
+        return;
     }
 
-    return css.str();
+    dispatchFormat(formatMode(), [&](auto format) {
+        writeComponent<decltype(format)>(component, out);
+    });
 }
 
 std::string CssGenerator::generateUtility(UtilityDeclaration* utility) {
-    if (!utility || utility->tokens.empty()) {
-        return "";
-    }
-
-    std::string className = utility->name;
+    StringSink out;
+    generateUtility(utility, out);
+    return out.take();
+}
 
-    // Group tokens by prefix
-    // base: tokens without prefix
-    // hover: tokens with hover: prefix
-    // focus: tokens with focus: prefix, etc.
-    std::unordered_map<std::string, std::vector<std::string>> groupedDeclarations;
+void CssGenerator::generateUtility(UtilityDeclaration* utility, OutputSink& out) {
+    dispatchFormat(formatMode(), [&](auto format) {
+        writeUtility<decltype(format)>(utility, out);
+    });
+}
 
-    for (const auto& token : utility->tokens) {
-        // Resolve token to CSS declarations
-        auto declarations = m_resolver.resolve(token->property, token->value);
+FormatMode CssGenerator::formatMode() const {
+    return selectFormatMode(m_options.pretty, m_options.minify);
+}
 
-        if (declarations.empty()) {
-            continue;
+template <typename Format>
+void CssGenerator::writeComponent(Component* component, OutputSink& out) {
+    // Minified rules stay pending across utilities so that adjacent rules
+    // from different utilities can be merged
+    if constexpr (Format::minify) {
+        for (const auto& utility : component->utilities) {
+            writeMinifiedRules(utility.get(), out);
+        }
+        finishMinified(out);
+    } else {
+        bool first = true;
+
+        // Generate CSS for each @utility declaration
+        for (const auto& utility : component->utilities) {
+            if constexpr (Format::pretty) {
+                if (!first) {
+                    out << '\n';
+                }
+            }
+            writeUtility<Format>(utility.get(), out);
+            first = false;
         }
+    }
+}
 
-        // Group by prefix (empty string = base)
-        std::string prefix = token->prefix.empty() ? "" : token->prefix;
+template <typename Format>
+void CssGenerator::writeUtility(UtilityDeclaration* utility, OutputSink& out) {
+    if constexpr (Format::minify) {
+        writeMinifiedRules(utility, out);
+        finishMinified(out);
+    } else {
+        collectGroups(utility);
+        if (m_groupCount == 0) {
+            return;
+        }
 
-        for (const auto& decl : declarations) {
-            groupedDeclarations[prefix].push_back(decl);
+        const std::string& className = selectorName(utility);
+        bool first = true;
+
+        // 1. Base rule (no prefix), 2. rules with prefixes
+        for (int pass = 0; pass < 2; pass++) {
+            for (size_t i = 0; i < m_groupCount; i++) {
+                const DeclarationGroup& group = m_groups[i];
+                if (group.prefix->empty() != (pass == 0)) {
+                    continue;
+                }
+
+                if constexpr (Format::pretty) {
+                    if (!first) {
+                        out << '\n';
+                    }
+                }
+                writeRule<Format>(out, className, group);
+                first = false;
+            }
         }
     }
+}
 
-    // Generate CSS rules
-    std::ostringstream css;
+void CssGenerator::collectGroups(UtilityDeclaration* utility) {
+    // Keep the inner vectors' capacity for the next utility
+    for (size_t i = 0; i < m_groupCount; i++) {
+        m_groups[i].entries.clear();
+    }
+    m_groupCount = 0;
 
-    // 1. Base rule (no prefix)
-    if (groupedDeclarations.count("")) {
-        std::string selector = "." + className;
-        css << formatRule(selector, groupedDeclarations[""]);
+    if (!utility || utility->tokens.empty()) {
+        return;
     }
 
-    // 2. Rules with prefixes
-    for (const auto& [prefix, declarations] : groupedDeclarations) {
-        if (prefix.empty()) {
-            continue; // Skip base (already handled)
+    // Group tokens by prefix, keeping first-appearance order so output is stable
+    // base: tokens without prefix
+    // hover: tokens with hover: prefix
+    // focus: tokens with focus: prefix, etc.
+    for (const auto& token : utility->tokens) {
+        // Resolve token to CSS declarations (memoized)
+        auto entry = m_cache.resolve(token->property, token->value);
+
+        if (entry->block.empty()) {
+            continue;
         }
 
-        std::string selector = getPrefixSelector(className, prefix);
+        // Group by prefix (empty string = base)
+        size_t index = 0;
+        while (index < m_groupCount && *m_groups[index].prefix != token->prefix) {
+            index++;
+        }
 
-        if (m_options.pretty) {
-            css << "\n";
+        if (index == m_groupCount) {
+            if (m_groupCount == m_groups.size()) {
+                m_groups.emplace_back();
+            }
+            m_groups[m_groupCount++].prefix = &token->prefix;
         }
 
-        css << formatRule(selector, declarations);
+        m_groups[index].entries.push_back(std::move(entry));
     }
+}
 
-    return css.str();
+const std::string& CssGenerator::selectorName(UtilityDeclaration* utility) const {
+    return m_options.classMangler
+        ? m_options.classMangler->mangle(utility->name)
+        : utility->name;
 }
 
-std::string CssGenerator::getPrefixSelector(const std::string& className, const std::string& prefix) {
+const std::unordered_map<std::string, CssGenerator::PrefixSelector>& CssGenerator::prefixTable() {
     // Map prefix to CSS selector
-    static const std::unordered_map<std::string, std::string> prefixMap = {
+    static const std::unordered_map<std::string, PrefixSelector> prefixMap = {
         // Pseudo-classes
-        {"hover", ":hover"},
-        {"focus", ":focus"},
-        {"active", ":active"},
-        {"visited", ":visited"},
-        {"disabled", ":disabled"},
-        {"checked", ":checked"},
+        {"hover", {":hover", ""}},
+        {"focus", {":focus", ""}},
+        {"active", {":active", ""}},
+        {"visited", {":visited", ""}},
+        {"disabled", {":disabled", ""}},
+        {"checked", {":checked", ""}},
 
         // Pseudo-elements
-        {"before", "::before"},
-        {"after", "::after"},
-        {"placeholder", "::placeholder"},
+        {"before", {"::before", ""}},
+        {"after", {"::after", ""}},
+        {"placeholder", {"::placeholder", ""}},
 
         // Responsive breakpoints (mobile-first)
-        {"sm", "@media (min-width: 640px)"},   // Small devices
-        {"md", "@media (min-width: 768px)"},   // Medium devices
-        {"lg", "@media (min-width: 1024px)"},  // Large devices
-        {"xl", "@media (min-width: 1280px)"},  // Extra large devices
-        {"2xl", "@media (min-width: 1536px)"}, // 2X Extra large
+        {"sm", {"", "@media (min-width: 640px)"}},   // Small devices
+        {"md", {"", "@media (min-width: 768px)"}},   // Medium devices
+        {"lg", {"", "@media (min-width: 1024px)"}},  // Large devices
+        {"xl", {"", "@media (min-width: 1280px)"}},  // Extra large devices
+        {"2xl", {"", "@media (min-width: 1536px)"}}, // 2X Extra large
 
         // Dark mode
-        {"dark", "@media (prefers-color-scheme: dark)"},
+        {"dark", {"", "@media (prefers-color-scheme: dark)"}},
     };
 
+    return prefixMap;
+}
+
+CssGenerator::PrefixSelector CssGenerator::resolvePrefix(const std::string& prefix) {
+    const auto& prefixMap = prefixTable();
     auto it = prefixMap.find(prefix);
     if (it == prefixMap.end()) {
-        // Unknown prefix, return as-is
-        return "." + className + ":" + prefix;
+        return {"", "", false};
     }
-
-    std::string selector = it->second;
-
-    // Handle media queries differently
-    if (selector.find("@media") == 0) {
-        return selector + " { ." + className;
-    }
-
-    // Handle pseudo-classes/elements
-    return "." + className + selector;
+    return it->second;
 }
 
-std::string CssGenerator::formatRule(const std::string& selector, const std::vector<std::string>& declarations) {
-    if (declarations.empty()) {
-        return "";
+std::string_view CssGenerator::minifiedMediaQuery(std::string_view mediaQuery) {
+    if (mediaQuery.empty()) {
+        return {};
     }
 
-    std::ostringstream css;
+    // Every query comes from the prefix table, so minify each one once
+    static const std::unordered_map<std::string_view, std::string> minified = [] {
+        std::unordered_map<std::string_view, std::string> queries;
+        for (const auto& [prefix, selector] : prefixTable()) {
+            if (!selector.mediaQuery.empty()) {
+                queries.try_emplace(selector.mediaQuery,
+                                    CssMinifier::minifyMediaQuery(std::string(selector.mediaQuery)));
+            }
+        }
+        return queries;
+    }();
+
+    return minified.at(mediaQuery);
+}
 
-    // Check if selector is media query
-    bool isMediaQuery = selector.find("@media") == 0;
+template <typename Format>
+void CssGenerator::writeRule(OutputSink& out, const std::string& className, const DeclarationGroup& group) {
+    PrefixSelector selector = group.prefix->empty() ? PrefixSelector{} : resolvePrefix(*group.prefix);
 
-    if (isMediaQuery) {
+    if (!selector.mediaQuery.empty()) {
         // Media query format:
         // @media (min-width: 768px) {
         //   .btn { ... }
         // }
-        css << selector << " {\n";
-        css << formatDeclarations(declarations);
-        css << "  }\n";
-        css << "}";
-    } else {
-        // Regular rule:
-        // .btn { ... }
-        css << selector << " {\n";
-        css << formatDeclarations(declarations);
-        css << "}";
+        out << selector.mediaQuery;
+        out << (Format::pretty ? " {\n  ." : " {.") << className;
+        out << (Format::pretty ? " {\n" : " {");
+        writeDeclarations<Format>(out, group, 2);
+        out << (Format::pretty ? "  }\n}" : "}}");
+        return;
     }
 
-    return css.str();
+    // Regular rule:
+    // .btn { ... }
+    out << '.' << className << selector.suffix;
+    if (!selector.known) {
+        out << ':' << *group.prefix;
+    }
+    out << (Format::pretty ? " {\n" : " {");
+    writeDeclarations<Format>(out, group, 1);
+    out << '}';
 }
 
-std::string CssGenerator::formatDeclarations(const std::vector<std::string>& declarations) {
-    std::ostringstream css;
-
-    for (const auto& decl : declarations) {
-        if (m_options.minify) {
-            css << decl << ";";
-        } else if (m_options.pretty) {
-            css << "  " << decl << ";\n";
+template <typename Format>
+void CssGenerator::writeDeclarations(OutputSink& out, const DeclarationGroup& group, int depth) {
+    for (const auto& entry : group.entries) {
+        std::string_view block = entry->block;
+        if constexpr (Format::pretty) {
+            // Cached lines are already "property: value;\n"; only indent them
+            for (size_t start = 0; start < block.size();) {
+                size_t end = block.find('\n', start) + 1;
+                out.appendRepeated(' ', static_cast<size_t>(depth * 2));
+                out << block.substr(start, end - start);
+                start = end;
+            }
         } else {
-            css << decl << ";";
+            for (size_t start = 0; start < block.size();) {
+                size_t end = block.find('\n', start);
+                out << block.substr(start, end - start);
+                start = end + 1;
+            }
+        }
+    }
+}
+
+namespace {
+
+// Next character of the body an entry list renders to ("a:b;c:d"), or -1
+struct BodyCursor {
+    const std::vector<UtilityCache::EntryPtr>& entries;
+    size_t entry = 0;
+    size_t offset = 0;
+
+    int next() {
+        while (entry < entries.size()) {
+            const std::string& text = entries[entry]->minified;
+            if (offset < text.size()) {
+                return static_cast<unsigned char>(text[offset++]);
+            }
+            entry++;
+            offset = 0;
+            if (entry < entries.size()) {
+                return ';';
+            }
+        }
+        return -1;
+    }
+};
+
+// Whether two entry lists render to the same body, without joining them
+bool sameBody(const std::vector<UtilityCache::EntryPtr>& a, const std::vector<UtilityCache::EntryPtr>& b) {
+    if (a == b) {
+        return true;
+    }
+
+    BodyCursor left{a};
+    BodyCursor right{b};
+    int c;
+    do {
+        c = left.next();
+        if (c != right.next()) {
+            return false;
         }
+    } while (c != -1);
+    return true;
+}
+
+} // namespace
+
+void CssGenerator::writeMinifiedRules(UtilityDeclaration* utility, OutputSink& out) {
+    collectGroups(utility);
+    if (m_groupCount == 0) {
+        return;
     }
 
-    return css.str();
+    const std::string& className = selectorName(utility);
+
+    // 1. Base rule (no prefix), 2. rules with prefixes
+    for (int pass = 0; pass < 2; pass++) {
+        for (size_t i = 0; i < m_groupCount; i++) {
+            const DeclarationGroup& group = m_groups[i];
+            if (group.prefix->empty() != (pass == 0)) {
+                continue;
+            }
+
+            PrefixSelector selector = group.prefix->empty() ? PrefixSelector{} : resolvePrefix(*group.prefix);
+            std::string_view media = minifiedMediaQuery(selector.mediaQuery);
+
+            // Same context and body as the pending rule: .a{x}.b{x} → .a,.b{x}
+            if (!m_pendingBody.empty() && media == m_openMedia && sameBody(m_pendingBody, group.entries)) {
+                out << ',';
+            } else {
+                flushMinifiedRule(out);
+
+                if (media != m_openMedia) {
+                    if (!m_openMedia.empty()) {
+                        out << '}';
+                    }
+                    if (!media.empty()) {
+                        out << media << '{';
+                    }
+                    m_openMedia = media;
+                }
+
+                m_pendingBody.assign(group.entries.begin(), group.entries.end());
+            }
+
+            out << '.' << className << selector.suffix;
+            if (!selector.known) {
+                out << ':' << *group.prefix;
+            }
+        }
+    }
 }
 
-std::string CssGenerator::wrapWithPrefix(
-    const std::string& className,
-    const std::string& prefix,
-    const std::vector<std::string>& declarations
-) {
-    std::string selector = getPrefixSelector(className, prefix);
-    return formatRule(selector, declarations);
+void CssGenerator::flushMinifiedRule(OutputSink& out) {
+    if (m_pendingBody.empty()) {
+        return;
+    }
+
+    // No trailing semicolon: the closing brace terminates the last one
+    out << '{';
+    for (size_t i = 0; i < m_pendingBody.size(); i++) {
+        if (i > 0) {
+            out << ';';
+        }
+        out << m_pendingBody[i]->minified;
+    }
+    out << '}';
+
+    m_pendingBody.clear();
+}
+
+void CssGenerator::finishMinified(OutputSink& out) {
+    flushMinifiedRule(out);
+    if (!m_openMedia.empty()) {
+        out << '}';
+    }
+    m_openMedia = {};
 }
 
 } // namespace artic
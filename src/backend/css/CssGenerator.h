@@ -1,10 +1,15 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 #include "frontend/ast/Component.h"
-#include "backend/css/UtilityResolver.h"
+#include "backend/css/UtilityCache.h"
+#include "backend/css/ClassNameMangler.h"
+#include "shared/utils/OutputSink.h"
+#include "backend/FormatPolicy.h"
 
 namespace artic {
 
@@ -12,9 +17,11 @@ namespace artic {
  * @brief Options for CSS generation
  */
 struct CssGeneratorOptions {
-    bool minify = false;        // Minify output CSS
+    bool minify = false;        // Minify output CSS (see CssMinifier; overrides pretty)
     bool sourceMaps = false;    // Generate source maps (future)
     bool pretty = true;         // Pretty print (indentation)
+    UtilityCache* cache = nullptr; // Token cache (nullptr = UtilityCache::shared())
+    const ClassNameMangler* classMangler = nullptr; // Short class names (production)
 };
 
 /**
@@ -54,6 +61,13 @@ public:
      */
     std::string generate(Component* component);
 
+    /**
+     * @brief Generate CSS from Component AST into a sink
+     * @param component Component with @utility declarations
+     * @param out Destination for the generated CSS
+     */
+    void generate(Component* component, OutputSink& out);
+
     /**
      * @brief Generate CSS for a single utility declaration
      * @param utility Utility declaration
@@ -61,28 +75,77 @@ public:
      */
     std::string generateUtility(UtilityDeclaration* utility);
 
+    /**
+     * @brief Generate CSS for a single utility declaration into a sink
+     */
+    void generateUtility(UtilityDeclaration* utility, OutputSink& out);
+
 private:
+    /**
+     * @brief Selector parts contributed by a prefix (hover → ":hover", md → @media)
+     */
+    struct PrefixSelector {
+        std::string_view suffix;      // Appended to ".class" (":hover", "::before")
+        std::string_view mediaQuery;  // Wrapping @media query, if any
+        bool known = true;            // false: emitted as ".class:prefix"
+    };
+
+    /**
+     * @brief Declarations for one prefix, sharing the cached blocks (no copies)
+     */
+    struct DeclarationGroup {
+        const std::string* prefix = nullptr;
+        std::vector<UtilityCache::EntryPtr> entries;
+    };
+
     CssGeneratorOptions m_options;
-    UtilityResolver m_resolver;
+    UtilityCache& m_cache;  // Shared across generators
+
+    // Scratch groups reused across utilities (capacity is kept, so steady
+    // state generation does not allocate)
+    std::vector<DeclarationGroup> m_groups;
+    size_t m_groupCount = 0;
+
+    // Minified output: body of the rule whose selectors are being written
+    // (empty = none) and the open @media block. Kept across utilities so
+    // adjacent rules with identical bodies merge (.a,.b{...}).
+    std::vector<UtilityCache::EntryPtr> m_pendingBody;
+    std::string_view m_openMedia;
+
+    // Group a utility's resolved tokens by prefix into m_groups
+    void collectGroups(UtilityDeclaration* utility);
+
+    // Known prefixes (hover:, focus:, sm:, md:, lg:, xl:, dark:, ...)
+    static const std::unordered_map<std::string, PrefixSelector>& prefixTable();
+
+    // Look up the selector parts for a prefix
+    static PrefixSelector resolvePrefix(const std::string& prefix);
+
+    // Minified form of a prefix's @media query (computed once per query)
+    static std::string_view minifiedMediaQuery(std::string_view mediaQuery);
+
+    // Formatting mode selected by the options (picks the writer instantiation)
+    FormatMode formatMode() const;
+
+    // Writers, specialized per formatting policy (see FormatPolicy.h)
+    template <typename Format> void writeComponent(Component* component, OutputSink& out);
+    template <typename Format> void writeUtility(UtilityDeclaration* utility, OutputSink& out);
 
-    // Generate CSS for a single token
-    std::string generateToken(UtilityToken* token, const std::string& className);
+    // Write one rule for a declaration group
+    template <typename Format> void writeRule(OutputSink& out, const std::string& className, const DeclarationGroup& group);
 
-    // Handle prefixes (hover:, focus:, sm:, md:, lg:, xl:, dark:)
-    std::string wrapWithPrefix(
-        const std::string& className,
-        const std::string& prefix,
-        const std::vector<std::string>& declarations
-    );
+    // Write CSS declarations at the given nesting depth
+    template <typename Format> void writeDeclarations(OutputSink& out, const DeclarationGroup& group, int depth);
 
-    // Get CSS selector for a prefix
-    std::string getPrefixSelector(const std::string& className, const std::string& prefix);
+    // Minified writer: stream a utility's selectors, merging with the pending rule
+    void writeMinifiedRules(UtilityDeclaration* utility, OutputSink& out);
 
-    // Format CSS rule
-    std::string formatRule(const std::string& selector, const std::vector<std::string>& declarations);
+    // Close the pending minified rule / the pending rule and @media block
+    void flushMinifiedRule(OutputSink& out);
+    void finishMinified(OutputSink& out);
 
-    // Format CSS declarations
-    std::string formatDeclarations(const std::vector<std::string>& declarations);
+    // Class name as it appears in selectors (mangled in production builds)
+    const std::string& selectorName(UtilityDeclaration* utility) const;
 };
 
 } // namespace artic
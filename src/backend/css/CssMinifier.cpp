@@ -0,0 +1,344 @@
+#include "backend/css/CssMinifier.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+
+namespace artic {
+
+namespace {
+
+// Length units for which a zero value can drop its unit (0rem → 0)
+constexpr std::array<const char*, 14> ZERO_UNITS = {
+    "px", "rem", "em", "vh", "vw", "vmin", "vmax",
+    "ch", "ex", "pt", "pc", "cm", "mm", "in"
+};
+
+bool isValueDelimiter(char c) {
+    return c == ' ' || c == ',' || c == '(' || c == ')' || c == '/';
+}
+
+bool isQuote(char c) {
+    return c == '"' || c == '\'';
+}
+
+// Index just past the string literal opening at value[open] (or value.size())
+size_t skipString(const std::string& value, size_t open) {
+    char quote = value[open];
+    size_t i = open + 1;
+    while (i < value.size() && value[i] != quote) {
+        i += (value[i] == '\\') ? 2 : 1;
+    }
+    return std::min(i + 1, value.size());
+}
+
+// Math functions where a zero must keep its unit: calc(100% - 0) is invalid
+bool isMathFunction(const std::string& name) {
+    std::string lower;
+    lower.reserve(name.size());
+    for (char c : name) {
+        lower += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return lower == "calc" || lower == "min" || lower == "max" || lower == "clamp";
+}
+
+std::string trim(const std::string& str) {
+    size_t start = str.find_first_not_of(" \t\n\r");
+    if (start == std::string::npos) {
+        return "";
+    }
+    size_t end = str.find_last_not_of(" \t\n\r");
+    return str.substr(start, end - start + 1);
+}
+
+} // namespace
+
+std::string CssMinifier::minify(const std::vector<CssRule>& rules) const {
+    StringSink css;
+    minify(rules, css);
+    return css.take();
+}
+
+void CssMinifier::minify(const std::vector<CssRule>& rules, OutputSink& css) const {
+
+    std::string openMedia;   // Currently open @media block (empty = none)
+    std::string selectors;   // Pending (merged) selector list
+    std::string body;        // Pending rule body
+
+    auto flushRule = [&]() {
+        if (!selectors.empty()) {
+            css << selectors << "{" << body << "}";
+        }
+        selectors.clear();
+        body.clear();
+    };
+
+    for (const auto& rule : rules) {
+        if (rule.declarations.empty()) {
+            continue;
+        }
+
+        std::string media = rule.isMediaQuery() ? minifyMediaQuery(rule.mediaQuery) : "";
+        std::string ruleBody = formatBody(rule.declarations);
+
+        // Merge with the previous rule when both live in the same context
+        // and have identical bodies: .a{x}.b{x} → .a,.b{x}
+        if (!selectors.empty() && media == openMedia && ruleBody == body) {
+            selectors += "," + rule.selector;
+            continue;
+        }
+
+        flushRule();
+
+        if (media != openMedia) {
+            if (!openMedia.empty()) {
+                css << "}";
+            }
+            if (!media.empty()) {
+                css << media << "{";
+            }
+            openMedia = media;
+        }
+
+        selectors = rule.selector;
+        body = ruleBody;
+    }
+
+    flushRule();
+
+    if (!openMedia.empty()) {
+        css << "}";
+    }
+}
+
+std::string CssMinifier::minifyDeclaration(const std::string& declaration) {
+    size_t colon = declaration.find(':');
+    if (colon == std::string::npos) {
+        return trim(declaration);
+    }
+
+    std::string property = trim(declaration.substr(0, colon));
+    std::string value = trim(declaration.substr(colon + 1));
+
+    return property + ":" + minifyValue(value);
+}
+
+std::string CssMinifier::minifyValue(const std::string& value) {
+    // 1. Collapse whitespace, dropping it entirely next to , ( ) /
+    //    String literals are copied verbatim
+    std::string collapsed;
+    bool pendingSpace = false;
+
+    for (size_t i = 0; i < value.size(); i++) {
+        char c = value[i];
+        if (isQuote(c)) {
+            if (pendingSpace && !collapsed.empty() &&
+                collapsed.back() != ',' && collapsed.back() != '(' && collapsed.back() != '/') {
+                collapsed += ' ';
+            }
+            pendingSpace = false;
+            size_t end = skipString(value, i);
+            collapsed.append(value, i, end - i);
+            i = end - 1;
+            continue;
+        }
+
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            pendingSpace = !collapsed.empty();
+            continue;
+        }
+
+        bool delimiter = c == ',' || c == ')' || c == '/';
+        bool afterDelimiter = !collapsed.empty() &&
+            (collapsed.back() == ',' || collapsed.back() == '(' || collapsed.back() == '/');
+
+        if (pendingSpace && !delimiter && !afterDelimiter) {
+            collapsed += ' ';
+        }
+        pendingSpace = false;
+        collapsed += c;
+    }
+
+    // 2. Compress each component between delimiters. One entry per open
+    //    parenthesis records whether it sits inside a math function.
+    std::string result;
+    result.reserve(collapsed.size());
+    std::vector<bool> mathDepth;
+
+    size_t start = 0;
+    while (start <= collapsed.size()) {
+        size_t end = start;
+        while (end < collapsed.size() && !isValueDelimiter(collapsed[end])) {
+            end = isQuote(collapsed[end]) ? skipString(collapsed, end) : end + 1;
+        }
+
+        std::string component = collapsed.substr(start, end - start);
+        bool inMath = !mathDepth.empty() && mathDepth.back();
+        if (!component.empty()) {
+            if (component[0] == '#') {
+                result += shortenHexColor(component);
+            } else if (isQuote(component[0])) {
+                result += component;
+            } else {
+                result += compressNumber(component, inMath);
+            }
+        }
+
+        if (end < collapsed.size()) {
+            char delimiter = collapsed[end];
+            if (delimiter == '(') {
+                mathDepth.push_back(inMath || isMathFunction(component));
+            } else if (delimiter == ')' && !mathDepth.empty()) {
+                mathDepth.pop_back();
+            }
+            result += delimiter;
+        }
+        start = end + 1;
+    }
+
+    return result;
+}
+
+std::string CssMinifier::minifyMediaQuery(const std::string& mediaQuery) {
+    // "@media (min-width: 640px)" → "@media (min-width:640px)"
+    // The space after "@media" and around "and" is significant.
+    std::string result;
+    result.reserve(mediaQuery.size());
+
+    for (size_t i = 0; i < mediaQuery.size(); i++) {
+        char c = mediaQuery[i];
+        if (c == ' ' && !result.empty() &&
+            (result.back() == ':' || result.back() == '(' || result.back() == ' ')) {
+            continue;
+        }
+        if (c == ')' && !result.empty() && result.back() == ' ') {
+            result.pop_back();
+        }
+        result += c;
+    }
+
+    return trim(result);
+}
+
+std::string CssMinifier::shortenHexColor(const std::string& color) {
+    std::string hex = color.substr(1);
+
+    for (char c : hex) {
+        if (!std::isxdigit(static_cast<unsigned char>(c))) {
+            return color; // Not a hex color
+        }
+    }
+
+    std::string lower;
+    lower.reserve(hex.size());
+    for (char c : hex) {
+        lower += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+
+    // #rrggbb → #rgb and #rrggbbaa → #rgba when every pair repeats
+    if (lower.size() == 6 || lower.size() == 8) {
+        bool shortenable = true;
+        for (size_t i = 0; i < lower.size(); i += 2) {
+            if (lower[i] != lower[i + 1]) {
+                shortenable = false;
+                break;
+            }
+        }
+
+        if (shortenable) {
+            std::string shortHex;
+            for (size_t i = 0; i < lower.size(); i += 2) {
+                shortHex += lower[i];
+            }
+            return "#" + shortHex;
+        }
+    }
+
+    return "#" + lower;
+}
+
+std::string CssMinifier::compressNumber(const std::string& component, bool keepZeroUnit) {
+    // Split into sign, number and unit: "-0.50rem" → "-", "0.50", "rem"
+    size_t pos = 0;
+    std::string sign;
+    if (pos < component.size() && (component[pos] == '-' || component[pos] == '+')) {
+        sign = component.substr(0, 1);
+        pos++;
+    }
+
+    size_t numberStart = pos;
+    bool sawDigit = false;
+    bool sawDot = false;
+    while (pos < component.size()) {
+        char c = component[pos];
+        if (std::isdigit(static_cast<unsigned char>(c))) {
+            sawDigit = true;
+        } else if (c == '.' && !sawDot) {
+            sawDot = true;
+        } else {
+            break;
+        }
+        pos++;
+    }
+
+    if (!sawDigit) {
+        return component; // Keyword (auto, transparent, ...)
+    }
+
+    std::string number = component.substr(numberStart, pos - numberStart);
+    std::string unit = component.substr(pos);
+
+    // Unit must be purely alphabetic or % (skip things like "1fr)" or "2n+1")
+    for (char c : unit) {
+        if (!std::isalpha(static_cast<unsigned char>(c)) && c != '%') {
+            return component;
+        }
+    }
+
+    // Drop trailing zeros in the fraction: 1.50 → 1.5, 2.0 → 2
+    if (sawDot) {
+        while (!number.empty() && number.back() == '0') {
+            number.pop_back();
+        }
+        if (!number.empty() && number.back() == '.') {
+            number.pop_back();
+        }
+    }
+
+    // Drop leading zeros: 0.5 → .5, 007 → 7
+    size_t firstNonZero = number.find_first_not_of('0');
+    if (firstNonZero == std::string::npos) {
+        number = "0";
+    } else {
+        number = number.substr(firstNonZero);
+    }
+
+    if (number == "0" && !keepZeroUnit) {
+        for (const char* zeroUnit : ZERO_UNITS) {
+            if (unit == zeroUnit) {
+                return "0";
+            }
+        }
+        return (unit.empty() ? "0" : "0" + unit);
+    }
+    if (number == "0") {
+        return "0" + unit;
+    }
+
+    return sign + number + unit;
+}
+
+std::string CssMinifier::formatBody(const std::vector<std::string>& declarations) {
+    std::string body;
+
+    for (const auto& decl : declarations) {
+        if (!body.empty()) {
+            body += ";";
+        }
+        body += minifyDeclaration(decl);
+    }
+
+    // No trailing semicolon: the closing brace terminates the last one
+    return body;
+}
+
+} // namespace artic
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "backend/css/CssRule.h"
+#include "shared/utils/OutputSink.h"
+
+namespace artic {
+
+/**
+ * @brief CSS Minifier - Final output stage for minified builds
+ *
+ * Serializes generated rules with no insignificant whitespace and applies
+ * value-level compression:
+ *
+ * .a { color: #ffffff; margin: 0rem; }
+ * .b { color: #ffffff; margin: 0rem; }
+ * @media (min-width: 640px) { .a { padding: 0.5rem; } }
+ *
+ * →
+ *
+ * .a,.b{color:#fff;margin:0}@media (min-width:640px){.a{padding:.5rem}}
+ *
+ * Only *adjacent* rules are merged (and only within the same @media
+ * context), so the cascade order of the input is preserved.
+ */
+class CssMinifier {
+public:
+    /**
+     * @brief Minify a list of rules into a single CSS string
+     * @param rules Rules in cascade order
+     * @return Minified CSS
+     */
+    std::string minify(const std::vector<CssRule>& rules) const;
+
+    /**
+     * @brief Minify a list of rules into a sink
+     */
+    void minify(const std::vector<CssRule>& rules, OutputSink& css) const;
+
+    /**
+     * @brief Minify a single declaration ("color: #ffffff" → "color:#fff")
+     */
+    static std::string minifyDeclaration(const std::string& declaration);
+
+    /**
+     * @brief Minify a declaration value (space-separated components)
+     *
+     * Quoted strings are left untouched.
+     */
+    static std::string minifyValue(const std::string& value);
+
+    /**
+     * @brief Minify a media query ("@media (min-width: 640px)" → "@media (min-width:640px)")
+     */
+    static std::string minifyMediaQuery(const std::string& mediaQuery);
+
+private:
+    // Shorten hex color (#ffffff → #fff, #AABBCCDD → #abcd)
+    static std::string shortenHexColor(const std::string& color);
+
+    // Compress a numeric length (0rem → 0, 0.5rem → .5rem); inside
+    // calc()/min()/max()/clamp() a zero keeps its unit
+    static std::string compressNumber(const std::string& component, bool keepZeroUnit);
+
+    // Render the body of a rule ("a:b;c:d", no trailing semicolon)
+    static std::string formatBody(const std::vector<std::string>& declarations);
+};
+
+} // namespace artic
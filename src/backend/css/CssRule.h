@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace artic {
+
+/**
+ * @brief A single CSS rule generated from a utility declaration
+ *
+ * Examples:
+ *   .btn { padding: 1rem; }
+ *     → mediaQuery="", selector=".btn", declarations={"padding: 1rem"}
+ *
+ *   @media (min-width: 640px) { .btn { padding: 1.5rem; } }
+ *     → mediaQuery="@media (min-width: 640px)", selector=".btn", ...
+ */
+struct CssRule {
+    std::string mediaQuery;                 // Enclosing @media (empty = top level)
+    std::string selector;                   // Selector (.btn, .btn:hover, etc.)
+    std::vector<std::string> declarations;  // "property: value" (no trailing ;)
+
+    bool isMediaQuery() const {
+        return !mediaQuery.empty();
+    }
+};
+
+} // namespace artic
@@ -0,0 +1,92 @@
+#include "backend/css/UtilityCache.h"
+#include "backend/css/CssMinifier.h"
+#include <algorithm>
+#include <functional>
+#include <mutex>
+
+namespace artic {
+
+UtilityCache::UtilityCache(const UtilityResolver& resolver, size_t capacity)
+    : m_resolver(resolver), m_shardCapacity(std::max<size_t>(1, capacity / SHARD_COUNT)) {}
+
+UtilityCache& UtilityCache::shared() {
+    static UtilityCache cache;
+    return cache;
+}
+
+UtilityCache::EntryPtr UtilityCache::resolve(const std::string& property, const std::string& value) {
+    // Key: "property:value" (property names never contain ':'). The key is
+    // built in a per-thread scratch buffer so cache hits never allocate.
+    thread_local std::string key;
+    key.assign(property);
+    key += ':';
+    key += value;
+
+    size_t hash = std::hash<std::string>{}(key);
+    Shard& shard = m_shards[hash % SHARD_COUNT];
+
+    // Fast path: shared lock
+    {
+        std::shared_lock lock(shard.mutex);
+        auto it = shard.entries.find(key);
+        if (it != shard.entries.end()) {
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+            return it->second;
+        }
+    }
+
+    // Slow path: resolve and render outside the lock, then insert (if
+    // another thread won the race its entry is kept and ours is discarded)
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    auto entry = std::make_shared<Entry>();
+    for (const auto& declaration : m_resolver.resolve(property, value)) {
+        entry->block += declaration;
+        entry->block += ";\n";
+
+        if (!entry->minified.empty()) {
+            entry->minified += ';';
+        }
+        entry->minified += CssMinifier::minifyDeclaration(declaration);
+    }
+
+    std::unique_lock lock(shard.mutex);
+    auto it = shard.entries.find(key);
+    if (it != shard.entries.end()) {
+        return it->second;
+    }
+
+    // Full shard: drop an arbitrary entry (holders keep their pointer)
+    if (shard.entries.size() >= m_shardCapacity) {
+        shard.entries.erase(shard.entries.begin());
+        m_evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    shard.entries.emplace(key, entry);
+    return entry;
+}
+
+UtilityCache::Stats UtilityCache::stats() const {
+    Stats result;
+    result.hits = m_hits.load(std::memory_order_relaxed);
+    result.misses = m_misses.load(std::memory_order_relaxed);
+    result.evictions = m_evictions.load(std::memory_order_relaxed);
+
+    for (const auto& shard : m_shards) {
+        std::shared_lock lock(shard.mutex);
+        result.entries += shard.entries.size();
+    }
+
+    return result;
+}
+
+void UtilityCache::clear() {
+    for (auto& shard : m_shards) {
+        std::unique_lock lock(shard.mutex);
+        shard.entries.clear();
+    }
+    m_hits.store(0, std::memory_order_relaxed);
+    m_misses.store(0, std::memory_order_relaxed);
+    m_evictions.store(0, std::memory_order_relaxed);
+}
+
+} // namespace artic
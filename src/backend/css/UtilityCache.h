@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include "backend/css/UtilityResolver.h"
+
+namespace artic {
+
+/**
+ * @brief Thread-safe memoization of UtilityResolver::resolve
+ *
+ * Tokens like px:4 or bg:blue-500 recur across every component of a site.
+ * The cache resolves each (property, value) pair once and hands out the
+ * rendered declaration block on every later use:
+ *
+ *   hover:bg:blue-500 ┐
+ *   bg:blue-500       ┴→ "background-color: #3b82f6;\n"
+ *
+ * The prefix only changes the selector a declaration is emitted under, so
+ * it is not part of the key; prefixed and base uses share one entry.
+ *
+ * The map is split into shards with a reader/writer lock each, so
+ * concurrent generators mostly take uncontended shared locks. Arbitrary
+ * values (w:[37px]) make the key space unbounded, so each shard holds at
+ * most capacity / SHARD_COUNT entries and evicts one when full. Entries
+ * are reference counted: an evicted block stays alive while a generator
+ * still holds it. A single process-wide instance is available via
+ * UtilityCache::shared().
+ */
+class UtilityCache {
+public:
+    /**
+     * @brief Resolved token, rendered once
+     */
+    struct Entry {
+        // One "property: value;" line per declaration ("" = unknown token)
+        std::string block;
+
+        // Minified declarations ("property:value;property:value")
+        std::string minified;
+    };
+
+    using EntryPtr = std::shared_ptr<const Entry>;
+
+    /**
+     * @brief Hit/miss statistics
+     */
+    struct Stats {
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        std::uint64_t evictions = 0;
+        size_t entries = 0;
+    };
+
+    static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+    explicit UtilityCache(const UtilityResolver& resolver = UtilityResolver::instance(),
+                          size_t capacity = DEFAULT_CAPACITY);
+
+    UtilityCache(const UtilityCache&) = delete;
+    UtilityCache& operator=(const UtilityCache&) = delete;
+
+    /**
+     * @brief Cache shared by every CssGenerator in the process
+     */
+    static UtilityCache& shared();
+
+    /**
+     * @brief Resolve a utility token, memoizing the result
+     * @param property Property name (px, bg, text, etc.)
+     * @param value Value (4, blue-500, lg, etc.)
+     * @return Rendered entry (kept alive by the pointer, even if evicted)
+     */
+    EntryPtr resolve(const std::string& property, const std::string& value);
+
+    /**
+     * @brief Get hit/miss counters and current entry count
+     */
+    Stats stats() const;
+
+    /**
+     * @brief Drop all entries and reset counters
+     */
+    void clear();
+
+private:
+    static constexpr size_t SHARD_COUNT = 16;
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<std::string, EntryPtr> entries;
+    };
+
+    const UtilityResolver& m_resolver;
+    size_t m_shardCapacity;
+    std::array<Shard, SHARD_COUNT> m_shards;
+    std::atomic<std::uint64_t> m_hits{0};
+    std::atomic<std::uint64_t> m_misses{0};
+    std::atomic<std::uint64_t> m_evictions{0};
+};
+
+} // namespace artic
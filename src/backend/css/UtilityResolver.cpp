@@ -1,267 +1,472 @@
 #include "backend/css/UtilityResolver.h"
-#include <sstream>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdio>
 
 namespace artic {
 
-UtilityResolver::UtilityResolver() {
-    initSpacing();
-    initColors();
-    initFontSizes();
-    initPropertyMap();
+namespace {
+
+// ===== Table entry types =====
+
+struct ValueEntry {
+    std::string_view key;
+    std::string_view value;
+};
+
+// One hue of the palette: packed 0xRRGGBB per shade 50, 100, ..., 900, 950
+struct PaletteEntry {
+    std::string_view key;
+    std::array<std::uint32_t, 11> shades;
+};
+
+struct FontSizeEntry {
+    std::string_view key;
+    std::string_view fontSize;
+    std::string_view lineHeight;
+};
+
+struct PropertyEntry {
+    std::string_view key;
+    UtilityKind kind;
+    std::string_view first;   // First CSS property
+    std::string_view second;  // Second CSS property (empty if none)
+};
+
+// ===== Compile-time lookup =====
+
+template <typename Entry, size_t N>
+constexpr bool isSortedByKey(const std::array<Entry, N>& table) {
+    for (size_t i = 1; i < N; i++) {
+        if (!(table[i - 1].key < table[i].key)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Binary search over a table sorted by key (nullptr if not found)
+template <typename Entry, size_t N>
+constexpr const Entry* findEntry(const std::array<Entry, N>& table, std::string_view key) {
+    auto it = std::lower_bound(table.begin(), table.end(), key,
+        [](const Entry& entry, std::string_view k) { return entry.key < k; });
+    if (it != table.end() && it->key == key) {
+        return &*it;
+    }
+    return nullptr;
+}
+
+// ===== Tables (keys must stay sorted; checked by static_assert) =====
+
+// Tailwind color palette (22 hues x 11 shades)
+constexpr std::array PALETTE = {
+    PaletteEntry{"amber", {0xfffbeb, 0xfef3c7, 0xfde68a, 0xfcd34d, 0xfbbf24, 0xf59e0b, 0xd97706, 0xb45309, 0x92400e, 0x78350f, 0x451a03}},
+    PaletteEntry{"blue", {0xeff6ff, 0xdbeafe, 0xbfdbfe, 0x93c5fd, 0x60a5fa, 0x3b82f6, 0x2563eb, 0x1d4ed8, 0x1e40af, 0x1e3a8a, 0x172554}},
+    PaletteEntry{"cyan", {0xecfeff, 0xcffafe, 0xa5f3fc, 0x67e8f9, 0x22d3ee, 0x06b6d4, 0x0891b2, 0x0e7490, 0x155e75, 0x164e63, 0x083344}},
+    PaletteEntry{"emerald", {0xecfdf5, 0xd1fae5, 0xa7f3d0, 0x6ee7b7, 0x34d399, 0x10b981, 0x059669, 0x047857, 0x065f46, 0x064e3b, 0x022c22}},
+    PaletteEntry{"fuchsia", {0xfdf4ff, 0xfae8ff, 0xf5d0fe, 0xf0abfc, 0xe879f9, 0xd946ef, 0xc026d3, 0xa21caf, 0x86198f, 0x701a75, 0x4a044e}},
+    PaletteEntry{"gray", {0xf9fafb, 0xf3f4f6, 0xe5e7eb, 0xd1d5db, 0x9ca3af, 0x6b7280, 0x4b5563, 0x374151, 0x1f2937, 0x111827, 0x030712}},
+    PaletteEntry{"green", {0xf0fdf4, 0xdcfce7, 0xbbf7d0, 0x86efac, 0x4ade80, 0x22c55e, 0x16a34a, 0x15803d, 0x166534, 0x14532d, 0x052e16}},
+    PaletteEntry{"indigo", {0xeef2ff, 0xe0e7ff, 0xc7d2fe, 0xa5b4fc, 0x818cf8, 0x6366f1, 0x4f46e5, 0x4338ca, 0x3730a3, 0x312e81, 0x1e1b4b}},
+    PaletteEntry{"lime", {0xf7fee7, 0xecfccb, 0xd9f99d, 0xbef264, 0xa3e635, 0x84cc16, 0x65a30d, 0x4d7c0f, 0x3f6212, 0x365314, 0x1a2e05}},
+    PaletteEntry{"neutral", {0xfafafa, 0xf5f5f5, 0xe5e5e5, 0xd4d4d4, 0xa3a3a3, 0x737373, 0x525252, 0x404040, 0x262626, 0x171717, 0x0a0a0a}},
+    PaletteEntry{"orange", {0xfff7ed, 0xffedd5, 0xfed7aa, 0xfdba74, 0xfb923c, 0xf97316, 0xea580c, 0xc2410c, 0x9a3412, 0x7c2d12, 0x431407}},
+    PaletteEntry{"pink", {0xfdf2f8, 0xfce7f3, 0xfbcfe8, 0xf9a8d4, 0xf472b6, 0xec4899, 0xdb2777, 0xbe185d, 0x9d174d, 0x831843, 0x500724}},
+    PaletteEntry{"purple", {0xfaf5ff, 0xf3e8ff, 0xe9d5ff, 0xd8b4fe, 0xc084fc, 0xa855f7, 0x9333ea, 0x7e22ce, 0x6b21a8, 0x581c87, 0x3b0764}},
+    PaletteEntry{"red", {0xfef2f2, 0xfee2e2, 0xfecaca, 0xfca5a5, 0xf87171, 0xef4444, 0xdc2626, 0xb91c1c, 0x991b1b, 0x7f1d1d, 0x450a0a}},
+    PaletteEntry{"rose", {0xfff1f2, 0xffe4e6, 0xfecdd3, 0xfda4af, 0xfb7185, 0xf43f5e, 0xe11d48, 0xbe123c, 0x9f1239, 0x881337, 0x4c0519}},
+    PaletteEntry{"sky", {0xf0f9ff, 0xe0f2fe, 0xbae6fd, 0x7dd3fc, 0x38bdf8, 0x0ea5e9, 0x0284c7, 0x0369a1, 0x075985, 0x0c4a6e, 0x082f49}},
+    PaletteEntry{"slate", {0xf8fafc, 0xf1f5f9, 0xe2e8f0, 0xcbd5e1, 0x94a3b8, 0x64748b, 0x475569, 0x334155, 0x1e293b, 0x0f172a, 0x020617}},
+    PaletteEntry{"stone", {0xfafaf9, 0xf5f5f4, 0xe7e5e4, 0xd6d3d1, 0xa8a29e, 0x78716c, 0x57534e, 0x44403c, 0x292524, 0x1c1917, 0x0c0a09}},
+    PaletteEntry{"teal", {0xf0fdfa, 0xccfbf1, 0x99f6e4, 0x5eead4, 0x2dd4bf, 0x14b8a6, 0x0d9488, 0x0f766e, 0x115e59, 0x134e4a, 0x042f2e}},
+    PaletteEntry{"violet", {0xf5f3ff, 0xede9fe, 0xddd6fe, 0xc4b5fd, 0xa78bfa, 0x8b5cf6, 0x7c3aed, 0x6d28d9, 0x5b21b6, 0x4c1d95, 0x2e1065}},
+    PaletteEntry{"yellow", {0xfefce8, 0xfef9c3, 0xfef08a, 0xfde047, 0xfacc15, 0xeab308, 0xca8a04, 0xa16207, 0x854d0e, 0x713f12, 0x422006}},
+    PaletteEntry{"zinc", {0xfafafa, 0xf4f4f5, 0xe4e4e7, 0xd4d4d8, 0xa1a1aa, 0x71717a, 0x52525b, 0x3f3f46, 0x27272a, 0x18181b, 0x09090b}},
+};
+
+// Colors outside the palette
+constexpr std::array NAMED_COLORS = {
+    ValueEntry{"black", "#000000"},
+    ValueEntry{"current", "currentColor"},
+    ValueEntry{"inherit", "inherit"},
+    ValueEntry{"transparent", "transparent"},
+    ValueEntry{"white", "#ffffff"},
+};
+
+// Width/height keywords (screen is handled separately: 100vw / 100vh)
+constexpr std::array SIZE_KEYWORDS = {
+    ValueEntry{"auto", "auto"},
+    ValueEntry{"fit", "fit-content"},
+    ValueEntry{"full", "100%"},
+    ValueEntry{"max", "max-content"},
+    ValueEntry{"min", "min-content"},
+};
+
+// Font size + line height
+constexpr std::array FONT_SIZES = {
+    FontSizeEntry{"2xl", "1.5rem", "2rem"},
+    FontSizeEntry{"3xl", "1.875rem", "2.25rem"},
+    FontSizeEntry{"4xl", "2.25rem", "2.5rem"},
+    FontSizeEntry{"5xl", "3rem", "1"},
+    FontSizeEntry{"6xl", "3.75rem", "1"},
+    FontSizeEntry{"base", "1rem", "1.5rem"},
+    FontSizeEntry{"lg", "1.125rem", "1.75rem"},
+    FontSizeEntry{"sm", "0.875rem", "1.25rem"},
+    FontSizeEntry{"xl", "1.25rem", "1.75rem"},
+    FontSizeEntry{"xs", "0.75rem", "1rem"},
+};
+
+// Font weights (font:bold → font-weight: 700)
+constexpr std::array FONT_WEIGHTS = {
+    ValueEntry{"bold", "700"},
+    ValueEntry{"medium", "500"},
+    ValueEntry{"normal", "400"},
+    ValueEntry{"semibold", "600"},
+};
+
+// Border radius (rounded with no value → md)
+constexpr std::array RADII = {
+    ValueEntry{"", "0.375rem"},
+    ValueEntry{"full", "9999px"},
+    ValueEntry{"lg", "0.5rem"},
+    ValueEntry{"md", "0.375rem"},
+    ValueEntry{"none", "0"},
+    ValueEntry{"sm", "0.125rem"},
+    ValueEntry{"xl", "0.75rem"},
+};
+
+// align-items keywords (items:center → align-items: center)
+constexpr std::array ALIGN_ITEMS = {
+    ValueEntry{"baseline", "baseline"},
+    ValueEntry{"center", "center"},
+    ValueEntry{"end", "end"},
+    ValueEntry{"flex-end", "flex-end"},
+    ValueEntry{"flex-start", "flex-start"},
+    ValueEntry{"normal", "normal"},
+    ValueEntry{"self-end", "self-end"},
+    ValueEntry{"self-start", "self-start"},
+    ValueEntry{"start", "start"},
+    ValueEntry{"stretch", "stretch"},
+};
+
+// justify-content keywords (justify:between → justify-content: space-between)
+constexpr std::array JUSTIFY_CONTENT = {
+    ValueEntry{"around", "space-around"},
+    ValueEntry{"between", "space-between"},
+    ValueEntry{"center", "center"},
+    ValueEntry{"end", "end"},
+    ValueEntry{"evenly", "space-evenly"},
+    ValueEntry{"flex-end", "flex-end"},
+    ValueEntry{"flex-start", "flex-start"},
+    ValueEntry{"left", "left"},
+    ValueEntry{"normal", "normal"},
+    ValueEntry{"right", "right"},
+    ValueEntry{"space-around", "space-around"},
+    ValueEntry{"space-between", "space-between"},
+    ValueEntry{"space-evenly", "space-evenly"},
+    ValueEntry{"start", "start"},
+    ValueEntry{"stretch", "stretch"},
+};
+
+// Property mappings
+constexpr std::array PROPERTIES = {
+    PropertyEntry{"bg", UtilityKind::Color, "background-color", ""},
+    PropertyEntry{"block", UtilityKind::Display, "display", ""},
+    PropertyEntry{"border", UtilityKind::Spacing, "border-width", ""},
+    PropertyEntry{"flex", UtilityKind::Display, "display", ""},
+    PropertyEntry{"font", UtilityKind::FontWeight, "font-weight", ""},
+    PropertyEntry{"gap", UtilityKind::Spacing, "gap", ""},
+    PropertyEntry{"grid", UtilityKind::Display, "display", ""},
+    PropertyEntry{"h", UtilityKind::Size, "height", ""},
+    PropertyEntry{"inline", UtilityKind::Display, "display", ""},
+    PropertyEntry{"items", UtilityKind::AlignItems, "align-items", ""},
+    PropertyEntry{"justify", UtilityKind::JustifyContent, "justify-content", ""},
+    PropertyEntry{"m", UtilityKind::Spacing, "margin", ""},
+    PropertyEntry{"mb", UtilityKind::Spacing, "margin-bottom", ""},
+    PropertyEntry{"ml", UtilityKind::Spacing, "margin-left", ""},
+    PropertyEntry{"mr", UtilityKind::Spacing, "margin-right", ""},
+    PropertyEntry{"mt", UtilityKind::Spacing, "margin-top", ""},
+    PropertyEntry{"mx", UtilityKind::Spacing, "margin-left", "margin-right"},
+    PropertyEntry{"my", UtilityKind::Spacing, "margin-top", "margin-bottom"},
+    PropertyEntry{"p", UtilityKind::Spacing, "padding", ""},
+    PropertyEntry{"pb", UtilityKind::Spacing, "padding-bottom", ""},
+    PropertyEntry{"pl", UtilityKind::Spacing, "padding-left", ""},
+    PropertyEntry{"pr", UtilityKind::Spacing, "padding-right", ""},
+    PropertyEntry{"pt", UtilityKind::Spacing, "padding-top", ""},
+    PropertyEntry{"px", UtilityKind::Spacing, "padding-left", "padding-right"},
+    PropertyEntry{"py", UtilityKind::Spacing, "padding-top", "padding-bottom"},
+    PropertyEntry{"rounded", UtilityKind::Radius, "border-radius", ""},
+    PropertyEntry{"text", UtilityKind::Text, "color", ""},
+    PropertyEntry{"w", UtilityKind::Size, "width", ""},
+};
+
+static_assert(isSortedByKey(PALETTE), "PALETTE must be sorted by key");
+static_assert(isSortedByKey(NAMED_COLORS), "NAMED_COLORS must be sorted by key");
+static_assert(isSortedByKey(SIZE_KEYWORDS), "SIZE_KEYWORDS must be sorted by key");
+static_assert(isSortedByKey(FONT_SIZES), "FONT_SIZES must be sorted by key");
+static_assert(isSortedByKey(FONT_WEIGHTS), "FONT_WEIGHTS must be sorted by key");
+static_assert(isSortedByKey(RADII), "RADII must be sorted by key");
+static_assert(isSortedByKey(ALIGN_ITEMS), "ALIGN_ITEMS must be sorted by key");
+static_assert(isSortedByKey(JUSTIFY_CONTENT), "JUSTIFY_CONTENT must be sorted by key");
+static_assert(isSortedByKey(PROPERTIES), "PROPERTIES must be sorted by key");
+
+// ===== Parametric values =====
+
+// Spacing unit: n → n * 0.25rem
+constexpr double SPACING_STEP_REM = 0.25;
+
+// [value] escape → raw CSS value (underscores stand for spaces)
+bool parseArbitrary(std::string_view value, std::string& out) {
+    if (value.size() < 3 || value.front() != '[' || value.back() != ']') {
+        return false;
+    }
+    out.assign(value.substr(1, value.size() - 2));
+    std::replace(out.begin(), out.end(), '_', ' ');
+    return true;
+}
+
+// Non-negative decimal number ("4", "0.5", "2.5")
+bool parseNumber(std::string_view value, double& out) {
+    if (value.empty()) {
+        return false;
+    }
+    const char* end = value.data() + value.size();
+    auto [ptr, ec] = std::from_chars(value.data(), end, out, std::chars_format::fixed);
+    return ec == std::errc() && ptr == end && out >= 0;
+}
+
+// Shortest round-trip representation (1 → "1", 0.125 → "0.125")
+std::string formatNumber(double number) {
+    char buffer[32];
+    auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), number);
+    return std::string(buffer, ec == std::errc() ? ptr : buffer);
+}
+
+// Fraction → percentage (1/2 → 50%, 1/3 → 33.333333%)
+bool parseFraction(std::string_view value, std::string& out) {
+    size_t slash = value.find('/');
+    if (slash == std::string_view::npos) {
+        return false;
+    }
+
+    double numerator = 0;
+    double denominator = 0;
+    if (!parseNumber(value.substr(0, slash), numerator) ||
+        !parseNumber(value.substr(slash + 1), denominator) || denominator == 0) {
+        return false;
+    }
+
+    char buffer[32];
+    int length = std::snprintf(buffer, sizeof(buffer), "%.6f", numerator / denominator * 100);
+    std::string percent(buffer, length > 0 ? static_cast<size_t>(length) : 0);
+
+    // Trim trailing zeros: 50.000000 → 50
+    percent.erase(percent.find_last_not_of('0') + 1);
+    if (!percent.empty() && percent.back() == '.') {
+        percent.pop_back();
+    }
+
+    out = percent + "%";
+    return true;
 }
 
-void UtilityResolver::initSpacing() {
-    // Tailwind spacing scale (0-96)
-    m_spacing["0"] = "0";
-    m_spacing["1"] = "0.25rem";
-    m_spacing["2"] = "0.5rem";
-    m_spacing["3"] = "0.75rem";
-    m_spacing["4"] = "1rem";
-    m_spacing["5"] = "1.25rem";
-    m_spacing["6"] = "1.5rem";
-    m_spacing["8"] = "2rem";
-    m_spacing["10"] = "2.5rem";
-    m_spacing["12"] = "3rem";
-    m_spacing["16"] = "4rem";
-    m_spacing["20"] = "5rem";
-    m_spacing["24"] = "6rem";
-    m_spacing["32"] = "8rem";
-    m_spacing["40"] = "10rem";
-    m_spacing["48"] = "12rem";
-    m_spacing["56"] = "14rem";
-    m_spacing["64"] = "16rem";
+// Shade name → palette column (50 → 0, 100 → 1, ..., 900 → 9, 950 → 10)
+int shadeIndex(std::string_view shade) {
+    if (shade == "50") {
+        return 0;
+    }
+    if (shade == "950") {
+        return 10;
+    }
+    if (shade.size() == 3 && shade[0] >= '1' && shade[0] <= '9' &&
+        shade[1] == '0' && shade[2] == '0') {
+        return shade[0] - '0';
+    }
+    return -1;
 }
 
-void UtilityResolver::initColors() {
-    // Blue palette
-    m_colors["blue-50"] = "#eff6ff";
-    m_colors["blue-100"] = "#dbeafe";
-    m_colors["blue-200"] = "#bfdbfe";
-    m_colors["blue-300"] = "#93c5fd";
-    m_colors["blue-400"] = "#60a5fa";
-    m_colors["blue-500"] = "#3b82f6";
-    m_colors["blue-600"] = "#2563eb";
-    m_colors["blue-700"] = "#1d4ed8";
-    m_colors["blue-800"] = "#1e40af";
-    m_colors["blue-900"] = "#1e3a8a";
-
-    // Gray palette
-    m_colors["gray-50"] = "#f9fafb";
-    m_colors["gray-100"] = "#f3f4f6";
-    m_colors["gray-200"] = "#e5e7eb";
-    m_colors["gray-300"] = "#d1d5db";
-    m_colors["gray-400"] = "#9ca3af";
-    m_colors["gray-500"] = "#6b7280";
-    m_colors["gray-600"] = "#4b5563";
-    m_colors["gray-700"] = "#374151";
-    m_colors["gray-800"] = "#1f2937";
-    m_colors["gray-900"] = "#111827";
-
-    // Red palette
-    m_colors["red-500"] = "#ef4444";
-    m_colors["red-600"] = "#dc2626";
-    m_colors["red-700"] = "#b91c1c";
-
-    // Green palette
-    m_colors["green-500"] = "#22c55e";
-    m_colors["green-600"] = "#16a34a";
-    m_colors["green-700"] = "#15803d";
-
-    // Common colors
-    m_colors["white"] = "#ffffff";
-    m_colors["black"] = "#000000";
-    m_colors["transparent"] = "transparent";
+std::string hexColor(std::uint32_t rgb) {
+    static constexpr char DIGITS[] = "0123456789abcdef";
+    std::string result(7, '#');
+    for (int i = 0; i < 6; i++) {
+        result[1 + i] = DIGITS[(rgb >> (20 - 4 * i)) & 0xF];
+    }
+    return result;
 }
 
-void UtilityResolver::initFontSizes() {
-    // Font size + line height
-    m_fontSizes["xs"] = {"0.75rem", "1rem"};
-    m_fontSizes["sm"] = {"0.875rem", "1.25rem"};
-    m_fontSizes["base"] = {"1rem", "1.5rem"};
-    m_fontSizes["lg"] = {"1.125rem", "1.75rem"};
-    m_fontSizes["xl"] = {"1.25rem", "1.75rem"};
-    m_fontSizes["2xl"] = {"1.5rem", "2rem"};
-    m_fontSizes["3xl"] = {"1.875rem", "2.25rem"};
-    m_fontSizes["4xl"] = {"2.25rem", "2.5rem"};
-    m_fontSizes["5xl"] = {"3rem", "1"};
-    m_fontSizes["6xl"] = {"3.75rem", "1"};
+std::string declaration(std::string_view property, std::string_view value) {
+    std::string result;
+    result.reserve(property.size() + 2 + value.size());
+    result.append(property);
+    result.append(": ");
+    result.append(value);
+    return result;
 }
 
-void UtilityResolver::initPropertyMap() {
-    // Padding
-    m_propertyMap["p"] = {"padding"};
-    m_propertyMap["px"] = {"padding-left", "padding-right"};
-    m_propertyMap["py"] = {"padding-top", "padding-bottom"};
-    m_propertyMap["pt"] = {"padding-top"};
-    m_propertyMap["pr"] = {"padding-right"};
-    m_propertyMap["pb"] = {"padding-bottom"};
-    m_propertyMap["pl"] = {"padding-left"};
-
-    // Margin
-    m_propertyMap["m"] = {"margin"};
-    m_propertyMap["mx"] = {"margin-left", "margin-right"};
-    m_propertyMap["my"] = {"margin-top", "margin-bottom"};
-    m_propertyMap["mt"] = {"margin-top"};
-    m_propertyMap["mr"] = {"margin-right"};
-    m_propertyMap["mb"] = {"margin-bottom"};
-    m_propertyMap["ml"] = {"margin-left"};
-
-    // Width & Height
-    m_propertyMap["w"] = {"width"};
-    m_propertyMap["h"] = {"height"};
-
-    // Background
-    m_propertyMap["bg"] = {"background-color"};
-
-    // Text
-    m_propertyMap["text"] = {"color"}; // text:blue-500 → color
-    m_propertyMap["font"] = {"font-weight"}; // font:bold → font-weight
-
-    // Flex
-    m_propertyMap["flex"] = {"display"};
-    m_propertyMap["justify"] = {"justify-content"};
-    m_propertyMap["items"] = {"align-items"};
-    m_propertyMap["gap"] = {"gap"};
-
-    // Border
-    m_propertyMap["rounded"] = {"border-radius"};
-    m_propertyMap["border"] = {"border-width"};
-
-    // Display
-    m_propertyMap["grid"] = {"display"};
-    m_propertyMap["block"] = {"display"};
-    m_propertyMap["inline"] = {"display"};
+// Emit one declaration per CSS property of the entry
+void appendDeclarations(std::vector<std::string>& out, const PropertyEntry& entry, std::string_view value) {
+    out.push_back(declaration(entry.first, value));
+    if (!entry.second.empty()) {
+        out.push_back(declaration(entry.second, value));
+    }
+}
+
+} // namespace
+
+const UtilityResolver& UtilityResolver::instance() {
+    static const UtilityResolver resolver;
+    return resolver;
 }
 
-std::vector<std::string> UtilityResolver::resolve(const std::string& property, const std::string& value) {
+std::vector<std::string> UtilityResolver::resolve(const std::string& property, const std::string& value) const {
     std::vector<std::string> declarations;
 
-    auto cssProps = getCssProperties(property);
-    if (cssProps.empty()) {
+    const PropertyEntry* entry = findEntry(PROPERTIES, property);
+    if (!entry) {
         return declarations; // Unknown property
     }
 
-    // Special cases
-    if (property == "w" || property == "h") {
-        // Width/height special values
-        if (value == "full") {
-            for (const auto& cssProp : cssProps) {
-                declarations.push_back(cssProp + ": 100%");
+    switch (entry->kind) {
+        case UtilityKind::Size:
+            appendDeclarations(declarations, *entry, resolveSize(value, property == "h"));
+            break;
+
+        case UtilityKind::Display:
+            // flex, grid, block, inline → display: <keyword>
+            appendDeclarations(declarations, *entry, entry->key);
+            break;
+
+        case UtilityKind::Text:
+            // Check text:size BEFORE text:color (font-size takes priority)
+            if (findEntry(FONT_SIZES, value)) {
+                auto [fontSize, lineHeight] = resolveFontSize(value);
+                declarations.push_back(declaration("font-size", fontSize));
+                declarations.push_back(declaration("line-height", lineHeight));
+            } else {
+                appendDeclarations(declarations, *entry, resolveColor(value));
             }
-        } else if (value == "screen") {
-            for (const auto& cssProp : cssProps) {
-                declarations.push_back(cssProp + ": 100vw");
+            break;
+
+        case UtilityKind::Color:
+            appendDeclarations(declarations, *entry, resolveColor(value));
+            break;
+
+        case UtilityKind::FontWeight:
+            if (const ValueEntry* weight = findEntry(FONT_WEIGHTS, value)) {
+                appendDeclarations(declarations, *entry, weight->value);
             }
-        } else {
-            std::string resolved = resolveSpacing(value);
-            for (const auto& cssProp : cssProps) {
-                declarations.push_back(cssProp + ": " + resolved);
+            break;
+
+        case UtilityKind::Radius:
+            if (const ValueEntry* radius = findEntry(RADII, value)) {
+                appendDeclarations(declarations, *entry, radius->value);
             }
-        }
-        return declarations;
+            break;
+
+        case UtilityKind::AlignItems:
+            if (const ValueEntry* keyword = findEntry(ALIGN_ITEMS, value)) {
+                appendDeclarations(declarations, *entry, keyword->value);
+            }
+            break;
+
+        case UtilityKind::JustifyContent:
+            if (const ValueEntry* keyword = findEntry(JUSTIFY_CONTENT, value)) {
+                appendDeclarations(declarations, *entry, keyword->value);
+            }
+            break;
+
+        case UtilityKind::Spacing:
+            // Default: spacing properties (padding, margin, gap)
+            appendDeclarations(declarations, *entry, resolveSpacing(value));
+            break;
     }
 
-    if (property == "flex") {
-        declarations.push_back("display: flex");
-        return declarations;
+    return declarations;
+}
+
+bool UtilityResolver::isValidProperty(const std::string& property) const {
+    return findEntry(PROPERTIES, property) != nullptr;
+}
+
+std::vector<std::string> UtilityResolver::getCssProperties(const std::string& property) const {
+    const PropertyEntry* entry = findEntry(PROPERTIES, property);
+    if (!entry) {
+        return {};
     }
 
-    if (property == "grid") {
-        declarations.push_back("display: grid");
-        return declarations;
+    std::vector<std::string> properties{std::string(entry->first)};
+    if (!entry->second.empty()) {
+        properties.emplace_back(entry->second);
     }
+    return properties;
+}
 
-    // Check text:size BEFORE text:color (font-size takes priority)
-    if (property == "text" && m_fontSizes.count(value)) {
-        // Font size
-        auto [fontSize, lineHeight] = resolveFontSize(value);
-        declarations.push_back("font-size: " + fontSize);
-        declarations.push_back("line-height: " + lineHeight);
-        return declarations;
+std::string UtilityResolver::resolveSpacing(std::string_view value) {
+    std::string resolved;
+    if (parseArbitrary(value, resolved)) {
+        return resolved;
     }
 
-    if (property == "bg" || property == "text") {
-        // Color properties
-        std::string resolved = resolveColor(value);
-        for (const auto& cssProp : cssProps) {
-            declarations.push_back(cssProp + ": " + resolved);
-        }
-        return declarations;
+    if (value == "px") {
+        return "1px";
     }
 
-    if (property == "font") {
-        // Font weight
-        if (value == "bold") {
-            declarations.push_back("font-weight: 700");
-        } else if (value == "semibold") {
-            declarations.push_back("font-weight: 600");
-        } else if (value == "medium") {
-            declarations.push_back("font-weight: 500");
-        } else if (value == "normal") {
-            declarations.push_back("font-weight: 400");
+    double steps = 0;
+    if (parseNumber(value, steps)) {
+        if (steps == 0) {
+            return "0";
         }
-        return declarations;
+        return formatNumber(steps * SPACING_STEP_REM) + "rem";
     }
 
-    if (property == "rounded") {
-        // Border radius
-        if (value == "none") {
-            declarations.push_back("border-radius: 0");
-        } else if (value == "sm") {
-            declarations.push_back("border-radius: 0.125rem");
-        } else if (value == "md" || value.empty()) {
-            declarations.push_back("border-radius: 0.375rem");
-        } else if (value == "lg") {
-            declarations.push_back("border-radius: 0.5rem");
-        } else if (value == "xl") {
-            declarations.push_back("border-radius: 0.75rem");
-        } else if (value == "full") {
-            declarations.push_back("border-radius: 9999px");
-        }
-        return declarations;
+    return std::string(value); // Return as-is (auto, etc.)
+}
+
+std::string UtilityResolver::resolveSize(std::string_view value, bool isHeight) {
+    // Width/height special values
+    if (value == "screen") {
+        return isHeight ? "100vh" : "100vw";
     }
 
-    // Default: spacing properties (padding, margin, gap)
-    std::string resolved = resolveSpacing(value);
-    for (const auto& cssProp : cssProps) {
-        declarations.push_back(cssProp + ": " + resolved);
+    if (const ValueEntry* keyword = findEntry(SIZE_KEYWORDS, value)) {
+        return std::string(keyword->value);
     }
 
-    return declarations;
-}
+    std::string resolved;
+    if (parseFraction(value, resolved)) {
+        return resolved;
+    }
 
-bool UtilityResolver::isValidProperty(const std::string& property) const {
-    return m_propertyMap.count(property) > 0;
+    return resolveSpacing(value);
 }
 
-std::vector<std::string> UtilityResolver::getCssProperties(const std::string& property) const {
-    auto it = m_propertyMap.find(property);
-    if (it != m_propertyMap.end()) {
-        return it->second;
+std::string UtilityResolver::resolveColor(std::string_view value) {
+    std::string resolved;
+    if (parseArbitrary(value, resolved)) {
+        return resolved;
     }
-    return {};
-}
 
-std::string UtilityResolver::resolveSpacing(const std::string& value) {
-    auto it = m_spacing.find(value);
-    if (it != m_spacing.end()) {
-        return it->second;
+    if (const ValueEntry* named = findEntry(NAMED_COLORS, value)) {
+        return std::string(named->value);
     }
-    return value; // Return as-is if not found
-}
 
-std::string UtilityResolver::resolveColor(const std::string& value) {
-    auto it = m_colors.find(value);
-    if (it != m_colors.end()) {
-        return it->second;
+    // hue-shade (blue-500)
+    size_t dash = value.rfind('-');
+    if (dash != std::string_view::npos) {
+        const PaletteEntry* hue = findEntry(PALETTE, value.substr(0, dash));
+        int shade = shadeIndex(value.substr(dash + 1));
+        if (hue && shade >= 0) {
+            return hexColor(hue->shades[shade]);
+        }
     }
-    return value; // Return as-is if not found
+
+    return std::string(value); // Return as-is if not found
 }
 
-std::pair<std::string, std::string> UtilityResolver::resolveFontSize(const std::string& value) {
-    auto it = m_fontSizes.find(value);
-    if (it != m_fontSizes.end()) {
-        return it->second;
+std::pair<std::string_view, std::string_view> UtilityResolver::resolveFontSize(std::string_view value) {
+    if (const FontSizeEntry* entry = findEntry(FONT_SIZES, value)) {
+        return {entry->fontSize, entry->lineHeight};
     }
     return {"1rem", "1.5rem"}; // Default
 }
@@ -1,11 +1,27 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 
 namespace artic {
 
+/**
+ * @brief How a utility property interprets its value
+ */
+enum class UtilityKind : std::uint8_t {
+    Spacing,        // p, px, m, gap, ... (4 → 1rem)
+    Size,           // w, h (full, screen, spacing scale)
+    Color,          // bg (blue-500 → #3b82f6)
+    Text,           // text (font size first, then color)
+    FontWeight,     // font (bold → 700)
+    Radius,         // rounded (md → 0.375rem)
+    Display,        // flex, grid, block, inline (value is the keyword itself)
+    AlignItems,     // items (center, start, baseline, ...)
+    JustifyContent  // justify (between → space-between, center, ...)
+};
+
 /**
  * @brief Resolves Tailwind-like utility tokens to CSS properties
  *
@@ -13,10 +29,22 @@ namespace artic {
  *   px:4 → padding-left: 1rem; padding-right: 1rem;
  *   bg:blue-500 → background-color: #3b82f6;
  *   text:lg → font-size: 1.125rem; line-height: 1.75rem;
+ *
+ * Scales are computed rather than enumerated: any spacing step (n * 0.25rem),
+ * fractions (w:1/2 → 50%), arbitrary values (w:[37px]) and the full color
+ * palette (hue-shade packed into one constexpr row per hue). Keyword scales
+ * live in constexpr sorted tables, so the resolver holds no state:
+ * construction is free and a single instance can be shared by every
+ * CssGenerator (and thread) in a build via UtilityResolver::instance().
  */
 class UtilityResolver {
 public:
-    UtilityResolver();
+    UtilityResolver() = default;
+
+    /**
+     * @brief Shared resolver instance
+     */
+    static const UtilityResolver& instance();
 
     /**
      * @brief Resolve a utility token to CSS declaration(s)
@@ -24,7 +52,7 @@ public:
      * @param value Value (4, blue-500, lg, etc.)
      * @return Vector of CSS declarations (property: value;)
      */
-    std::vector<std::string> resolve(const std::string& property, const std::string& value);
+    std::vector<std::string> resolve(const std::string& property, const std::string& value) const;
 
     /**
      * @brief Check if property is valid
@@ -37,52 +65,25 @@ public:
     std::vector<std::string> getCssProperties(const std::string& property) const;
 
 private:
-    // Spacing values (px, py, p, m, etc.)
-    std::unordered_map<std::string, std::string> m_spacing;
-
-    // Color palette
-    std::unordered_map<std::string, std::string> m_colors;
-
-    // Font sizes
-    std::unordered_map<std::string, std::pair<std::string, std::string>> m_fontSizes;
-
-    // Property mappings
-    std::unordered_map<std::string, std::vector<std::string>> m_propertyMap;
-
-    /**
-     * @brief Initialize spacing scale (0-96)
-     */
-    void initSpacing();
-
-    /**
-     * @brief Initialize color palette
-     */
-    void initColors();
-
-    /**
-     * @brief Initialize font sizes
-     */
-    void initFontSizes();
-
     /**
-     * @brief Initialize property mappings
+     * @brief Resolve spacing value (4 → 1rem, 0.5 → 0.125rem, [3px] → 3px)
      */
-    void initPropertyMap();
+    static std::string resolveSpacing(std::string_view value);
 
     /**
-     * @brief Resolve spacing value (4 → 1rem)
+     * @brief Resolve width/height value (full, screen, 1/2, or spacing)
      */
-    std::string resolveSpacing(const std::string& value);
+    static std::string resolveSize(std::string_view value, bool isHeight);
 
     /**
-     * @brief Resolve color value (blue-500 → #3b82f6)
+     * @brief Resolve color value (blue-500 → #3b82f6, [#1da1f2] → #1da1f2)
      */
-    std::string resolveColor(const std::string& value);
+    static std::string resolveColor(std::string_view value);
 
     /**
      * @brief Resolve font size (lg → 1.125rem + line-height)
      */
-    std::pair<std::string, std::string> resolveFontSize(const std::string& value);
+    static std::pair<std::string_view, std::string_view> resolveFontSize(std::string_view value);
 };
 
 } // namespace artic
@@ -0,0 +1,216 @@
+#include "backend/html/HtmlEscape.h"
+#include <bit>
+#include <cctype>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define ARTIC_ESCAPE_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ARTIC_ESCAPE_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define ARTIC_ESCAPE_NEON 1
+#endif
+
+namespace artic {
+
+namespace {
+
+// Longest named reference in the HTML spec is "&CounterClockwiseContourIntegral;"
+constexpr size_t MAX_REFERENCE_NAME = 32;
+
+} // namespace
+
+void HtmlEscape::escape(std::string_view text, OutputSink& out, EscapeContext context, EntityMode entities) {
+    size_t pos = findSpecial(text, 0, context);
+
+    // Common case: nothing to escape, one bulk copy
+    if (pos == text.size()) {
+        out.append(text);
+        return;
+    }
+
+    size_t start = 0;
+    while (pos < text.size()) {
+        out.write(text.data() + start, pos - start);
+
+        char c = text[pos];
+        if (c == '&' && entities == EntityMode::Preserve && isCharacterReference(text, pos)) {
+            out.append('&');
+        } else {
+            out.append(entityFor(c));
+        }
+
+        start = pos + 1;
+        pos = findSpecial(text, start, context);
+    }
+
+    out.write(text.data() + start, text.size() - start);
+}
+
+std::string HtmlEscape::escape(std::string_view text, EscapeContext context, EntityMode entities) {
+    StringSink out(text.size() + text.size() / 8);
+    escape(text, out, context, entities);
+    return out.take();
+}
+
+size_t HtmlEscape::findSpecial(std::string_view text, size_t from, EscapeContext context) {
+    const char* data = text.data();
+    const size_t size = text.size();
+    const bool attribute = context == EscapeContext::Attribute;
+    size_t i = from;
+
+#if defined(ARTIC_ESCAPE_AVX2)
+    const __m256i amp = _mm256_set1_epi8('&');
+    const __m256i lt = _mm256_set1_epi8('<');
+    const __m256i gt = _mm256_set1_epi8('>');
+    const __m256i quot = _mm256_set1_epi8('"');
+    const __m256i apos = _mm256_set1_epi8('\'');
+
+    for (; i + 32 <= size; i += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i hits = _mm256_or_si256(_mm256_cmpeq_epi8(block, amp),
+                                       _mm256_or_si256(_mm256_cmpeq_epi8(block, lt),
+                                                       _mm256_cmpeq_epi8(block, gt)));
+        if (attribute) {
+            hits = _mm256_or_si256(hits, _mm256_or_si256(_mm256_cmpeq_epi8(block, quot),
+                                                         _mm256_cmpeq_epi8(block, apos)));
+        }
+
+        auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(hits));
+        if (mask != 0) {
+            return i + static_cast<size_t>(std::countr_zero(mask));
+        }
+    }
+#elif defined(ARTIC_ESCAPE_SSE2)
+    const __m128i amp = _mm_set1_epi8('&');
+    const __m128i lt = _mm_set1_epi8('<');
+    const __m128i gt = _mm_set1_epi8('>');
+    const __m128i quot = _mm_set1_epi8('"');
+    const __m128i apos = _mm_set1_epi8('\'');
+
+    for (; i + 16 <= size; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(block, amp),
+                                    _mm_or_si128(_mm_cmpeq_epi8(block, lt),
+                                                 _mm_cmpeq_epi8(block, gt)));
+        if (attribute) {
+            hits = _mm_or_si128(hits, _mm_or_si128(_mm_cmpeq_epi8(block, quot),
+                                                   _mm_cmpeq_epi8(block, apos)));
+        }
+
+        auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(hits));
+        if (mask != 0) {
+            return i + static_cast<size_t>(std::countr_zero(mask));
+        }
+    }
+#elif defined(ARTIC_ESCAPE_NEON)
+    const uint8x16_t amp = vdupq_n_u8('&');
+    const uint8x16_t lt = vdupq_n_u8('<');
+    const uint8x16_t gt = vdupq_n_u8('>');
+    const uint8x16_t quot = vdupq_n_u8('"');
+    const uint8x16_t apos = vdupq_n_u8('\'');
+
+    for (; i + 16 <= size; i += 16) {
+        uint8x16_t block = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
+        uint8x16_t hits = vorrq_u8(vceqq_u8(block, amp), vorrq_u8(vceqq_u8(block, lt), vceqq_u8(block, gt)));
+        if (attribute) {
+            hits = vorrq_u8(hits, vorrq_u8(vceqq_u8(block, quot), vceqq_u8(block, apos)));
+        }
+
+        // No movemask on NEON: detect a hit, then locate it within the block
+        if (vmaxvq_u8(hits) != 0) {
+            return findSpecialScalar(text, i, context);
+        }
+    }
+#endif
+
+    // Tail shorter than one vector (or the whole scan without SIMD)
+    return findSpecialScalar(text, i, context);
+}
+
+size_t HtmlEscape::findSpecialScalar(std::string_view text, size_t from, EscapeContext context) {
+    for (size_t i = from; i < text.size(); i++) {
+        if (isSpecial(text[i], context)) {
+            return i;
+        }
+    }
+    return text.size();
+}
+
+bool HtmlEscape::isCharacterReference(std::string_view text, size_t pos) {
+    if (pos >= text.size() || text[pos] != '&') {
+        return false;
+    }
+
+    size_t i = pos + 1;
+
+    // Numeric: &#169; or &#xA9;
+    if (i < text.size() && text[i] == '#') {
+        i++;
+        bool hex = i < text.size() && (text[i] == 'x' || text[i] == 'X');
+        if (hex) {
+            i++;
+        }
+
+        size_t digitsStart = i;
+        while (i < text.size() && i - digitsStart < 8 &&
+               (hex ? std::isxdigit(static_cast<unsigned char>(text[i]))
+                    : std::isdigit(static_cast<unsigned char>(text[i])))) {
+            i++;
+        }
+        return i > digitsStart && i < text.size() && text[i] == ';';
+    }
+
+    // Named: &copy;
+    if (i >= text.size() || !std::isalpha(static_cast<unsigned char>(text[i]))) {
+        return false;
+    }
+
+    size_t nameStart = i;
+    while (i < text.size() && i - nameStart < MAX_REFERENCE_NAME &&
+           std::isalnum(static_cast<unsigned char>(text[i]))) {
+        i++;
+    }
+    return i < text.size() && text[i] == ';';
+}
+
+const char* HtmlEscape::kernelName() {
+#if defined(ARTIC_ESCAPE_AVX2)
+    return "avx2";
+#elif defined(ARTIC_ESCAPE_SSE2)
+    return "sse2";
+#elif defined(ARTIC_ESCAPE_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+bool HtmlEscape::isSpecial(char c, EscapeContext context) {
+    switch (c) {
+        case '&':
+        case '<':
+        case '>':
+            return true;
+        case '"':
+        case '\'':
+            return context == EscapeContext::Attribute;
+        default:
+            return false;
+    }
+}
+
+std::string_view HtmlEscape::entityFor(char c) {
+    switch (c) {
+        case '&': return "&amp;";
+        case '<': return "&lt;";
+        case '>': return "&gt;";
+        case '"': return "&quot;";
+        case '\'': return "&#39;";
+        default: return {};
+    }
+}
+
+} // namespace artic
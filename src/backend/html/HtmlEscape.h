@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "shared/utils/OutputSink.h"
+
+namespace artic {
+
+/**
+ * @brief Where escaped text ends up, which decides the characters to replace
+ */
+enum class EscapeContext : std::uint8_t {
+    Text,       // Element content: & < >
+    Attribute   // Quoted attribute value: & < > " '
+};
+
+/**
+ * @brief How an '&' that already starts a character reference is handled
+ */
+enum class EntityMode : std::uint8_t {
+    Escape,     // Always "&amp;" (untrusted data)
+    Preserve    // Keep "&amp;", "&#169;", "&copy;" as written (template source)
+};
+
+/**
+ * @brief HTML escaping for text and attribute contexts
+ *
+ * Scans 16 bytes at a time (32 with AVX2) for characters that need an
+ * entity and bulk-copies the clean runs in between, so text without
+ * special characters costs one vector compare per block plus a memcpy:
+ *
+ *   "Tom & Jerry <3"  →  "Tom &amp; Jerry &lt;3"
+ *
+ * Builds without SSE2, AVX2 or NEON use a scalar scan with the same results.
+ */
+class HtmlEscape {
+public:
+    /**
+     * @brief Write text to a sink with special characters replaced by entities
+     */
+    static void escape(std::string_view text, OutputSink& out,
+                       EscapeContext context = EscapeContext::Text,
+                       EntityMode entities = EntityMode::Escape);
+
+    /**
+     * @brief Escape text into a new string
+     */
+    static std::string escape(std::string_view text,
+                              EscapeContext context = EscapeContext::Text,
+                              EntityMode entities = EntityMode::Escape);
+
+    /**
+     * @brief Offset of the first character needing escaping at or after from
+     * @return text.size() if the rest of the text is clean
+     */
+    static size_t findSpecial(std::string_view text, size_t from, EscapeContext context);
+
+    /**
+     * @brief Scalar reference implementation of findSpecial
+     */
+    static size_t findSpecialScalar(std::string_view text, size_t from, EscapeContext context);
+
+    /**
+     * @brief Check if text[pos] == '&' starts a character reference ("&amp;", "&#39;", "&#x27;")
+     */
+    static bool isCharacterReference(std::string_view text, size_t pos);
+
+    /**
+     * @brief Name of the vector kernel compiled in ("avx2", "sse2", "neon" or "scalar")
+     */
+    static const char* kernelName();
+
+private:
+    static bool isSpecial(char c, EscapeContext context);
+    static std::string_view entityFor(char c);
+};
+
+} // namespace artic
@@ -1,8 +1,14 @@
 #include "backend/html/HtmlGenerator.h"
+#include "backend/html/HtmlEscape.h"
+#include "backend/html/RenderProfile.h"
 #include "compiler/ComponentRegistry.h"
-#include <sstream>
+#include "backend/css/ClassNameMangler.h"
+#include "backend/FormatPolicy.h"
 #include <algorithm>
+#include <array>
 #include <cctype>
+#include <chrono>
+#include <cstdint>
 #include <unordered_map>
 
 namespace artic {
@@ -21,6 +27,32 @@ const std::set<std::string> HtmlGenerator::INLINE_TAGS = {
     "var", "wbr"
 };
 
+// Text content kept verbatim when minifying
+const std::set<std::string> HtmlGenerator::PREFORMATTED_TAGS = {
+    "pre", "textarea"
+};
+
+// Optional end tags (HTML Living Standard, "Optional tags"): the end tag
+// may be dropped when the next sibling is one of these elements. Whether it
+// may also be dropped at the end of the parent is decided in canOmitEndTag.
+const std::unordered_map<std::string, std::set<std::string>> HtmlGenerator::END_TAG_CLOSERS = {
+    {"li", {"li"}},
+    {"dt", {"dt", "dd"}},
+    {"dd", {"dt", "dd"}},
+    {"option", {"option", "optgroup"}},
+    {"optgroup", {"optgroup"}},
+    {"tr", {"tr"}},
+    {"td", {"td", "th"}},
+    {"th", {"td", "th"}},
+    {"thead", {"tbody", "tfoot"}},
+    {"tbody", {"tbody", "tfoot"}},
+    {"tfoot", {}},
+    {"p", {"address", "article", "aside", "blockquote", "details", "div", "dl",
+           "fieldset", "figcaption", "figure", "footer", "form", "h1", "h2", "h3",
+           "h4", "h5", "h6", "header", "hgroup", "hr", "main", "menu", "nav", "ol",
+           "p", "pre", "section", "table", "ul"}}
+};
+
 HtmlGenerator::HtmlGenerator() : m_options{}, m_registry(nullptr) {}
 
 HtmlGenerator::HtmlGenerator(const HtmlGeneratorOptions& options)
@@ -30,325 +62,896 @@ HtmlGenerator::HtmlGenerator(const HtmlGeneratorOptions& options, const Componen
     : m_options(options), m_registry(registry) {}
 
 std::string HtmlGenerator::generate(Component* component) {
+    StringSink out;
+    generate(component, out);
+    return out.take();
+}
+
+void HtmlGenerator::generate(Component* component, OutputSink& out) {
     if (!component || component->templateNodes.empty()) {
-        return "";
+        return;
     }
 
-    std::ostringstream bodyContent;
+    RenderProfile* profile = m_options.renderProfile;
+    if (profile) {
+        profile->enterRoot(out.size());
+    }
 
-    // Generate body content from template nodes
-    for (const auto& node : component->templateNodes) {
-        bodyContent << generateNode(node.get(), m_options.fullHtml ? 2 : 0);
+    generateDocumentStart(component, out);
+    execute(componentProgram(component, m_options.fullHtml ? 2 : 0), out, nullptr);
+    generateDocumentEnd(out);
+
+    if (profile) {
+        profile->leave(out.size());
+    }
+}
+
+void HtmlGenerator::generateDocumentStart(Component* component, OutputSink& out) {
+    dispatchFormat(formatMode(), [&](auto format) {
+        writeDocumentStart<decltype(format)>(component, out);
+    });
+}
+
+template <typename Format>
+void HtmlGenerator::writeDocumentStart(Component* component, OutputSink& out) {
+    constexpr std::string_view newline = Format::minify ? "" : "\n";
+
+    // DOCTYPE
+    if (m_options.includeDoctype) {
+        out << "<!DOCTYPE html>" << newline;
     }
 
-    // Generate full HTML document or just body content
-    if (m_options.fullHtml) {
-        return generateFullHtml(component, bodyContent.str());
-    } else {
-        // Legacy mode: just DOCTYPE + content
-        std::ostringstream html;
-        if (m_options.includeDoctype) {
-            html << "<!DOCTYPE html>\n";
-        }
-        html << bodyContent.str();
-        return html.str();
+    // Legacy mode: just DOCTYPE + content
+    if (!m_options.fullHtml) {
+        return;
+    }
+
+    // <html lang="...">
+    out << "<html";
+    writeAttribute<Format>(out, "lang", m_options.lang);
+    out << '>' << newline;
+
+    // <head>
+    generateHead<Format>(component, out);
+
+    // <body>
+    out << "<body>" << newline;
+}
+
+void HtmlGenerator::generateDocumentEnd(OutputSink& out) {
+    if (!m_options.fullHtml) {
+        return;
+    }
+
+    if (m_options.minify) {
+        out << "</body></html>";
+        return;
     }
+
+    out << "</body>\n";
+
+    // </html>
+    out << "</html>\n";
 }
 
 std::string HtmlGenerator::generateNode(TemplateNode* node, int indentLevel, RenderContext* context) {
+    StringSink out;
+    generateNode(node, out, indentLevel, context);
+    return out.take();
+}
+
+void HtmlGenerator::generateNode(TemplateNode* node, OutputSink& out, int indentLevel, RenderContext* context) {
     if (!node) {
-        return "";
+        return;
+    }
+
+    std::vector<TemplateNode*> nodes = {node};
+    execute(nodesProgram(nodes, indentLevel), out, context);
+}
+
+FormatMode HtmlGenerator::formatMode() const {
+    return selectFormatMode(m_options.pretty, m_options.minify);
+}
+
+// ============================================================================
+// Template programs
+// ============================================================================
+
+namespace {
+
+TemplateNode* asNode(const std::unique_ptr<TemplateNode>& node) { return node.get(); }
+TemplateNode* asNode(TemplateNode* node) { return node; }
+
+} // namespace
+
+template <typename Format, typename Nodes>
+std::unique_ptr<TemplateProgram> HtmlGenerator::compileNodes(const Nodes& nodes, int indentLevel,
+                                                             const PropsBlock* props) {
+    ProgramBuilder builder;
+    builder.setProps(props);
+    for (const auto& node : nodes) {
+        renderNode<Format>(asNode(node), builder, indentLevel);
+    }
+    return builder.finish();
+}
+
+const TemplateProgram& HtmlGenerator::componentProgram(Component* component, int indentLevel) {
+    // Indentation only affects pretty output; other modes share one program
+    ProgramKey key{component, 0, m_options.pretty && !m_options.minify ? indentLevel : 0};
+
+    auto it = m_programs.find(key);
+    if (it == m_programs.end()) {
+        auto program = dispatchFormat(formatMode(), [&](auto format) {
+            return compileNodes<decltype(format)>(component->templateNodes, indentLevel, component->props.get());
+        });
+        it = m_programs.emplace(key, std::move(program)).first;
+    }
+    return *it->second;
+}
+
+void HtmlGenerator::generatePageNode(Component* page, TemplateNode* node, OutputSink& out) {
+    auto program = dispatchFormat(formatMode(), [&](auto format) {
+        return compileNodes<decltype(format)>(std::array{node}, m_options.fullHtml ? 2 : 0, page->props.get());
+    });
+    execute(*program, out, nullptr);
+
+    // Slot list programs and fragments with slot content are keyed by node
+    // address, and the node's memory may be reused by the next one: drop
+    // them (they are rebuilt on demand)
+    std::erase_if(m_programs, [](const auto& entry) { return std::get<1>(entry.first) > 0; });
+    std::erase_if(m_fragments, [](const auto& entry) { return entry.first[0] == 'S'; });
+}
+
+const TemplateProgram& HtmlGenerator::nodesProgram(const std::vector<TemplateNode*>& nodes, int indentLevel) {
+    // A node belongs to exactly one slot list, so the first node and the
+    // count identify the list
+    ProgramKey key{nodes.front(), nodes.size(), m_options.pretty && !m_options.minify ? indentLevel : 0};
+
+    auto it = m_programs.find(key);
+    if (it == m_programs.end()) {
+        auto program = dispatchFormat(formatMode(), [&](auto format) {
+            return compileNodes<decltype(format)>(nodes, indentLevel);
+        });
+        it = m_programs.emplace(key, std::move(program)).first;
+    }
+    return *it->second;
+}
+
+void HtmlGenerator::execute(const TemplateProgram& program, OutputSink& out, RenderContext* context) {
+    // Nested components and slots push frames onto an explicit stack instead
+    // of recursing, so render depth is bounded by maxRenderDepth rather than
+    // by the size of the call stack
+    std::vector<RenderFrame> stack;
+    stack.push_back({&program, 0, &out, context, nullptr, nullptr, {}});
+
+    while (!stack.empty()) {
+        RenderFrame& frame = stack.back();
+        const auto& code = frame.program->instructions();
+
+        if (frame.pc == code.size()) {
+            finishFrame(stack);
+            continue;
+        }
+
+        const TemplateInstruction& instruction = code[frame.pc++];
+
+        // Slot and Component may push a frame (invalidates `frame`)
+        switch (instruction.op) {
+            case TemplateOp::Static:
+                frame.out->append(frame.program->chunk(instruction));
+                break;
+
+            case TemplateOp::Expression:
+                executeExpression(*frame.program, instruction, *frame.out, frame.context);
+                break;
+
+            case TemplateOp::Slot:
+                executeSlot(instruction, stack);
+                break;
+
+            case TemplateOp::Component:
+                executeComponent(instruction, stack);
+                break;
+        }
+    }
+}
+
+void HtmlGenerator::pushFrame(std::vector<RenderFrame>& stack, RenderFrame frame, const std::string& what) {
+    if (stack.size() >= m_options.maxRenderDepth) {
+        throw RenderError("Render depth exceeds the maximum of " + std::to_string(m_options.maxRenderDepth) +
+                          " while expanding " + what + " (recursive component?)");
+    }
+    stack.push_back(std::move(frame));
+}
+
+void HtmlGenerator::finishFrame(std::vector<RenderFrame>& stack) {
+    RenderFrame frame = std::move(stack.back());
+    stack.pop_back();
+
+    if (frame.profiled) {
+        m_options.renderProfile->leave(frame.out->size());
+    }
+
+    // Fragment rendered for the cache: store it and pass it on to the caller
+    if (frame.fragment) {
+        stack.back().out->append(frame.fragment->str());
+        m_fragments.emplace(std::move(frame.fragmentKey), frame.fragment->take());
+    }
+}
+
+void HtmlGenerator::executeExpression(const TemplateProgram& program, const TemplateInstruction& instruction,
+                                      OutputSink& out, RenderContext* context) {
+    if (instruction.expression) {
+        auto value = instruction.expression->evaluate([&](const std::string& name) {
+            return propValue(program.props(), context, name);
+        });
+        if (value) {
+            HtmlEscape::escape(value->toString(), out, EscapeContext::Text, EntityMode::Preserve);
+            return;
+        }
+    }
+
+    // Unknown prop or unsupported syntax: render the fallback comment
+    out.append(program.chunk(instruction));
+}
+
+std::optional<ExpressionValue> HtmlGenerator::propValue(const PropsBlock* props, const RenderContext* context,
+                                                        const std::string& name) {
+    const PropDeclaration* declaration = nullptr;
+    if (props) {
+        for (const auto& prop : props->props) {
+            if (prop->name == name) {
+                declaration = prop.get();
+                break;
+            }
+        }
+    }
+
+    // Attribute values are strings; the declared type decides how they compute
+    auto typed = [&](const std::string& raw) {
+        std::string type = declaration && declaration->type ? declaration->type->typeString : "";
+        if (type == "number") {
+            auto number = ExpressionValue::string(raw).toNumber();
+            if (number) {
+                return ExpressionValue::number(*number);
+            }
+        } else if (type == "boolean" || type == "bool") {
+            // <Toggle on /> and <Toggle on="true" /> are both true
+            return ExpressionValue::boolean(raw != "false");
+        }
+        return ExpressionValue::string(raw);
+    };
+
+    if (context) {
+        auto it = context->props.find(name);
+        if (it != context->props.end()) {
+            return typed(it->second);
+        }
+    }
+
+    if (declaration && !declaration->defaultValue.empty()) {
+        return typed(declaration->defaultValue);
+    }
+
+    return std::nullopt;
+}
+
+void HtmlGenerator::executeSlot(const TemplateInstruction& instruction, std::vector<RenderFrame>& stack) {
+    OutputSink* out = stack.back().out;
+    RenderContext* context = stack.back().context;
+
+    // If we have a context, try to replace slot with actual content
+    if (context) {
+        std::vector<TemplateNode*>* slotContent = nullptr;
+
+        if (!instruction.name.empty()) {
+            // Named slot: look for content marked with slot:name
+            auto it = context->slots.find(instruction.name);
+            if (it != context->slots.end()) {
+                slotContent = &it->second;
+            }
+        } else if (!context->defaultSlot.empty()) {
+            // Default slot: use unnamed children
+            slotContent = &context->defaultSlot;
+        }
+
+        // If we found slot content, render it
+        if (slotContent && !slotContent->empty()) {
+            // Don't pass context to slot content
+            const TemplateProgram& program = nodesProgram(*slotContent, instruction.indentLevel);
+            pushFrame(stack, {&program, 0, out, nullptr, nullptr, nullptr, {}}, "slot content");
+            return;
+        }
+    }
+
+    // No slot content found: fallback (or debug comment) with the same context
+    pushFrame(stack, {instruction.fallback.get(), 0, out, context, nullptr, nullptr, {}}, "slot fallback");
+}
+
+void HtmlGenerator::executeComponent(const TemplateInstruction& instruction, std::vector<RenderFrame>& stack) {
+    const TemplateProgram& program = componentProgram(instruction.component, instruction.indentLevel);
+    const Element* element = instruction.element;
+    OutputSink* out = stack.back().out;
+    m_componentExpansions++;
+
+    // Templates without props or slots render the same for every use site
+    if (!program.usesContext()) {
+        pushComponentFrame(stack, {&program, 0, out, nullptr, nullptr, nullptr, {}}, instruction);
+        return;
+    }
+
+    // Create render context with props and slots
+    auto context = std::make_unique<RenderContext>();
+
+    // 1. Extract props from attributes
+    for (const auto& attr : element->attributes) {
+        context->props[attr->name] = attr->value;
+    }
+
+    // 2. Extract slots from children
+    for (const auto& child : element->children) {
+        // Check if child is an element with slot:name directive
+        if (child->type == ASTNodeType::ELEMENT) {
+            Element* childElement = static_cast<Element*>(child.get());
+            if (childElement->slotDirective) {
+                // Named slot
+                std::string slotName = childElement->slotDirective->slotName;
+                context->slots[slotName].push_back(child.get());
+                continue;
+            }
+        }
+
+        // Default slot (no slot: directive)
+        context->defaultSlot.push_back(child.get());
+    }
+
+    RenderContext* contextPtr = context.get();
+
+    // 3. Render component's program with context
+    if (!m_options.cacheFragments) {
+        pushComponentFrame(stack, {&program, 0, out, contextPtr, std::move(context), nullptr, {}}, instruction);
+        return;
+    }
+
+    std::string key = fragmentKey(instruction.component, *contextPtr, instruction.indentLevel);
+
+    auto it = m_fragments.find(key);
+    if (it != m_fragments.end()) {
+        m_fragmentHits++;
+        auto start = std::chrono::steady_clock::now();
+        out->append(it->second);
+        if (m_options.renderProfile) {
+            m_options.renderProfile->cached(element->tagName, element->location, it->second.size(),
+                                            std::chrono::steady_clock::now() - start);
+        }
+        return;
+    }
+
+    m_fragmentMisses++;
+
+    // Render into a fragment; finishFrame() caches it and copies it to out
+    auto fragment = std::make_unique<StringSink>();
+    OutputSink* fragmentOut = fragment.get();
+    pushComponentFrame(stack,
+                       {&program, 0, fragmentOut, contextPtr, std::move(context), std::move(fragment), std::move(key)},
+                       instruction);
+}
+
+void HtmlGenerator::pushComponentFrame(std::vector<RenderFrame>& stack, RenderFrame frame,
+                                       const TemplateInstruction& instruction) {
+    const Element* element = instruction.element;
+    pushFrame(stack, std::move(frame), "<" + element->tagName + ">");
+
+    if (m_options.renderProfile) {
+        m_options.renderProfile->enter(element->tagName, element->location, stack.back().out->size());
+        stack.back().profiled = true;
+    }
+}
+
+std::string HtmlGenerator::fragmentKey(Component* componentDef, const RenderContext& context, int indentLevel) const {
+    // Key: component identity + indentation (pretty only) + props + slot content.
+    // Pretty fragments embed absolute indentation, so each depth is cached
+    // separately; compact and minified fragments are depth-independent.
+    // Slot content renders without a context, so its nodes identify it: the
+    // key names them by address, like ProgramKey, instead of serializing
+    // them. Keys of fragments with slot content start with 'S'.
+    bool hasSlots = !context.defaultSlot.empty() || !context.slots.empty();
+    std::string key = hasSlots ? "S" : "P";
+    appendKeyPart(key, std::to_string(reinterpret_cast<std::uintptr_t>(componentDef)));
+    appendKeyPart(key, std::to_string(m_options.pretty && !m_options.minify ? indentLevel : 0));
+
+    std::vector<const std::pair<const std::string, std::string>*> props;
+    props.reserve(context.props.size());
+    for (const auto& prop : context.props) {
+        props.push_back(&prop);
+    }
+    std::sort(props.begin(), props.end(), [](const auto* a, const auto* b) { return a->first < b->first; });
+    for (const auto* prop : props) {
+        appendKeyPart(key, prop->first);
+        appendKeyPart(key, prop->second);
+    }
+
+    std::vector<const std::pair<const std::string, std::vector<TemplateNode*>>*> slots;
+    slots.reserve(context.slots.size());
+    for (const auto& slot : context.slots) {
+        slots.push_back(&slot);
+    }
+    std::sort(slots.begin(), slots.end(), [](const auto* a, const auto* b) { return a->first < b->first; });
+    for (const auto* slot : slots) {
+        appendKeyPart(key, slot->first);
+        appendNodesKey(key, slot->second);
+    }
+
+    key += '|';
+    appendNodesKey(key, context.defaultSlot);
+
+    return key;
+}
+
+HtmlGenerator::FragmentCacheStats HtmlGenerator::fragmentCacheStats() const {
+    return {m_fragmentHits, m_fragmentMisses, m_fragments.size()};
+}
+
+// ============================================================================
+// Template compilation (AST → TemplateProgram)
+// ============================================================================
+
+template <typename Format>
+void HtmlGenerator::renderNode(TemplateNode* node, ProgramBuilder& out, int indentLevel) {
+    if (!node) {
+        return;
     }
 
     // Dispatch based on node type
     switch (node->type) {
         case ASTNodeType::ELEMENT:
-            return generateElement(static_cast<Element*>(node), indentLevel, context);
+            generateElement<Format>(static_cast<Element*>(node), out, indentLevel);
+            break;
 
         case ASTNodeType::TEXT_NODE:
-            return generateTextNode(static_cast<TextNode*>(node), indentLevel, context);
+            generateTextNode<Format>(static_cast<TextNode*>(node), out, indentLevel);
+            break;
 
         case ASTNodeType::EXPRESSION_NODE:
-            return generateExpressionNode(static_cast<ExpressionNode*>(node), indentLevel, context);
+            generateExpressionNode<Format>(static_cast<ExpressionNode*>(node), out, indentLevel);
+            break;
 
         case ASTNodeType::COMMENT_NODE:
-            return generateCommentNode(static_cast<CommentNode*>(node), indentLevel, context);
+            generateCommentNode<Format>(static_cast<CommentNode*>(node), out, indentLevel);
+            break;
 
         case ASTNodeType::SLOT_NODE:
-            return generateSlotNode(static_cast<SlotNode*>(node), indentLevel, context);
+            generateSlotNode<Format>(static_cast<SlotNode*>(node), out, indentLevel);
+            break;
 
         default:
-            return "";
+            break;
     }
 }
 
-std::string HtmlGenerator::generateElement(Element* element, int indentLevel, RenderContext* context) {
+template <typename Format>
+void HtmlGenerator::generateElement(Element* element, ProgramBuilder& out, int indentLevel, bool omitEndTag) {
     if (!element) {
-        return "";
+        return;
+    }
+
+    // Descendant elements are compiled with an explicit stack (one frame per
+    // open element) rather than recursion, so nesting depth costs heap, not
+    // call stack
+    std::vector<ElementFrame> open;
+    openElement<Format>(element, out, indentLevel, omitEndTag, open);
+
+    while (!open.empty()) {
+        ElementFrame& frame = open.back();
+        Element* parent = frame.element;
+
+        if (frame.nextChild == parent->children.size()) {
+            closeElement<Format>(frame, out);
+            open.pop_back();
+            continue;
+        }
+
+        size_t index = frame.nextChild++;
+        TemplateNode* child = parent->children[index].get();
+
+        // Inline content (text nodes in inline elements) is not indented
+        int childIndent = frame.hasBlockChildren || child->type == ASTNodeType::ELEMENT ? frame.indentLevel + 1 : 0;
+
+        if (child->type == ASTNodeType::ELEMENT) {
+            // May push a frame (invalidates `frame`)
+            bool omitChildEndTag = Format::minify && canOmitEndTag(parent, index);
+            openElement<Format>(static_cast<Element*>(child), out, childIndent, omitChildEndTag, open);
+        } else if (Format::minify && child->type == ASTNodeType::TEXT_NODE) {
+            // Minified text needs its siblings to know which whitespace matters
+            const TemplateNode* prev = index > 0 ? parent->children[index - 1].get() : nullptr;
+            const TemplateNode* next = index + 1 < parent->children.size() ? parent->children[index + 1].get() : nullptr;
+            generateTextNode<Format>(static_cast<TextNode*>(child), out, childIndent,
+                                     isTextBoundary(prev), isTextBoundary(next));
+        } else {
+            renderNode<Format>(child, out, childIndent);
+        }
     }
+}
 
+template <typename Format>
+void HtmlGenerator::openElement(Element* element, ProgramBuilder& out, int indentLevel, bool omitEndTag,
+                                std::vector<ElementFrame>& open) {
     // Check if this is a custom component (starts with uppercase)
     if (isCustomComponent(element->tagName)) {
-        return expandCustomComponent(element, indentLevel);
+        expandCustomComponent<Format>(element, out, indentLevel);
+        return;
     }
 
-    std::ostringstream html;
     bool selfClosing = isSelfClosing(element->tagName);
     bool isInlineTag = isInline(element->tagName);
 
     // Opening tag
-    if (m_options.pretty && !isInlineTag) {
-        html << indent(indentLevel);
+    if (!isInlineTag) {
+        writeIndent<Format>(out, indentLevel);
     }
 
-    html << "<" << element->tagName;
+    out << '<' << element->tagName;
 
     // Attributes
-    std::string attrs = generateAttributes(element);
-    if (!attrs.empty()) {
-        html << " " << attrs;
-    }
+    generateAttributes<Format>(element, out);
 
     if (selfClosing) {
-        // Self-closing tag: <img src="..." />
-        html << " />";
-        if (m_options.pretty && !isInlineTag) {
-            html << "\n";
+        // Self-closing tag: <img src="..." /> (minified: <img src=...>)
+        if constexpr (Format::minify) {
+            out << '>';
+            return;
+        }
+        out << " />";
+        if (Format::pretty && !isInlineTag) {
+            out << '\n';
         }
-        return html.str();
+        return;
     }
 
-    html << ">";
+    out << '>';
 
-    // Children
-    if (!element->children.empty()) {
-        bool hasBlockChildren = false;
-
-        // Check if we have block-level children
-        for (const auto& child : element->children) {
-            if (child->type == ASTNodeType::ELEMENT) {
-                auto* childElem = static_cast<Element*>(child.get());
-                if (!isInline(childElem->tagName)) {
-                    hasBlockChildren = true;
-                    break;
-                }
+    // Check if we have block-level children
+    bool hasBlockChildren = false;
+    for (const auto& child : element->children) {
+        if (child->type == ASTNodeType::ELEMENT) {
+            auto* childElem = static_cast<Element*>(child.get());
+            if (!isInline(childElem->tagName)) {
+                hasBlockChildren = true;
+                break;
             }
         }
+    }
+
+    // Add newline after opening tag if we have block children
+    if (Format::pretty && hasBlockChildren && !isInlineTag) {
+        out << '\n';
+    }
 
-        // Add newline after opening tag if we have block children
-        if (m_options.pretty && hasBlockChildren && !isInlineTag) {
-            html << "\n";
+    bool preformatted = Format::minify && PREFORMATTED_TAGS.count(element->tagName) > 0;
+    m_preformattedDepth += preformatted;
+
+    open.push_back({element, indentLevel, omitEndTag, hasBlockChildren, preformatted, 0});
+}
+
+template <typename Format>
+void HtmlGenerator::closeElement(const ElementFrame& frame, ProgramBuilder& out) {
+    const Element* element = frame.element;
+    bool isInlineTag = isInline(element->tagName);
+
+    m_preformattedDepth -= frame.preformatted;
+
+    // Add indent before closing tag if we have block children
+    if (frame.hasBlockChildren && !isInlineTag) {
+        writeIndent<Format>(out, frame.indentLevel);
+    }
+
+    // Closing tag
+    if constexpr (Format::minify) {
+        if (frame.omitEndTag && m_options.omitOptionalTags) {
+            return;
         }
+    }
 
-        // Generate children
-        for (const auto& child : element->children) {
-            if (hasBlockChildren || child->type == ASTNodeType::ELEMENT) {
-                html << generateNode(child.get(), indentLevel + 1, context);
-            } else {
-                // Inline content (text nodes in inline elements)
-                html << generateNode(child.get(), 0, context);
-            }
+    out << "</" << element->tagName << '>';
+
+    if (Format::pretty && !isInlineTag) {
+        out << '\n';
+    }
+}
+
+bool HtmlGenerator::isTextBoundary(const TemplateNode* sibling) const {
+    // Whitespace next to the parent's edges or a block element is not rendered
+    if (!sibling) {
+        return true;
+    }
+    if (sibling->type != ASTNodeType::ELEMENT) {
+        return false;
+    }
+
+    const auto& tagName = static_cast<const Element*>(sibling)->tagName;
+    if (!isCustomComponent(tagName)) {
+        return !isInline(tagName);
+    }
+
+    // A component is a boundary when its template renders only block elements
+    Component* component = m_registry ? m_registry->getComponent(tagName) : nullptr;
+    if (!component) {
+        return false;
+    }
+
+    for (const auto& node : component->templateNodes) {
+        if (node->type == ASTNodeType::TEXT_NODE &&
+            static_cast<const TextNode*>(node.get())->text.find_first_not_of(" \t\n\r\f") == std::string::npos) {
+            continue;
         }
+        if (node->type != ASTNodeType::ELEMENT) {
+            return false;
+        }
+        const auto& rootTag = static_cast<const Element*>(node.get())->tagName;
+        if (isInline(rootTag) || isCustomComponent(rootTag)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool HtmlGenerator::canOmitEndTag(const Element* parent, size_t index) const {
+    const auto* element = static_cast<const Element*>(parent->children[index].get());
 
-        // Add indent before closing tag if we have block children
-        if (m_options.pretty && hasBlockChildren && !isInlineTag) {
-            html << indent(indentLevel);
+    auto closers = END_TAG_CLOSERS.find(element->tagName);
+    if (closers == END_TAG_CLOSERS.end()) {
+        return false;
+    }
+
+    // Whitespace-only text next to these (block) elements is dropped when
+    // minifying, so it does not separate the element from what follows
+    while (index + 1 < parent->children.size()) {
+        const TemplateNode* next = parent->children[index + 1].get();
+        if (next->type != ASTNodeType::TEXT_NODE ||
+            static_cast<const TextNode*>(next)->text.find_first_not_of(" \t\n\r\f") != std::string::npos) {
+            break;
         }
+        index++;
     }
 
-    // Closing tag
-    html << "</" << element->tagName << ">";
+    // Last child: the parent's end tag closes it too, except <dt>/<thead>,
+    // which always need a following sibling, and <p> inside elements whose
+    // content model is transparent
+    if (index + 1 == parent->children.size()) {
+        if (element->tagName == "dt" || element->tagName == "thead") {
+            return false;
+        }
+        if (element->tagName == "p") {
+            static const std::set<std::string> transparentParents = {
+                "a", "audio", "del", "ins", "map", "noscript", "video"
+            };
+            return transparentParents.count(parent->tagName) == 0;
+        }
+        return true;
+    }
 
-    if (m_options.pretty && !isInlineTag) {
-        html << "\n";
+    // Otherwise the next sibling must be an element that implies the end tag
+    // (components may expand to anything, so they never do)
+    const TemplateNode* next = parent->children[index + 1].get();
+    if (next->type != ASTNodeType::ELEMENT) {
+        return false;
     }
 
-    return html.str();
+    const auto& nextTag = static_cast<const Element*>(next)->tagName;
+    return !isCustomComponent(nextTag) && closers->second.count(nextTag) > 0;
 }
 
-std::string HtmlGenerator::generateTextNode(TextNode* textNode, int indentLevel, RenderContext* context) {
+template <typename Format>
+void HtmlGenerator::generateTextNode(TextNode* textNode, ProgramBuilder& out, int /*indentLevel*/,
+                                     bool trimLeading, bool trimTrailing) {
     if (!textNode || textNode->text.empty()) {
-        return "";
+        return;
     }
 
-    // Trim whitespace if minifying
-    if (m_options.minify) {
-        std::string content = textNode->text;
-        // Remove leading/trailing whitespace
-        content.erase(0, content.find_first_not_of(" \t\n\r"));
-        content.erase(content.find_last_not_of(" \t\n\r") + 1);
-        return content;
+    std::string_view content = textNode->text;
+
+    // Minify: collapse whitespace runs to one space, and drop it entirely
+    // at block boundaries (next to inline content it is significant)
+    std::string collapsed;
+    if constexpr (Format::minify) {
+        if (m_preformattedDepth == 0) {
+            collapsed.reserve(content.size());
+            bool pendingSpace = false;
+            for (char c : content) {
+                if (c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f') {
+                    pendingSpace = true;
+                    continue;
+                }
+                if (pendingSpace && (!collapsed.empty() || !trimLeading)) {
+                    collapsed += ' ';
+                }
+                pendingSpace = false;
+                collapsed += c;
+            }
+            if (pendingSpace && !trimTrailing && !(collapsed.empty() && trimLeading)) {
+                collapsed += ' ';
+            }
+            content = collapsed;
+        }
     }
 
-    return textNode->text;
+    // Escaped once here; the program then copies the result as a static chunk
+    HtmlEscape::escape(content, out, EscapeContext::Text, EntityMode::Preserve);
 }
 
-std::string HtmlGenerator::generateExpressionNode(ExpressionNode* exprNode, int indentLevel, RenderContext* context) {
+template <typename Format>
+void HtmlGenerator::generateExpressionNode(ExpressionNode* exprNode, ProgramBuilder& out, int /*indentLevel*/) {
     if (!exprNode) {
-        return "";
+        return;
     }
 
-    // If we have a context with props, try to evaluate simple prop references
-    if (context && !context->props.empty()) {
-        std::string expr = exprNode->expression;
-
-        // Simple case: {propName} or {props.propName}
-        // Remove whitespace
-        expr.erase(std::remove_if(expr.begin(), expr.end(), ::isspace), expr.end());
+    auto expression = TemplateExpression::compile(exprNode->expression);
 
-        // Check if it's a simple prop reference
-        auto it = context->props.find(expr);
-        if (it != context->props.end()) {
-            return it->second;
+    // No props involved ({"©" + " 2024"}, {2 * 60}): fold into static text
+    if (expression && expression->isConstant()) {
+        auto value = expression->evaluate(nullptr);
+        if (value) {
+            HtmlEscape::escape(value->toString(), out, EscapeContext::Text, EntityMode::Preserve);
+            return;
         }
     }
 
-    // Phase 1 (SSG): Expressions are not evaluated, render as comment
-    std::ostringstream html;
+    // Rendered when the expression cannot be evaluated (minified output
+    // drops the placeholder)
+    std::string fallback;
+    if constexpr (Format::pretty) {
+        fallback = "<!-- Expression: {" + exprNode->expression + "} -->";
+    } else if constexpr (!Format::minify) {
+        fallback = "<!--{" + exprNode->expression + "}-->";
+    }
 
-    if (m_options.pretty) {
-        html << "<!-- Expression: {" << exprNode->expression << "} -->";
-    } else {
-        html << "<!--{" << exprNode->expression << "}-->";
+    // {propName} and {props.propName} keep the name for SSR code generation
+    std::string propName;
+    if (expression && expression->simpleReference()) {
+        propName = *expression->simpleReference();
     }
 
-    return html.str();
+    out.addExpression(std::move(propName), fallback, std::move(expression));
 }
 
-std::string HtmlGenerator::generateCommentNode(CommentNode* commentNode, int indentLevel, RenderContext* context) {
+template <typename Format>
+void HtmlGenerator::generateCommentNode(CommentNode* commentNode, ProgramBuilder& out, int indentLevel) {
     if (!commentNode) {
-        return "";
+        return;
     }
 
-    std::ostringstream html;
-
-    if (m_options.pretty) {
-        html << indent(indentLevel);
+    // Source comments are for template authors, not for the page
+    if constexpr (Format::minify) {
+        return;
     }
 
-    html << "<!-- " << commentNode->comment << " -->";
+    writeIndent<Format>(out, indentLevel);
+    out << "<!-- " << commentNode->comment << " -->";
 
-    if (m_options.pretty) {
-        html << "\n";
+    if constexpr (Format::pretty) {
+        out << '\n';
     }
-
-    return html.str();
 }
 
-std::string HtmlGenerator::generateSlotNode(SlotNode* slotNode, int indentLevel, RenderContext* context) {
+template <typename Format>
+void HtmlGenerator::generateSlotNode(SlotNode* slotNode, ProgramBuilder& out, int indentLevel) {
     if (!slotNode) {
-        return "";
+        return;
     }
 
-    std::ostringstream html;
+    ProgramBuilder fallback;
 
-    // If we have a context, try to replace slot with actual content
-    if (context) {
-        std::vector<TemplateNode*>* slotContent = nullptr;
-
-        if (slotNode->hasName()) {
-            // Named slot: look for content marked with slot:name
-            auto it = context->slots.find(slotNode->name);
-            if (it != context->slots.end()) {
-                slotContent = &it->second;
-            }
-        } else {
-            // Default slot: use unnamed children
-            if (!context->defaultSlot.empty()) {
-                slotContent = &context->defaultSlot;
-            }
-        }
-
-        // If we found slot content, render it
-        if (slotContent && !slotContent->empty()) {
-            for (auto* node : *slotContent) {
-                html << generateNode(node, indentLevel, nullptr);  // Don't pass context to slot content
-            }
-            return html.str();
-        }
-    }
-
-    // No slot content found, use fallback if available
     if (slotNode->hasFallback()) {
+        // Fallback content, rendered when the caller passes nothing
         for (const auto& child : slotNode->fallback) {
-            html << generateNode(child.get(), indentLevel, context);
+            renderNode<Format>(child.get(), fallback, indentLevel);
         }
-        return html.str();
-    }
-
-    // No content and no fallback: render comment for debugging
-    if (m_options.pretty) {
-        html << indent(indentLevel);
+    } else if constexpr (Format::pretty) {
+        // No content and no fallback: render comment for debugging
+        writeIndent<Format>(fallback, indentLevel);
         if (slotNode->hasName()) {
-            html << "<!-- <slot:" << slotNode->name << " /> -->";
+            fallback << "<!-- <slot:" << slotNode->name << " /> -->";
         } else {
-            html << "<!-- <slot /> -->";
+            fallback << "<!-- <slot /> -->";
         }
-        html << "\n";
+        fallback << '\n';
     }
 
-    return html.str();
+    out.addSlot(slotNode->name, indentLevel, fallback.finish());
 }
 
-std::string HtmlGenerator::generateAttributes(Element* element) {
+template <typename Format>
+void HtmlGenerator::generateAttributes(Element* element, OutputSink& out) {
     if (!element) {
-        return "";
+        return;
     }
 
-    std::ostringstream attrs;
-    bool first = true;
-
     // Regular attributes
     for (const auto& attr : element->attributes) {
-        if (!first) {
-            attrs << " ";
-        }
-        attrs << attr->name;
-        if (!attr->value.empty()) {
-            attrs << "=\"" << attr->value << "\"";
+        if (m_options.classMangler && attr->name == "class" && !attr->isDynamic) {
+            writeAttribute<Format>(out, attr->name, m_options.classMangler->mangleClassList(attr->value));
+            continue;
         }
-        first = false;
+        writeAttribute<Format>(out, attr->name, attr->value);
     }
 
     // Class directives: class:(container btn)
     if (!element->classDirectives.empty()) {
-        if (!first) {
-            attrs << " ";
-        }
-        attrs << "class=\"";
-
         // Concatenate all class directives
+        StringSink classes;
         bool firstDir = true;
         for (const auto& directive : element->classDirectives) {
             if (!firstDir) {
-                attrs << " ";
+                classes << ' ';
             }
-            attrs << generateClassDirective(directive.get());
+            generateClassDirective(directive.get(), classes);
             firstDir = false;
         }
 
-        attrs << "\"";
-        first = false;
+        out << " class=";
+        if (Format::minify && m_options.removeAttributeQuotes && !needsAttributeQuotes(classes.str())) {
+            HtmlEscape::escape(classes.str(), out, EscapeContext::Attribute);
+        } else {
+            out << '"';
+            HtmlEscape::escape(classes.str(), out, EscapeContext::Attribute);
+            out << '"';
+        }
+    }
+}
+
+template <typename Format>
+void HtmlGenerator::writeAttribute(OutputSink& out, std::string_view name, std::string_view value) {
+    out << ' ' << name;
+    if (value.empty()) {
+        return;
     }
 
-    return attrs.str();
+    out << '=';
+    if constexpr (Format::minify) {
+        if (m_options.removeAttributeQuotes && !needsAttributeQuotes(value)) {
+            HtmlEscape::escape(value, out, EscapeContext::Attribute, EntityMode::Preserve);
+            return;
+        }
+    }
+
+    out << '"';
+    HtmlEscape::escape(value, out, EscapeContext::Attribute, EntityMode::Preserve);
+    out << '"';
+}
+
+bool HtmlGenerator::needsAttributeQuotes(std::string_view value) {
+    // Unquoted attribute value syntax: non-empty, none of these characters
+    if (value.empty()) {
+        return true;
+    }
+    return value.find_first_of(" \t\n\r\f\"'=<>`") != std::string_view::npos;
 }
 
-std::string HtmlGenerator::generateClassDirective(ClassDirective* classDir) {
+void HtmlGenerator::generateClassDirective(ClassDirective* classDir, OutputSink& out) {
     if (!classDir || classDir->tokens.empty()) {
-        return "";
+        return;
     }
 
     // tokens is already a space-separated string like "container flex center"
-    return classDir->tokens;
+    if (m_options.classMangler) {
+        out << m_options.classMangler->mangleClassList(classDir->tokens);
+        return;
+    }
+
+    out << classDir->tokens;
 }
 
-std::string HtmlGenerator::indent(int level) const {
-    if (!m_options.pretty || level <= 0) {
-        return "";
+template <typename Format>
+void HtmlGenerator::writeIndent(OutputSink& out, int level) const {
+    if constexpr (!Format::pretty) {
+        return;
+    }
+
+    if (level <= 0) {
+        return;
     }
 
-    return std::string(level * m_options.indentSize, ' ');
+    out.appendRepeated(' ', static_cast<size_t>(level * m_options.indentSize));
 }
 
 bool HtmlGenerator::isSelfClosing(const std::string& tagName) const {
@@ -359,56 +962,40 @@ bool HtmlGenerator::isInline(const std::string& tagName) const {
     return INLINE_TAGS.count(tagName) > 0;
 }
 
-std::string HtmlGenerator::generateFullHtml(Component* component, const std::string& bodyContent) {
-    std::ostringstream html;
+template <typename Format>
+void HtmlGenerator::generateHead(Component* component, OutputSink& out) {
+    constexpr std::string_view newline = Format::minify ? "" : "\n";
+    constexpr std::string_view indent = Format::minify ? "" : "  ";
 
-    // DOCTYPE
-    if (m_options.includeDoctype) {
-        html << "<!DOCTYPE html>\n";
-    }
-
-    // <html lang="...">
-    html << "<html lang=\"" << m_options.lang << "\">\n";
-
-    // <head>
-    html << generateHead(component);
-
-    // <body>
-    html << "<body>\n";
-    html << bodyContent;
-    html << "</body>\n";
-
-    // </html>
-    html << "</html>\n";
-
-    return html.str();
-}
-
-std::string HtmlGenerator::generateHead(Component* component) {
-    std::ostringstream head;
-
-    head << "<head>\n";
+    out << "<head>" << newline;
 
     // Meta charset
-    head << "  <meta charset=\"" << m_options.charset << "\">\n";
+    out << indent << "<meta";
+    writeAttribute<Format>(out, "charset", m_options.charset);
+    out << '>' << newline;
 
     // Viewport meta tag
     if (m_options.includeViewportMeta) {
-        head << "  <meta name=\"viewport\" content=\"width=device-width, initial-scale=1.0\">\n";
+        out << indent << "<meta";
+        writeAttribute<Format>(out, "name", "viewport");
+        writeAttribute<Format>(out, "content", "width=device-width, initial-scale=1.0");
+        out << '>' << newline;
     }
 
     // Title
-    std::string title = extractTitle(component);
-    head << "  <title>" << title << "</title>\n";
+    out << indent << "<title>";
+    HtmlEscape::escape(extractTitle(component), out, EscapeContext::Text, EntityMode::Preserve);
+    out << "</title>" << newline;
 
     // CSS link
     if (!m_options.cssFile.empty()) {
-        head << "  <link rel=\"stylesheet\" href=\"" << m_options.cssFile << "\">\n";
+        out << indent << "<link";
+        writeAttribute<Format>(out, "rel", "stylesheet");
+        writeAttribute<Format>(out, "href", m_options.cssFile);
+        out << '>' << newline;
     }
 
-    head << "</head>\n";
-
-    return head.str();
+    out << "</head>" << newline;
 }
 
 std::string HtmlGenerator::extractTitle(Component* component) {
@@ -450,77 +1037,65 @@ bool HtmlGenerator::isCustomComponent(const std::string& tagName) const {
     return std::isupper(tagName[0]);
 }
 
-std::string HtmlGenerator::expandCustomComponent(Element* element, int indentLevel) {
+template <typename Format>
+void HtmlGenerator::expandCustomComponent(Element* element, ProgramBuilder& out, int indentLevel) {
     if (!m_registry) {
-        std::ostringstream html;
-        if (m_options.pretty) {
-            html << indent(indentLevel);
+        if constexpr (Format::minify) {
+            return;
         }
-        html << "<!-- Custom component: <" << element->tagName << "> -->";
-        if (m_options.pretty) {
-            html << "\n";
+        writeIndent<Format>(out, indentLevel);
+        out << "<!-- Custom component: <" << element->tagName << "> -->";
+        if constexpr (Format::pretty) {
+            out << '\n';
         }
-        return html.str();
+        return;
     }
 
     // Try to find component in registry
     Component* componentDef = m_registry->getComponent(element->tagName);
 
     if (!componentDef) {
-        std::ostringstream html;
-        if (m_options.pretty) {
-            html << indent(indentLevel);
+        if constexpr (Format::minify) {
+            return;
         }
-        html << "<!-- Component not found: <" << element->tagName << "> -->";
-        if (m_options.pretty) {
-            html << "\n";
+        writeIndent<Format>(out, indentLevel);
+        out << "<!-- Component not found: <" << element->tagName << "> -->";
+        if constexpr (Format::pretty) {
+            out << '\n';
         }
-        return html.str();
+        return;
     }
 
-    // Create render context with props and slots
-    RenderContext context;
-
-    // 1. Extract props from attributes
-    for (const auto& attr : element->attributes) {
-        context.props[attr->name] = attr->value;
+    if constexpr (Format::pretty) {
+        writeIndent<Format>(out, indentLevel);
+        out << "<!-- Component: " << element->tagName << " -->\n";
     }
 
-    // 2. Extract slots from children
-    for (const auto& child : element->children) {
-        // Check if child is an element with slot:name directive
-        if (child->type == ASTNodeType::ELEMENT) {
-            Element* childElement = static_cast<Element*>(child.get());
-            if (childElement->slotDirective) {
-                // Named slot
-                std::string slotName = childElement->slotDirective->slotName;
-                context.slots[slotName].push_back(child.get());
-                continue;
-            }
-        }
-
-        // Default slot (no slot: directive)
-        context.defaultSlot.push_back(child.get());
-    }
-
-    // 3. Render component's template with context
-    std::ostringstream html;
+    // Props and slot content are bound when the program runs
+    out.addComponent(componentDef, element, indentLevel);
 
-    if (m_options.pretty) {
-        html << indent(indentLevel);
-        html << "<!-- Component: " << element->tagName << " -->\n";
+    if constexpr (Format::pretty) {
+        writeIndent<Format>(out, indentLevel);
+        out << "<!-- /" << element->tagName << " -->\n";
     }
+}
 
-    for (const auto& node : componentDef->templateNodes) {
-        html << generateNode(node.get(), indentLevel, &context);
-    }
+void HtmlGenerator::appendKeyPart(std::string& key, const std::string& part) {
+    // Length-prefixed, so concatenated parts can never be ambiguous
+    key += std::to_string(part.size());
+    key += ':';
+    key += part;
+}
 
-    if (m_options.pretty) {
-        html << indent(indentLevel);
-        html << "<!-- /" << element->tagName << " -->\n";
+void HtmlGenerator::appendNodesKey(std::string& key, const std::vector<TemplateNode*>& nodes) {
+    // A node belongs to exactly one slot list: the first node and the count
+    // identify the list (O(1) per use site, whatever the content's size)
+    key += std::to_string(nodes.size());
+    if (!nodes.empty()) {
+        key += '@';
+        key += std::to_string(reinterpret_cast<std::uintptr_t>(nodes.front()));
     }
-
-    return html.str();
+    key += ';';
 }
 
 } // namespace artic
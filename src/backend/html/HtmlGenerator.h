@@ -4,14 +4,23 @@
 #include <memory>
 #include <vector>
 #include <set>
+#include <optional>
 #include <unordered_map>
 #include "frontend/ast/Component.h"
 #include "frontend/ast/Template.h"
+#include "shared/utils/OutputSink.h"
+#include "backend/FormatPolicy.h"
+#include "backend/html/TemplateProgram.h"
+#include "backend/html/RenderError.h"
+#include <map>
+#include <tuple>
 
 namespace artic {
 
-// Forward declaration
+// Forward declarations
 class ComponentRegistry;
+class ClassNameMangler;
+class RenderProfile;
 
 /**
  * @brief Context for rendering components with props and slots
@@ -30,7 +39,7 @@ struct HtmlGeneratorOptions {
     bool pretty = true;          // Pretty print with indentation
     bool includeDoctype = true;  // Include <!DOCTYPE html>
     int indentSize = 2;          // Number of spaces per indent level
-    bool minify = false;         // Minify output HTML
+    bool minify = false;         // Minify output HTML (overrides pretty)
 
     // Full HTML document options
     bool fullHtml = true;        // Generate full HTML5 document (html, head, body)
@@ -39,6 +48,20 @@ struct HtmlGeneratorOptions {
     std::string charset = "UTF-8"; // Character encoding
     std::string cssFile = "style.css"; // CSS file to link
     bool includeViewportMeta = true; // Include viewport meta tag
+
+    // Production options
+    const ClassNameMangler* classMangler = nullptr; // Short class names (must match CSS)
+
+    // Performance options
+    bool cacheFragments = true;  // Reuse output of component uses with equal props and the same slot nodes
+    RenderProfile* renderProfile = nullptr; // Per-component render cost attribution (profiling mode)
+
+    // Safety limits
+    size_t maxRenderDepth = 1024; // Nested component/slot expansions before a RenderError
+
+    // Minification options (only apply with minify)
+    bool removeAttributeQuotes = true; // Unquote attribute values that don't need quotes
+    bool omitOptionalTags = true;      // Drop end tags the browser infers (</li>, </p>, </td>, ...)
 };
 
 /**
@@ -55,6 +78,10 @@ struct HtmlGeneratorOptions {
  * <div class="container">
  *     <h1>Hello World</h1>
  * </div>
+ *
+ * Each template is first lowered into a TemplateProgram (static chunks plus
+ * holes for props, slots and nested components) for the selected format;
+ * programs are cached per generator, so repeated renders mostly copy bytes.
  */
 class HtmlGenerator {
 public:
@@ -69,6 +96,13 @@ public:
      */
     std::string generate(Component* component);
 
+    /**
+     * @brief Generate HTML from Component AST into a sink
+     * @param component Component with template nodes
+     * @param out Destination for the generated HTML
+     */
+    void generate(Component* component, OutputSink& out);
+
     /**
      * @brief Generate HTML for a single template node
      * @param node Template node (Element, TextNode, etc.)
@@ -78,38 +112,174 @@ public:
      */
     std::string generateNode(TemplateNode* node, int indentLevel = 0, RenderContext* context = nullptr);
 
+    /**
+     * @brief Generate HTML for a single template node into a sink
+     */
+    void generateNode(TemplateNode* node, OutputSink& out, int indentLevel = 0, RenderContext* context = nullptr);
+
+    /**
+     * @brief Write everything before the page content (DOCTYPE, <head>, <body>)
+     */
+    void generateDocumentStart(Component* component, OutputSink& out);
+
+    /**
+     * @brief Write everything after the page content (</body></html>)
+     */
+    void generateDocumentEnd(OutputSink& out);
+
+    /**
+     * @brief Write one top-level node of a page whose template is streamed
+     *
+     * Calling it for each node in order between generateDocumentStart() and
+     * generateDocumentEnd() writes what generate() would. Nothing keeps a
+     * reference to the node afterwards, so the caller may free it.
+     * @param page The page (props, no template nodes needed)
+     * @param node A top-level template node of the page
+     */
+    void generatePageNode(Component* page, TemplateNode* node, OutputSink& out);
+
+    /**
+     * @brief Compiled template program for a component (compiled once, then cached)
+     * @param component Component whose template to compile
+     * @param indentLevel Base indentation (pretty output only)
+     */
+    const TemplateProgram& componentProgram(Component* component, int indentLevel = 0);
+
+    /**
+     * @brief Compiled template program for a list of nodes (e.g. slot content)
+     * @param nodes Non-empty node list
+     * @param indentLevel Base indentation (pretty output only)
+     */
+    const TemplateProgram& nodesProgram(const std::vector<TemplateNode*>& nodes, int indentLevel = 0);
+
+    /**
+     * @brief Component fragment cache statistics
+     */
+    struct FragmentCacheStats {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t entries = 0;
+    };
+
+    /**
+     * @brief Get fragment cache hits/misses since construction
+     */
+    FragmentCacheStats fragmentCacheStats() const;
+
+    /**
+     * @brief Component uses rendered since construction (cached or not)
+     */
+    size_t componentExpansions() const { return m_componentExpansions; }
+
 private:
     HtmlGeneratorOptions m_options;
     const ComponentRegistry* m_registry;
 
-    // Generate specific node types
-    std::string generateElement(Element* element, int indentLevel, RenderContext* context);
-    std::string generateTextNode(TextNode* textNode, int indentLevel, RenderContext* context);
-    std::string generateExpressionNode(ExpressionNode* exprNode, int indentLevel, RenderContext* context);
-    std::string generateCommentNode(CommentNode* commentNode, int indentLevel, RenderContext* context);
-    std::string generateSlotNode(SlotNode* slotNode, int indentLevel, RenderContext* context);
+    // Compiled template programs: (component or first slot node, node count, indent)
+    using ProgramKey = std::tuple<const void*, size_t, int>;
+    std::map<ProgramKey, std::unique_ptr<TemplateProgram>> m_programs;
+
+    // Rendered component fragments, keyed by component + props + slot content nodes
+    std::unordered_map<std::string, std::string> m_fragments;
+    size_t m_fragmentHits = 0;
+    size_t m_fragmentMisses = 0;
+    size_t m_componentExpansions = 0;
+
+    // Formatting mode selected by the options (picks the compiler instantiation)
+    FormatMode formatMode() const;
+
+    // Template compilation
+    template <typename Format, typename Nodes>
+    std::unique_ptr<TemplateProgram> compileNodes(const Nodes& nodes, int indentLevel,
+                                                  const PropsBlock* props = nullptr);
+
+    // Program being executed; nested components and slots push frames
+    struct RenderFrame {
+        const TemplateProgram* program;
+        size_t pc;                                   // Next instruction
+        OutputSink* out;
+        RenderContext* context;                      // Props and slots in scope (may be null)
+        std::unique_ptr<RenderContext> ownedContext; // Component use site context
+        std::unique_ptr<StringSink> fragment;        // Output captured for the fragment cache
+        std::string fragmentKey;
+        bool profiled = false;                       // Component expansion entered in the render profile
+    };
+
+    // Program interpreter (explicit frame stack, see execute)
+    void execute(const TemplateProgram& program, OutputSink& out, RenderContext* context);
+    void pushFrame(std::vector<RenderFrame>& stack, RenderFrame frame, const std::string& what);
+    void finishFrame(std::vector<RenderFrame>& stack);
+    void executeExpression(const TemplateProgram& program, const TemplateInstruction& instruction,
+                           OutputSink& out, RenderContext* context);
+    static std::optional<ExpressionValue> propValue(const PropsBlock* props, const RenderContext* context,
+                                                    const std::string& name);
+    void executeSlot(const TemplateInstruction& instruction, std::vector<RenderFrame>& stack);
+    void executeComponent(const TemplateInstruction& instruction, std::vector<RenderFrame>& stack);
+    void pushComponentFrame(std::vector<RenderFrame>& stack, RenderFrame frame, const TemplateInstruction& instruction);
+    std::string fragmentKey(Component* componentDef, const RenderContext& context, int indentLevel) const;
+
+    // Template compiler: lowers AST nodes into the builder, specialized per
+    // formatting policy (see FormatPolicy.h)
+    template <typename Format> void renderNode(TemplateNode* node, ProgramBuilder& out, int indentLevel);
+    template <typename Format> void generateElement(Element* element, ProgramBuilder& out, int indentLevel,
+                                                    bool omitEndTag = false);
+    template <typename Format> void generateTextNode(TextNode* textNode, ProgramBuilder& out, int indentLevel,
+                                                     bool trimLeading = true, bool trimTrailing = true);
+    template <typename Format> void generateExpressionNode(ExpressionNode* exprNode, ProgramBuilder& out, int indentLevel);
+    template <typename Format> void generateCommentNode(CommentNode* commentNode, ProgramBuilder& out, int indentLevel);
+    template <typename Format> void generateSlotNode(SlotNode* slotNode, ProgramBuilder& out, int indentLevel);
 
     // Component expansion
-    std::string expandCustomComponent(Element* element, int indentLevel);
+    template <typename Format> void expandCustomComponent(Element* element, ProgramBuilder& out, int indentLevel);
     bool isCustomComponent(const std::string& tagName) const;
 
+    // Fragment cache keys (exact, not a lossy hash; slot content by node identity)
+    static void appendKeyPart(std::string& key, const std::string& part);
+    static void appendNodesKey(std::string& key, const std::vector<TemplateNode*>& nodes);
+
+    // Element whose children are being compiled (explicit stack in generateElement)
+    struct ElementFrame {
+        Element* element;
+        int indentLevel;
+        bool omitEndTag;
+        bool hasBlockChildren;
+        bool preformatted;
+        size_t nextChild;
+    };
+    template <typename Format> void openElement(Element* element, ProgramBuilder& out, int indentLevel,
+                                                bool omitEndTag, std::vector<ElementFrame>& open);
+    template <typename Format> void closeElement(const ElementFrame& frame, ProgramBuilder& out);
+
+    // Minified compilation: children see their siblings (whitespace, end tags)
+    bool isTextBoundary(const TemplateNode* sibling) const;
+    bool canOmitEndTag(const Element* parent, size_t index) const;
+    int m_preformattedDepth = 0;  // > 0 while compiling <pre>/<textarea> content
+
     // Full HTML document generation
-    std::string generateFullHtml(Component* component, const std::string& bodyContent);
-    std::string generateHead(Component* component);
+    template <typename Format> void writeDocumentStart(Component* component, OutputSink& out);
+    template <typename Format> void generateHead(Component* component, OutputSink& out);
     std::string extractTitle(Component* component);
 
     // Helper methods
-    std::string generateAttributes(Element* element);
-    std::string generateClassDirective(ClassDirective* classDir);
-    std::string indent(int level) const;
+    template <typename Format> void generateAttributes(Element* element, OutputSink& out);
+    template <typename Format> void writeAttribute(OutputSink& out, std::string_view name, std::string_view value);
+    void generateClassDirective(ClassDirective* classDir, OutputSink& out);
+    template <typename Format> void writeIndent(OutputSink& out, int level) const;
     bool isSelfClosing(const std::string& tagName) const;
     bool isInline(const std::string& tagName) const;
+    static bool needsAttributeQuotes(std::string_view value);
 
     // Self-closing tags
     static const std::set<std::string> SELF_CLOSING_TAGS;
 
     // Inline tags (don't add newlines)
     static const std::set<std::string> INLINE_TAGS;
+
+    // Tags whose text content is kept verbatim when minifying
+    static const std::set<std::string> PREFORMATTED_TAGS;
+
+    // Optional end tags: elements whose following sibling closes them
+    static const std::unordered_map<std::string, std::set<std::string>> END_TAG_CLOSERS;
 };
 
 } // namespace artic
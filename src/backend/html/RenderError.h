@@ -0,0 +1,20 @@
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+namespace artic {
+
+/**
+ * @brief Exception thrown when a template cannot be rendered
+ *
+ * E.g. when component expansion exceeds HtmlGeneratorOptions::maxRenderDepth,
+ * which is what a component that (indirectly) uses itself runs into.
+ */
+class RenderError : public std::runtime_error {
+public:
+    explicit RenderError(const std::string& message)
+        : std::runtime_error(message) {}
+};
+
+} // namespace artic
@@ -0,0 +1,163 @@
+#include "backend/html/RenderProfile.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace artic {
+
+namespace {
+
+double milliseconds(std::chrono::nanoseconds time) {
+    return std::chrono::duration<double, std::milli>(time).count();
+}
+
+void appendTable(std::string& out, const char* title, const std::vector<RenderCostEntry>& rows, size_t limit) {
+    char line[256];
+
+    out += title;
+    out += "\n";
+    std::snprintf(line, sizeof(line), "%10s %8s %14s %14s %11s %11s  %s\n", "expansions", "cached",
+                  "incl bytes", "self bytes", "incl ms", "self ms", "name");
+    out += line;
+
+    size_t count = limit == 0 ? rows.size() : std::min(limit, rows.size());
+    for (size_t i = 0; i < count; i++) {
+        const RenderCost& cost = rows[i].cost;
+        std::snprintf(line, sizeof(line), "%10zu %8zu %14llu %14llu %11.3f %11.3f  ", cost.expansions,
+                      cost.cacheHits, static_cast<unsigned long long>(cost.inclusiveBytes),
+                      static_cast<unsigned long long>(cost.selfBytes), milliseconds(cost.inclusiveTime),
+                      milliseconds(cost.selfTime));
+        out += line;
+        out += rows[i].name;
+        out += "\n";
+    }
+
+    if (count < rows.size()) {
+        out += "  ... " + std::to_string(rows.size() - count) + " more\n";
+    }
+}
+
+} // namespace
+
+RenderProfile::RenderProfile(std::string rootName)
+    : m_rootName(std::move(rootName)) {}
+
+void RenderProfile::enterRoot(size_t outputSize) {
+    push(m_rootName, {}, outputSize);
+}
+
+void RenderProfile::enter(const std::string& component, const SourceLocation& callSite, size_t outputSize) {
+    push(component, callSiteName(component, callSite), outputSize);
+}
+
+void RenderProfile::leave(size_t outputSize) {
+    OpenComponent open = std::move(m_open.back());
+    m_open.pop_back();
+
+    auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - open.start);
+    record(open, time, outputSize - open.startSize, false);
+}
+
+void RenderProfile::cached(const std::string& component, const SourceLocation& callSite, size_t bytes,
+                           std::chrono::nanoseconds time) {
+    push(component, callSiteName(component, callSite), 0);
+    OpenComponent open = std::move(m_open.back());
+    m_open.pop_back();
+
+    record(open, time, bytes, true);
+}
+
+void RenderProfile::push(const std::string& name, std::string callSite, size_t outputSize) {
+    OpenComponent open;
+    open.name = name;
+    open.callSite = std::move(callSite);
+    open.stack = m_open.empty() ? name : m_open.back().stack + ";" + name;
+    open.startSize = outputSize;
+    open.start = std::chrono::steady_clock::now();
+    m_open.push_back(std::move(open));
+}
+
+void RenderProfile::record(const OpenComponent& open, std::chrono::nanoseconds time, std::uint64_t bytes,
+                           bool cacheHit) {
+    RenderCost cost;
+    cost.expansions = 1;
+    cost.cacheHits = cacheHit ? 1 : 0;
+    cost.inclusiveTime = time;
+    cost.selfTime = time - open.childTime;
+    cost.inclusiveBytes = bytes;
+    cost.selfBytes = bytes - open.childBytes;
+
+    auto add = [&](RenderCost& total) {
+        total.expansions += cost.expansions;
+        total.cacheHits += cost.cacheHits;
+        total.inclusiveTime += cost.inclusiveTime;
+        total.selfTime += cost.selfTime;
+        total.inclusiveBytes += cost.inclusiveBytes;
+        total.selfBytes += cost.selfBytes;
+    };
+
+    add(m_components[open.name]);
+    if (!open.callSite.empty()) {
+        add(m_callSites[open.callSite]);
+    }
+
+    StackCost& stack = m_stacks[open.stack];
+    stack.bytes += cost.selfBytes;
+    stack.time += cost.selfTime;
+
+    // The parent's self cost excludes this component
+    if (!m_open.empty()) {
+        m_open.back().childTime += time;
+        m_open.back().childBytes += bytes;
+    }
+}
+
+std::string RenderProfile::callSiteName(const std::string& component, const SourceLocation& location) const {
+    const std::string& parent = m_open.empty() ? m_rootName : m_open.back().name;
+    return parent + ":" + std::to_string(location.line) + ":" + std::to_string(location.column) + " > " + component;
+}
+
+std::vector<RenderCostEntry> RenderProfile::sorted(const std::map<std::string, RenderCost>& costs) {
+    std::vector<RenderCostEntry> entries;
+    entries.reserve(costs.size());
+    for (const auto& [name, cost] : costs) {
+        entries.push_back({name, cost});
+    }
+
+    // Stable: ties keep name order
+    std::stable_sort(entries.begin(), entries.end(), [](const RenderCostEntry& a, const RenderCostEntry& b) {
+        return a.cost.inclusiveBytes > b.cost.inclusiveBytes;
+    });
+    return entries;
+}
+
+std::vector<RenderCostEntry> RenderProfile::byComponent() const {
+    return sorted(m_components);
+}
+
+std::vector<RenderCostEntry> RenderProfile::byCallSite() const {
+    return sorted(m_callSites);
+}
+
+std::string RenderProfile::report(size_t limit) const {
+    std::string out;
+    appendTable(out, "Render cost by component (largest inclusive bytes first)", byComponent(), limit);
+    out += "\n";
+    appendTable(out, "Render cost by call site", byCallSite(), limit);
+    return out;
+}
+
+std::string RenderProfile::foldedStacks(RenderMetric metric) const {
+    std::string out;
+    for (const auto& [stack, cost] : m_stacks) {
+        std::uint64_t weight = metric == RenderMetric::Bytes
+            ? cost.bytes
+            : static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(cost.time).count());
+        if (weight == 0) {
+            continue;
+        }
+        out += stack + " " + std::to_string(weight) + "\n";
+    }
+    return out;
+}
+
+} // namespace artic
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "frontend/lexer/SourceLocation.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace artic {
+
+/**
+ * @brief What one component (or call site) cost while rendering a page
+ *
+ * Inclusive figures contain the nested components; self figures do not.
+ * Slot content counts towards the component that renders the slot.
+ */
+struct RenderCost {
+    size_t expansions = 0;                  // Renders, including fragment cache hits
+    size_t cacheHits = 0;                   // Expansions copied from the fragment cache
+    std::chrono::nanoseconds inclusiveTime{};
+    std::chrono::nanoseconds selfTime{};
+    std::uint64_t inclusiveBytes = 0;       // HTML bytes emitted
+    std::uint64_t selfBytes = 0;
+};
+
+/**
+ * @brief Named cost row of a report
+ */
+struct RenderCostEntry {
+    std::string name;
+    RenderCost cost;
+};
+
+/**
+ * @brief Weight of a folded stack line
+ */
+enum class RenderMetric {
+    Bytes,  // Self bytes emitted
+    Time    // Self time in microseconds
+};
+
+/**
+ * @brief Per-component render cost attribution (profiling mode)
+ *
+ * HtmlGenerator calls enter()/leave() around every component it expands
+ * when HtmlGeneratorOptions::renderProfile is set. Costs are aggregated per
+ * component, per call site (parent component and use site position) and
+ * per component stack, which feeds flame graph tools:
+ *
+ *   Home;Layout;NavBar;NavLink 1843
+ *
+ * A fragment cache hit is recorded as an expansion of the cached component
+ * alone; the components inside the copied fragment are not visited again.
+ */
+class RenderProfile {
+public:
+    /**
+     * @param rootName Name of the page at the bottom of every stack
+     */
+    explicit RenderProfile(std::string rootName = "page");
+
+    /**
+     * @brief Start rendering the page (outputSize: bytes already in the sink)
+     */
+    void enterRoot(size_t outputSize);
+
+    /**
+     * @brief Start expanding a component
+     * @param outputSize Current size of the sink the component renders into
+     */
+    void enter(const std::string& component, const SourceLocation& callSite, size_t outputSize);
+
+    /**
+     * @brief Finish the innermost component (or the root)
+     * @param outputSize Size of the same sink after rendering
+     */
+    void leave(size_t outputSize);
+
+    /**
+     * @brief Record a component copied from the fragment cache
+     */
+    void cached(const std::string& component, const SourceLocation& callSite, size_t bytes,
+                std::chrono::nanoseconds time);
+
+    /**
+     * @brief Components by inclusive bytes, largest first
+     */
+    std::vector<RenderCostEntry> byComponent() const;
+
+    /**
+     * @brief Call sites ("Parent:line:column > Component") by inclusive bytes, largest first
+     */
+    std::vector<RenderCostEntry> byCallSite() const;
+
+    /**
+     * @brief Human-readable report of both tables
+     * @param limit Rows per table (0 = all)
+     */
+    std::string report(size_t limit = 0) const;
+
+    /**
+     * @brief One "frame;frame;frame weight" line per component stack
+     */
+    std::string foldedStacks(RenderMetric metric) const;
+
+private:
+    struct OpenComponent {
+        std::string name;
+        std::string callSite;
+        std::string stack;              // Folded path down to this component
+        std::chrono::steady_clock::time_point start;
+        size_t startSize;
+        std::chrono::nanoseconds childTime{};
+        std::uint64_t childBytes = 0;
+    };
+
+    struct StackCost {
+        std::uint64_t bytes = 0;
+        std::chrono::nanoseconds time{};
+    };
+
+    std::string m_rootName;
+    std::vector<OpenComponent> m_open;
+    std::map<std::string, RenderCost> m_components;
+    std::map<std::string, RenderCost> m_callSites;
+    std::map<std::string, StackCost> m_stacks;
+
+    void push(const std::string& name, std::string callSite, size_t outputSize);
+    void record(const OpenComponent& open, std::chrono::nanoseconds time, std::uint64_t bytes, bool cacheHit);
+    std::string callSiteName(const std::string& component, const SourceLocation& location) const;
+    static std::vector<RenderCostEntry> sorted(const std::map<std::string, RenderCost>& costs);
+};
+
+} // namespace artic
@@ -0,0 +1,608 @@
+#include "backend/html/TemplateExpression.h"
+#include <algorithm>
+#include <charconv>
+#include <cctype>
+#include <cmath>
+
+namespace artic {
+
+// ============================================================================
+// ExpressionValue
+// ============================================================================
+
+namespace {
+
+// Number::prototype.toString for finite, non-zero values: the shortest
+// round-trip digits, written in positional notation while the decimal
+// exponent is in [-7, 21) (1e16 → "10000000000000000", 1e21 → "1e+21")
+std::string formatNumber(double value) {
+    char buffer[40];
+    auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::scientific);
+    std::string_view scientific(buffer, static_cast<size_t>(ptr - buffer));
+
+    std::string result;
+    if (scientific.front() == '-') {
+        result += '-';
+        scientific.remove_prefix(1);
+    }
+
+    // "d.ddde±XX" → digits "dddd", point position n (value = 0.dddd × 10^n)
+    size_t e = scientific.find('e');
+    std::string digits;
+    for (char c : scientific.substr(0, e)) {
+        if (c != '.') {
+            digits += c;
+        }
+    }
+    int exponent = 0;
+    std::string_view exponentText = scientific.substr(e + 1);
+    if (exponentText.front() == '+') {
+        exponentText.remove_prefix(1);
+    }
+    std::from_chars(exponentText.data(), exponentText.data() + exponentText.size(), exponent);
+    int k = static_cast<int>(digits.size());
+    int n = exponent + 1;
+
+    if (k <= n && n <= 21) {
+        result += digits;
+        result.append(static_cast<size_t>(n - k), '0');
+    } else if (0 < n && n <= 21) {
+        result += digits.substr(0, static_cast<size_t>(n));
+        result += '.';
+        result += digits.substr(static_cast<size_t>(n));
+    } else if (-6 < n && n <= 0) {
+        result += "0.";
+        result.append(static_cast<size_t>(-n), '0');
+        result += digits;
+    } else {
+        result += digits[0];
+        if (k > 1) {
+            result += '.';
+            result += digits.substr(1);
+        }
+        result += n - 1 < 0 ? "e-" : "e+";
+        result += std::to_string(std::abs(n - 1));
+    }
+    return result;
+}
+
+} // namespace
+
+ExpressionValue ExpressionValue::string(std::string value) {
+    ExpressionValue result;
+    result.m_type = Type::String;
+    result.m_string = std::move(value);
+    return result;
+}
+
+ExpressionValue ExpressionValue::number(double value) {
+    ExpressionValue result;
+    result.m_type = Type::Number;
+    result.m_number = value;
+    return result;
+}
+
+ExpressionValue ExpressionValue::boolean(bool value) {
+    ExpressionValue result;
+    result.m_type = Type::Boolean;
+    result.m_boolean = value;
+    return result;
+}
+
+bool ExpressionValue::truthy() const {
+    switch (m_type) {
+        case Type::String: return !m_string.empty();
+        case Type::Number: return m_number != 0 && !std::isnan(m_number);
+        case Type::Boolean: return m_boolean;
+    }
+    return false;
+}
+
+std::optional<double> ExpressionValue::toNumber() const {
+    switch (m_type) {
+        case Type::Number:
+            return m_number;
+        case Type::Boolean:
+            return m_boolean ? 1.0 : 0.0;
+        case Type::String: {
+            double value = 0;
+            const char* begin = m_string.data();
+            const char* end = begin + m_string.size();
+            auto [ptr, ec] = std::from_chars(begin, end, value);
+            if (m_string.empty() || ec != std::errc() || ptr != end) {
+                return std::nullopt;
+            }
+            return value;
+        }
+    }
+    return std::nullopt;
+}
+
+std::string ExpressionValue::toString() const {
+    switch (m_type) {
+        case Type::String:
+            return m_string;
+        case Type::Boolean:
+            return m_boolean ? "true" : "false";
+        case Type::Number: {
+            if (std::isnan(m_number)) {
+                return "NaN";
+            }
+            if (std::isinf(m_number)) {
+                return m_number > 0 ? "Infinity" : "-Infinity";
+            }
+            if (m_number == 0) {
+                return "0";  // Also -0
+            }
+            return formatNumber(m_number);
+        }
+    }
+    return {};
+}
+
+bool ExpressionValue::operator==(const ExpressionValue& other) const {
+    if (m_type != other.m_type) {
+        return false;
+    }
+    switch (m_type) {
+        case Type::String: return m_string == other.m_string;
+        case Type::Number: return m_number == other.m_number;
+        case Type::Boolean: return m_boolean == other.m_boolean;
+    }
+    return false;
+}
+
+// ============================================================================
+// Compilation (tokenizer + precedence climbing)
+// ============================================================================
+
+namespace {
+
+enum class ExprTokenType : std::uint8_t { Number, String, Identifier, Operator, End };
+
+struct ExprToken {
+    ExprTokenType type = ExprTokenType::End;
+    std::string text;   // Operator/identifier text, unescaped string contents
+    double number = 0;
+};
+
+// Longest operators first so "===" is not read as "==" + "="
+constexpr std::string_view OPERATORS[] = {
+    "===", "!==", "==", "!=", "<=", ">=", "&&", "||",
+    "+", "-", "*", "/", "%", "<", ">", "!", "?", ":", "(", ")", "."
+};
+
+bool tokenize(std::string_view source, std::vector<ExprToken>& tokens) {
+    size_t i = 0;
+    while (i < source.size()) {
+        char c = source[i];
+
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            i++;
+            continue;
+        }
+
+        ExprToken token;
+
+        if (std::isdigit(static_cast<unsigned char>(c)) ||
+            (c == '.' && i + 1 < source.size() && std::isdigit(static_cast<unsigned char>(source[i + 1])))) {
+            size_t start = i;
+            while (i < source.size() && (std::isdigit(static_cast<unsigned char>(source[i])) || source[i] == '.')) {
+                i++;
+            }
+            auto [ptr, ec] = std::from_chars(source.data() + start, source.data() + i, token.number);
+            if (ec != std::errc() || ptr != source.data() + i) {
+                return false;
+            }
+            token.type = ExprTokenType::Number;
+        } else if (c == '"' || c == '\'') {
+            char quote = c;
+            i++;
+            bool closed = false;
+            while (i < source.size()) {
+                char ch = source[i++];
+                if (ch == quote) {
+                    closed = true;
+                    break;
+                }
+                if (ch == '\\' && i < source.size()) {
+                    char escaped = source[i++];
+                    switch (escaped) {
+                        case 'n': token.text += '\n'; break;
+                        case 't': token.text += '\t'; break;
+                        case 'r': token.text += '\r'; break;
+                        default: token.text += escaped; break;
+                    }
+                    continue;
+                }
+                token.text += ch;
+            }
+            if (!closed) {
+                return false;
+            }
+            token.type = ExprTokenType::String;
+        } else if (std::isalpha(static_cast<unsigned char>(c)) || c == '_' || c == '$') {
+            size_t start = i;
+            while (i < source.size() &&
+                   (std::isalnum(static_cast<unsigned char>(source[i])) || source[i] == '_' || source[i] == '$')) {
+                i++;
+            }
+            token.type = ExprTokenType::Identifier;
+            token.text = std::string(source.substr(start, i - start));
+        } else {
+            auto op = std::find_if(std::begin(OPERATORS), std::end(OPERATORS), [&](std::string_view candidate) {
+                return source.substr(i, candidate.size()) == candidate;
+            });
+            if (op == std::end(OPERATORS)) {
+                return false;
+            }
+            token.type = ExprTokenType::Operator;
+            token.text = std::string(*op);
+            i += op->size();
+        }
+
+        tokens.push_back(std::move(token));
+    }
+
+    tokens.push_back(ExprToken{});
+    return true;
+}
+
+// Binding power of binary operators (higher binds tighter)
+int binaryPrecedence(const std::string& op) {
+    if (op == "||") return 1;
+    if (op == "&&") return 2;
+    if (op == "==" || op == "!=" || op == "===" || op == "!==") return 3;
+    if (op == "<" || op == ">" || op == "<=" || op == ">=") return 4;
+    if (op == "+" || op == "-") return 5;
+    if (op == "*" || op == "/" || op == "%") return 6;
+    return 0;
+}
+
+} // namespace
+
+/**
+ * @brief Recursive-descent compiler producing the flat node list
+ *
+ * Any unsupported token makes compile() return nullptr; it never throws,
+ * because an expression it cannot handle is still valid template source.
+ */
+class TemplateExpression::Compiler {
+public:
+    Compiler(TemplateExpression& expr, std::vector<ExprToken> tokens)
+        : m_expr(expr), m_tokens(std::move(tokens)) {}
+
+    bool run() {
+        m_expr.m_root = parseConditional();
+        return m_expr.m_root >= 0 && peek().type == ExprTokenType::End;
+    }
+
+private:
+    TemplateExpression& m_expr;
+    std::vector<ExprToken> m_tokens;
+    size_t m_pos = 0;
+    size_t m_depth = 0;
+
+    const ExprToken& peek() const { return m_tokens[m_pos]; }
+
+    bool isOperator(std::string_view op) const {
+        return peek().type == ExprTokenType::Operator && peek().text == op;
+    }
+
+    // Fails (-1) once the tree gets deeper than MAX_DEPTH, which also bounds
+    // evaluation recursion for long chains like a + b + c + ...
+    int addNode(Node node) {
+        for (int operand : node.operands) {
+            if (operand >= 0) {
+                node.height = std::max(node.height, m_expr.m_nodes[static_cast<size_t>(operand)].height + 1);
+            }
+        }
+        if (node.height > MAX_DEPTH) {
+            return -1;
+        }
+        m_expr.m_nodes.push_back(std::move(node));
+        return static_cast<int>(m_expr.m_nodes.size()) - 1;
+    }
+
+    // condition ? then : else (right associative)
+    int parseConditional() {
+        if (++m_depth > MAX_DEPTH) {
+            return -1;
+        }
+
+        int condition = parseBinary(1);
+        if (condition >= 0 && isOperator("?")) {
+            m_pos++;
+            int whenTrue = parseConditional();
+            if (whenTrue < 0 || !isOperator(":")) {
+                return -1;
+            }
+            m_pos++;
+            int whenFalse = parseConditional();
+            if (whenFalse < 0) {
+                return -1;
+            }
+
+            Node node;
+            node.kind = NodeKind::Conditional;
+            node.operands[0] = condition;
+            node.operands[1] = whenTrue;
+            node.operands[2] = whenFalse;
+            condition = addNode(std::move(node));
+        }
+
+        m_depth--;
+        return condition;
+    }
+
+    // Left-associative binary operators by precedence climbing
+    int parseBinary(int minPrecedence) {
+        int left = parseUnary();
+        while (left >= 0 && peek().type == ExprTokenType::Operator) {
+            std::string op = peek().text;
+            int precedence = binaryPrecedence(op);
+            if (precedence == 0 || precedence < minPrecedence) {
+                break;
+            }
+            m_pos++;
+
+            int right = parseBinary(precedence + 1);
+            if (right < 0) {
+                return -1;
+            }
+
+            Node node;
+            node.kind = NodeKind::Binary;
+            node.op = std::move(op);
+            node.operands[0] = left;
+            node.operands[1] = right;
+            left = addNode(std::move(node));
+        }
+        return left;
+    }
+
+    int parseUnary() {
+        if (isOperator("!") || isOperator("-") || isOperator("+")) {
+            if (++m_depth > MAX_DEPTH) {
+                return -1;
+            }
+            std::string op = peek().text;
+            m_pos++;
+
+            int operand = parseUnary();
+            m_depth--;
+            if (operand < 0) {
+                return -1;
+            }
+
+            Node node;
+            node.kind = NodeKind::Unary;
+            node.op = std::move(op);
+            node.operands[0] = operand;
+            return addNode(std::move(node));
+        }
+        return parsePrimary();
+    }
+
+    int parsePrimary() {
+        const ExprToken& token = peek();
+
+        switch (token.type) {
+            case ExprTokenType::Number: {
+                m_pos++;
+                Node node;
+                node.literal = ExpressionValue::number(token.number);
+                return addNode(std::move(node));
+            }
+
+            case ExprTokenType::String: {
+                m_pos++;
+                Node node;
+                node.literal = ExpressionValue::string(token.text);
+                return addNode(std::move(node));
+            }
+
+            case ExprTokenType::Identifier:
+                return parseIdentifier();
+
+            case ExprTokenType::Operator:
+                if (token.text == "(") {
+                    m_pos++;
+                    int inner = parseConditional();
+                    if (inner < 0 || !isOperator(")")) {
+                        return -1;
+                    }
+                    m_pos++;
+                    return inner;
+                }
+                return -1;
+
+            case ExprTokenType::End:
+                return -1;
+        }
+        return -1;
+    }
+
+    // true / false / name / props.name
+    int parseIdentifier() {
+        std::string name = peek().text;
+        m_pos++;
+
+        Node node;
+        if (name == "true" || name == "false") {
+            node.literal = ExpressionValue::boolean(name == "true");
+            return addNode(std::move(node));
+        }
+
+        if (name == "props" && isOperator(".")) {
+            m_pos++;
+            if (peek().type != ExprTokenType::Identifier) {
+                return -1;
+            }
+            name = peek().text;
+            m_pos++;
+        }
+
+        // Member access, calls, etc. on anything else are not supported
+        if (isOperator(".") || isOperator("(")) {
+            return -1;
+        }
+
+        node.kind = NodeKind::Reference;
+        node.name = name;
+        if (std::find(m_expr.m_references.begin(), m_expr.m_references.end(), name) == m_expr.m_references.end()) {
+            m_expr.m_references.push_back(name);
+        }
+        return addNode(std::move(node));
+    }
+};
+
+std::unique_ptr<TemplateExpression> TemplateExpression::compile(std::string_view source) {
+    std::vector<ExprToken> tokens;
+    if (!tokenize(source, tokens)) {
+        return nullptr;
+    }
+
+    auto expr = std::unique_ptr<TemplateExpression>(new TemplateExpression());
+    Compiler compiler(*expr, std::move(tokens));
+    if (!compiler.run()) {
+        return nullptr;
+    }
+    return expr;
+}
+
+const std::string* TemplateExpression::simpleReference() const {
+    const Node& root = m_nodes[static_cast<size_t>(m_root)];
+    return root.kind == NodeKind::Reference ? &root.name : nullptr;
+}
+
+// ============================================================================
+// Evaluation
+// ============================================================================
+
+std::optional<ExpressionValue> TemplateExpression::evaluate(const Lookup& lookup) const {
+    return evaluateNode(m_root, lookup);
+}
+
+std::optional<ExpressionValue> TemplateExpression::evaluateNode(int index, const Lookup& lookup) const {
+    const Node& node = m_nodes[static_cast<size_t>(index)];
+
+    switch (node.kind) {
+        case NodeKind::Literal:
+            return node.literal;
+
+        case NodeKind::Reference:
+            return lookup ? lookup(node.name) : std::nullopt;
+
+        case NodeKind::Unary: {
+            auto operand = evaluateNode(node.operands[0], lookup);
+            if (!operand) {
+                return std::nullopt;
+            }
+            if (node.op == "!") {
+                return ExpressionValue::boolean(!operand->truthy());
+            }
+            auto value = operand->toNumber();
+            if (!value) {
+                return std::nullopt;
+            }
+            return ExpressionValue::number(node.op == "-" ? -*value : *value);
+        }
+
+        case NodeKind::Binary: {
+            auto left = evaluateNode(node.operands[0], lookup);
+            if (!left) {
+                return std::nullopt;
+            }
+
+            // Short-circuit, yielding the deciding operand as JavaScript does
+            if (node.op == "&&") {
+                return left->truthy() ? evaluateNode(node.operands[1], lookup) : left;
+            }
+            if (node.op == "||") {
+                return left->truthy() ? left : evaluateNode(node.operands[1], lookup);
+            }
+
+            auto right = evaluateNode(node.operands[1], lookup);
+            if (!right) {
+                return std::nullopt;
+            }
+            return applyBinary(node.op, *left, *right);
+        }
+
+        case NodeKind::Conditional: {
+            auto condition = evaluateNode(node.operands[0], lookup);
+            if (!condition) {
+                return std::nullopt;
+            }
+            return evaluateNode(node.operands[condition->truthy() ? 1 : 2], lookup);
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<ExpressionValue> TemplateExpression::applyBinary(const std::string& op, const ExpressionValue& left,
+                                                               const ExpressionValue& right) {
+    // String concatenation wins over addition
+    if (op == "+" && (left.isString() || right.isString())) {
+        return ExpressionValue::string(left.toString() + right.toString());
+    }
+
+    if (op == "==" || op == "===" || op == "!=" || op == "!==") {
+        bool equal = left == right;
+        // Loose equality compares mixed types numerically: "3" == 3
+        if (!equal && (op == "==" || op == "!=") && left.type() != right.type()) {
+            auto a = left.toNumber();
+            auto b = right.toNumber();
+            equal = a && b && *a == *b;
+        }
+        bool negate = op == "!=" || op == "!==";
+        return ExpressionValue::boolean(equal != negate);
+    }
+
+    if (op == "<" || op == ">" || op == "<=" || op == ">=") {
+        int order;
+        if (left.isString() && right.isString()) {
+            int cmp = left.toString().compare(right.toString());
+            order = cmp < 0 ? -1 : (cmp > 0 ? 1 : 0);
+        } else {
+            auto a = left.toNumber();
+            auto b = right.toNumber();
+            if (!a || !b) {
+                return std::nullopt;
+            }
+            // Every relational comparison with NaN is false
+            if (std::isnan(*a) || std::isnan(*b)) {
+                return ExpressionValue::boolean(false);
+            }
+            order = *a < *b ? -1 : (*a > *b ? 1 : 0);
+        }
+
+        if (op == "<") return ExpressionValue::boolean(order < 0);
+        if (op == ">") return ExpressionValue::boolean(order > 0);
+        if (op == "<=") return ExpressionValue::boolean(order <= 0);
+        return ExpressionValue::boolean(order >= 0);
+    }
+
+    // Arithmetic: operands must be numeric
+    auto a = left.toNumber();
+    auto b = right.toNumber();
+    if (!a || !b) {
+        return std::nullopt;
+    }
+
+    if (op == "+") return ExpressionValue::number(*a + *b);
+    if (op == "-") return ExpressionValue::number(*a - *b);
+    if (op == "*") return ExpressionValue::number(*a * *b);
+
+    // Division by zero would print "Infinity"/"NaN"; keep the placeholder instead
+    if (*b == 0) {
+        return std::nullopt;
+    }
+    if (op == "/") return ExpressionValue::number(*a / *b);
+    if (op == "%") return ExpressionValue::number(std::fmod(*a, *b));
+
+    return std::nullopt;
+}
+
+} // namespace artic
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace artic {
+
+/**
+ * @brief Value produced by evaluating a template expression
+ */
+class ExpressionValue {
+public:
+    enum class Type : std::uint8_t { String, Number, Boolean };
+
+    static ExpressionValue string(std::string value);
+    static ExpressionValue number(double value);
+    static ExpressionValue boolean(bool value);
+
+    Type type() const { return m_type; }
+    bool isString() const { return m_type == Type::String; }
+
+    /**
+     * @brief JavaScript truthiness ("" , 0, NaN and false are falsy)
+     */
+    bool truthy() const;
+
+    /**
+     * @brief Numeric value (strings must be a complete number literal)
+     */
+    std::optional<double> toNumber() const;
+
+    /**
+     * @brief Text as it appears in the output ("3", "0.5", "true"); numbers
+     *        follow JavaScript's Number#toString (exponent form from 1e21)
+     */
+    std::string toString() const;
+
+    bool operator==(const ExpressionValue& other) const;
+
+private:
+    Type m_type = Type::String;
+    std::string m_string;
+    double m_number = 0;
+    bool m_boolean = false;
+};
+
+/**
+ * @brief Template expression compiled into a small evaluable tree
+ *
+ * Supports the subset of JavaScript that templates use for display logic:
+ *
+ *   literals     "text"  'text'  42  1.5  true  false
+ *   props        title  props.title
+ *   operators    !  unary -  * / %  + -  < > <= >= == != === !==  && ||
+ *   conditional  count > 1 ? "items" : "item"
+ *
+ * Expressions that read no props are folded into static text when the
+ * template is compiled; the rest are evaluated per render against the
+ * props in scope. Anything outside the subset (calls, member access on
+ * other objects, assignments) fails to compile and keeps the placeholder.
+ */
+class TemplateExpression {
+public:
+    /**
+     * @brief Resolves a prop name to its value (nullopt if unknown)
+     */
+    using Lookup = std::function<std::optional<ExpressionValue>(const std::string&)>;
+
+    /**
+     * @brief Maximum nesting of parentheses, operators and conditionals
+     */
+    static constexpr size_t MAX_DEPTH = 256;
+
+    /**
+     * @brief Compile expression source
+     * @return nullptr if the expression uses unsupported syntax
+     */
+    static std::unique_ptr<TemplateExpression> compile(std::string_view source);
+
+    /**
+     * @brief Evaluate against props
+     * @return nullopt if a prop is unknown or an operand has the wrong type
+     */
+    std::optional<ExpressionValue> evaluate(const Lookup& lookup) const;
+
+    /**
+     * @brief Props the expression reads (deduplicated, "props." prefix removed)
+     */
+    const std::vector<std::string>& references() const { return m_references; }
+
+    /**
+     * @brief Check if the expression reads no props (can be folded)
+     */
+    bool isConstant() const { return m_references.empty(); }
+
+    /**
+     * @brief Prop name if the whole expression is {name} or {props.name}
+     */
+    const std::string* simpleReference() const;
+
+    enum class NodeKind : std::uint8_t { Literal, Reference, Unary, Binary, Conditional };
+
+    struct Node {
+        NodeKind kind = NodeKind::Literal;
+        std::string op;                               // Unary/Binary operator
+        ExpressionValue literal;                      // Literal
+        std::string name;                             // Reference
+        int operands[3] = {-1, -1, -1};               // Child node indices
+        size_t height = 1;                            // Levels below and including this node
+    };
+
+    /**
+     * @brief Root of the compiled tree (for backends that lower it to code)
+     */
+    int root() const { return m_root; }
+
+    /**
+     * @brief Node by index (operands of a node index into the same list)
+     */
+    const Node& node(int index) const { return m_nodes[static_cast<size_t>(index)]; }
+
+private:
+    class Compiler;
+
+    std::vector<Node> m_nodes;  // Flat tree; children precede their parent
+    int m_root = -1;
+    std::vector<std::string> m_references;
+
+    std::optional<ExpressionValue> evaluateNode(int index, const Lookup& lookup) const;
+    static std::optional<ExpressionValue> applyBinary(const std::string& op, const ExpressionValue& left,
+                                                      const ExpressionValue& right);
+};
+
+} // namespace artic
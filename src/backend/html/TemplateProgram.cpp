@@ -0,0 +1,69 @@
+#include "backend/html/TemplateProgram.h"
+
+namespace artic {
+
+ProgramBuilder::ProgramBuilder()
+    : m_program(std::make_unique<TemplateProgram>()) {}
+
+void ProgramBuilder::write(const char* data, size_t size) {
+    if (size == 0) {
+        return;
+    }
+
+    auto& code = m_program->m_code;
+    auto& statics = m_program->m_statics;
+
+    // Extend the trailing static chunk, or open a new one
+    if (code.empty() || code.back().op != TemplateOp::Static) {
+        TemplateInstruction instruction;
+        instruction.op = TemplateOp::Static;
+        instruction.offset = static_cast<std::uint32_t>(statics.size());
+        code.push_back(std::move(instruction));
+    }
+
+    statics.append(data, size);
+    code.back().length += static_cast<std::uint32_t>(size);
+}
+
+void ProgramBuilder::addExpression(std::string propName, std::string_view fallback,
+                                   std::unique_ptr<const TemplateExpression> expression) {
+    auto& statics = m_program->m_statics;
+
+    TemplateInstruction instruction;
+    instruction.op = TemplateOp::Expression;
+    instruction.name = std::move(propName);
+    instruction.expression = std::move(expression);
+    instruction.offset = static_cast<std::uint32_t>(statics.size());
+    instruction.length = static_cast<std::uint32_t>(fallback.size());
+    statics.append(fallback);
+
+    m_program->m_code.push_back(std::move(instruction));
+    m_program->m_usesContext = true;
+}
+
+void ProgramBuilder::addSlot(std::string slotName, int indentLevel, std::unique_ptr<TemplateProgram> fallback) {
+    TemplateInstruction instruction;
+    instruction.op = TemplateOp::Slot;
+    instruction.name = std::move(slotName);
+    instruction.indentLevel = indentLevel;
+    instruction.fallback = std::move(fallback);
+
+    m_program->m_code.push_back(std::move(instruction));
+    m_program->m_usesContext = true;
+}
+
+void ProgramBuilder::addComponent(Component* component, const Element* element, int indentLevel) {
+    TemplateInstruction instruction;
+    instruction.op = TemplateOp::Component;
+    instruction.component = component;
+    instruction.element = element;
+    instruction.indentLevel = indentLevel;
+
+    m_program->m_code.push_back(std::move(instruction));
+}
+
+std::unique_ptr<TemplateProgram> ProgramBuilder::finish() {
+    return std::move(m_program);
+}
+
+} // namespace artic
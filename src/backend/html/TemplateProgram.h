@@ -0,0 +1,155 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "backend/html/TemplateExpression.h"
+#include "frontend/ast/Component.h"
+#include "frontend/ast/Template.h"
+#include "shared/utils/OutputSink.h"
+
+namespace artic {
+
+class TemplateProgram;
+
+/**
+ * @brief Template IR operation
+ */
+enum class TemplateOp : std::uint8_t {
+    Static,      // Copy a pre-rendered chunk of bytes
+    Expression,  // Expression evaluated against the props in scope, else a fallback chunk
+    Slot,        // Caller's slot content, else a fallback program
+    Component    // Render a nested component with the use site as context
+};
+
+/**
+ * @brief One instruction of a TemplateProgram
+ */
+struct TemplateInstruction {
+    TemplateOp op = TemplateOp::Static;
+
+    // Static: chunk to copy; Expression: fallback chunk
+    std::uint32_t offset = 0;
+    std::uint32_t length = 0;
+
+    // Expression: prop name (empty unless {name} or {props.name}); Slot: slot name (empty = default slot)
+    std::string name;
+
+    // Expression: compiled source (null if it uses unsupported syntax)
+    std::unique_ptr<const TemplateExpression> expression;
+
+    // Slot/Component: indentation level the content renders at
+    int indentLevel = 0;
+
+    // Component: definition and use site (props and slot content)
+    Component* component = nullptr;
+    const Element* element = nullptr;
+
+    // Slot: rendered when the caller provides no content
+    std::unique_ptr<TemplateProgram> fallback;
+};
+
+/**
+ * @brief Template lowered into a flat instruction list
+ *
+ * Everything that does not depend on props, slots or nested components
+ * (tags, attributes, indentation, newlines) is formatted once at compile
+ * time and coalesced into large static chunks:
+ *
+ * <li><Badge label="new" /></li>
+ *
+ * →
+ *
+ *   STATIC     "    <li>"
+ *   COMPONENT  Badge (indent 3)
+ *   STATIC     "</li>\n"
+ *
+ * Rendering a program is mostly copying chunks into the sink.
+ */
+class TemplateProgram {
+public:
+    const std::vector<TemplateInstruction>& instructions() const { return m_code; }
+
+    /**
+     * @brief Bytes of the static (or fallback) chunk of an instruction
+     */
+    std::string_view chunk(const TemplateInstruction& instruction) const {
+        return std::string_view(m_statics).substr(instruction.offset, instruction.length);
+    }
+
+    /**
+     * @brief Total size of all static chunks
+     */
+    size_t staticBytes() const { return m_statics.size(); }
+
+    /**
+     * @brief Check if rendering reads props or slots from the render context
+     */
+    bool usesContext() const { return m_usesContext; }
+
+    /**
+     * @brief Props declared by the component this program renders (null for slot content)
+     *
+     * Expressions fall back to the declared defaults and types when the
+     * render context does not pass a prop.
+     */
+    const PropsBlock* props() const { return m_props; }
+
+private:
+    friend class ProgramBuilder;
+
+    std::string m_statics;
+    std::vector<TemplateInstruction> m_code;
+    bool m_usesContext = false;
+    const PropsBlock* m_props = nullptr;
+};
+
+/**
+ * @brief Sink that lowers emitted output into a TemplateProgram
+ *
+ * Bytes written through the OutputSink interface become static chunks;
+ * consecutive writes are merged into one chunk. Holes are added with the
+ * add* methods.
+ */
+class ProgramBuilder : public OutputSink {
+public:
+    ProgramBuilder();
+
+    void write(const char* data, size_t size) override;
+    size_t size() const override { return m_program->m_statics.size(); }
+
+    /**
+     * @brief Add an expression with a fallback rendered when it cannot be evaluated
+     * @param propName Prop name for {name} and {props.name}, otherwise empty
+     * @param expression Compiled expression (null renders the fallback)
+     */
+    void addExpression(std::string propName, std::string_view fallback,
+                       std::unique_ptr<const TemplateExpression> expression);
+
+    /**
+     * @brief Set the props declaration expressions resolve defaults from
+     */
+    void setProps(const PropsBlock* props) { m_program->m_props = props; }
+
+    /**
+     * @brief Add a slot with the program rendered when no content is passed
+     */
+    void addSlot(std::string slotName, int indentLevel, std::unique_ptr<TemplateProgram> fallback);
+
+    /**
+     * @brief Add a nested component use
+     */
+    void addComponent(Component* component, const Element* element, int indentLevel);
+
+    /**
+     * @brief Take the finished program (the builder must not be used afterwards)
+     */
+    std::unique_ptr<TemplateProgram> finish();
+
+private:
+    std::unique_ptr<TemplateProgram> m_program;
+};
+
+} // namespace artic
@@ -0,0 +1,976 @@
+#include "backend/ssr/SsrGenerator.h"
+#include "compiler/ComponentRegistry.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdio>
+#include <unordered_set>
+
+namespace artic {
+
+namespace {
+
+const std::unordered_set<std::string> CPP_KEYWORDS = {
+    "alignas", "alignof", "and", "asm", "auto", "bool", "break", "case", "catch",
+    "char", "class", "const", "continue", "default", "delete", "do", "double",
+    "else", "enum", "explicit", "export", "extern", "false", "float", "for",
+    "friend", "goto", "if", "inline", "int", "long", "mutable", "namespace",
+    "new", "noexcept", "not", "nullptr", "operator", "or", "private",
+    "protected", "public", "register", "return", "short", "signed", "sizeof",
+    "static", "struct", "switch", "template", "this", "throw", "true", "try",
+    "typedef", "typename", "union", "unsigned", "using", "virtual", "void",
+    "volatile", "while", "out", "props", "slots"
+};
+
+std::string trimQuotes(const std::string& value) {
+    if (value.size() >= 2 && (value.front() == '"' || value.front() == '\'') && value.back() == value.front()) {
+        return value.substr(1, value.size() - 2);
+    }
+    return value;
+}
+
+} // namespace
+
+SsrGenerator::SsrGenerator(const SsrGeneratorOptions& options, const ComponentRegistry& registry)
+    : m_options(options),
+      m_registry(registry),
+      m_html([&] {
+          HtmlGeneratorOptions htmlOptions;
+          htmlOptions.pretty = false;
+          htmlOptions.minify = options.minify;
+          htmlOptions.includeDoctype = options.includeDoctype;
+          htmlOptions.cssFile = options.cssFile;
+          htmlOptions.classMangler = options.classMangler;
+          return htmlOptions;
+      }(), &registry) {}
+
+std::vector<GeneratedFile> SsrGenerator::generate(Component* root) {
+    std::vector<GeneratedFile> files;
+    std::vector<std::string> sources;
+
+    // The page and its imports (a shared registry holds other pages too), in stable order
+    std::vector<std::string> names = m_registry.closure(root);
+    std::sort(names.begin(), names.end());
+
+    for (const auto& name : names) {
+        Component* component = m_registry.getComponent(name);
+        const ComponentInfo& componentInfo = info(component, name);
+        bool isPage = component == root;
+
+        std::string source = generateSource(component, componentInfo, isPage);
+        files.push_back({componentInfo.identifier + ".h", generateHeader(componentInfo, isPage)});
+        files.push_back({componentInfo.identifier + ".cpp", std::move(source)});
+        sources.push_back(componentInfo.identifier + ".cpp");
+    }
+
+    files.push_back({"artic_ssr_runtime.h", generateRuntime()});
+    files.push_back({"CMakeLists.txt", generateCMakeLists(sources)});
+
+    return files;
+}
+
+const SsrGenerator::ComponentInfo& SsrGenerator::info(Component* component, const std::string& name) {
+    auto it = m_infos.find(component);
+    if (it != m_infos.end()) {
+        return it->second;
+    }
+
+    ComponentInfo result;
+    result.name = name;
+    result.identifier = typeIdentifier(name);
+
+    // 1. Declared props
+    if (component->props) {
+        for (const auto& prop : component->props->props) {
+            PropField field;
+            field.name = prop->name;
+            field.identifier = memberIdentifier(prop->name);
+            field.sourceType = prop->type ? prop->type->typeString : "";
+
+            if (field.sourceType == "number") {
+                field.kind = FieldKind::Number;
+            } else if (field.sourceType == "boolean" || field.sourceType == "bool") {
+                field.kind = FieldKind::Boolean;
+            }
+
+            if (!prop->defaultValue.empty()) {
+                field.initializer = literalFor(field, trimQuotes(prop->defaultValue));
+            }
+
+            result.props.push_back(std::move(field));
+        }
+    }
+
+    // 2. Props referenced by the template but not declared, and slots
+    const TemplateProgram& program = m_html.componentProgram(component);
+    collectExpressionProps(program, result);
+    collectSlots(program, result);
+
+    return m_infos.emplace(component, std::move(result)).first->second;
+}
+
+void SsrGenerator::collectSlots(const TemplateProgram& program, ComponentInfo& info) {
+    for (const auto& instruction : program.instructions()) {
+        if (instruction.op != TemplateOp::Slot) {
+            continue;
+        }
+
+        if (!findSlot(info, instruction.name)) {
+            SlotField slot;
+            slot.name = instruction.name;
+            slot.identifier = instruction.name.empty() ? "children" : memberIdentifier(instruction.name);
+            info.slots.push_back(std::move(slot));
+        }
+
+        collectSlots(*instruction.fallback, info);
+    }
+}
+
+void SsrGenerator::collectExpressionProps(const TemplateProgram& program, ComponentInfo& info) {
+    for (const auto& instruction : program.instructions()) {
+        if (instruction.op == TemplateOp::Slot) {
+            collectExpressionProps(*instruction.fallback, info);
+        }
+
+        if (instruction.op != TemplateOp::Expression || !instruction.expression) {
+            continue;
+        }
+
+        for (const auto& name : instruction.expression->references()) {
+            if (!findProp(info, name)) {
+                PropField field;
+                field.name = name;
+                field.identifier = memberIdentifier(name);
+                info.props.push_back(std::move(field));
+            }
+        }
+    }
+}
+
+std::string SsrGenerator::generateHeader(const ComponentInfo& info, bool isPage) {
+    std::ostringstream code;
+
+    code << "// Generated by artic from " << info.name << ".atc. Do not edit.\n";
+    code << "#pragma once\n\n";
+    code << "#include <functional>\n";
+    code << "#include <string>\n\n";
+    code << "namespace " << m_options.namespaceName << " {\n\n";
+
+    // Props
+    code << "struct " << info.identifier << "Props {\n";
+    for (const auto& field : info.props) {
+        const char* type = field.kind == FieldKind::Number ? "double"
+                         : field.kind == FieldKind::Boolean ? "bool"
+                         : "std::string";
+        code << "    " << type << " " << field.identifier;
+        if (!field.initializer.empty()) {
+            code << " = " << field.initializer;
+        } else if (field.kind == FieldKind::Number) {
+            code << " = 0";
+        } else if (field.kind == FieldKind::Boolean) {
+            code << " = false";
+        }
+        code << ";";
+        if (!field.sourceType.empty() && field.kind == FieldKind::String && field.sourceType != "string") {
+            code << "  // " << field.sourceType;
+        }
+        code << "\n";
+    }
+    code << "};\n\n";
+
+    // Slots
+    code << "struct " << info.identifier << "Slots {\n";
+    for (const auto& slot : info.slots) {
+        code << "    std::function<void(std::string&)> " << slot.identifier << ";";
+        code << (slot.name.empty() ? "  // default slot" : "") << "\n";
+    }
+    code << "};\n\n";
+
+    code << "void render" << info.identifier << "(std::string& out, const " << info.identifier
+         << "Props& props, const " << info.identifier << "Slots& slots = {});\n";
+
+    if (isPage) {
+        code << "void render" << info.identifier << "Page(std::string& out, const " << info.identifier
+             << "Props& props, const " << info.identifier << "Slots& slots = {});\n";
+    }
+
+    code << "\n} // namespace " << m_options.namespaceName << "\n";
+
+    return code.str();
+}
+
+std::string SsrGenerator::generateSource(Component* component, const ComponentInfo& info, bool isPage) {
+    std::ostringstream body;
+    m_dependencies.clear();
+    m_tempCounter = 0;
+
+    body << "void render" << info.identifier << "(std::string& out, const " << info.identifier
+         << "Props& props, const " << info.identifier << "Slots& slots) {\n";
+    body << "    (void)out;\n";
+    body << "    (void)props;\n";
+    body << "    (void)slots;\n";
+    emitProgram(body, m_html.componentProgram(component), &info, "out", 1);
+    body << "}\n";
+
+    if (isPage) {
+        StringSink start;
+        StringSink end;
+        m_html.generateDocumentStart(component, start);
+        m_html.generateDocumentEnd(end);
+
+        body << "\nvoid render" << info.identifier << "Page(std::string& out, const " << info.identifier
+             << "Props& props, const " << info.identifier << "Slots& slots) {\n";
+        emitStatic(body, start.str(), "out", 1);
+        body << "    render" << info.identifier << "(out, props, slots);\n";
+        emitStatic(body, end.str(), "out", 1);
+        body << "}\n";
+    }
+
+    std::ostringstream code;
+    code << "// Generated by artic from " << info.name << ".atc. Do not edit.\n";
+    code << "#include \"" << info.identifier << ".h\"\n";
+
+    std::sort(m_dependencies.begin(), m_dependencies.end());
+    m_dependencies.erase(std::unique(m_dependencies.begin(), m_dependencies.end()), m_dependencies.end());
+    for (const auto& dependency : m_dependencies) {
+        if (dependency != info.identifier) {
+            code << "#include \"" << dependency << ".h\"\n";
+        }
+    }
+
+    code << "#include \"artic_ssr_runtime.h\"\n\n";
+    code << "namespace " << m_options.namespaceName << " {\n\n";
+    code << body.str();
+    code << "\n} // namespace " << m_options.namespaceName << "\n";
+
+    return code.str();
+}
+
+void SsrGenerator::emitProgram(std::ostringstream& code, const TemplateProgram& program,
+                               const ComponentInfo* self, const std::string& out, int depth) {
+    for (const auto& instruction : program.instructions()) {
+        switch (instruction.op) {
+            case TemplateOp::Static:
+                emitStatic(code, program.chunk(instruction), out, depth);
+                break;
+
+            case TemplateOp::Expression: {
+                const PropField* field = self ? findProp(*self, instruction.name) : nullptr;
+                if (!field && self && instruction.expression) {
+                    emitExpression(code, *instruction.expression, program.chunk(instruction), *self, out, depth);
+                } else if (!field) {
+                    // Slot content or unsupported syntax: same fallback as static generation
+                    emitStatic(code, program.chunk(instruction), out, depth);
+                } else if (field->kind == FieldKind::Number) {
+                    code << indent(depth) << "artic_ssr::appendNumber(" << out << ", props." << field->identifier << ");\n";
+                } else if (field->kind == FieldKind::Boolean) {
+                    code << indent(depth) << out << ".append(props." << field->identifier << " ? \"true\" : \"false\");\n";
+                } else {
+                    code << indent(depth) << "artic_ssr::appendEscaped(" << out << ", props." << field->identifier << ");\n";
+                }
+                break;
+            }
+
+            case TemplateOp::Slot: {
+                const SlotField* slot = self ? findSlot(*self, instruction.name) : nullptr;
+                if (!slot) {
+                    emitProgram(code, *instruction.fallback, self, out, depth);
+                    break;
+                }
+
+                code << indent(depth) << "if (slots." << slot->identifier << ") {\n";
+                code << indent(depth + 1) << "slots." << slot->identifier << "(" << out << ");\n";
+                if (instruction.fallback->instructions().empty()) {
+                    code << indent(depth) << "}\n";
+                } else {
+                    code << indent(depth) << "} else {\n";
+                    emitProgram(code, *instruction.fallback, self, out, depth + 1);
+                    code << indent(depth) << "}\n";
+                }
+                break;
+            }
+
+            case TemplateOp::Component:
+                emitComponentCall(code, instruction, self, out, depth);
+                break;
+        }
+    }
+}
+
+void SsrGenerator::emitComponentCall(std::ostringstream& code, const TemplateInstruction& instruction,
+                                     const ComponentInfo* self, const std::string& out, int depth) {
+    const Element* element = instruction.element;
+    const ComponentInfo& callee = info(instruction.component, element->tagName);
+    m_dependencies.push_back(callee.identifier);
+
+    std::string suffix = std::to_string(++m_tempCounter);
+    std::string propsVar = "props" + suffix;
+    std::string slotsVar = "slots" + suffix;
+
+    code << indent(depth) << "{\n";
+    code << indent(depth + 1) << callee.identifier << "Props " << propsVar << ";\n";
+
+    // Props from attributes: literals, or {name} forwarding a prop of the caller
+    for (const auto& attr : element->attributes) {
+        const PropField* field = findProp(callee, attr->name);
+        if (!field) {
+            continue;
+        }
+
+        if (attr->isDynamic && self) {
+            std::string name = attr->value;
+            name.erase(std::remove_if(name.begin(), name.end(), ::isspace), name.end());
+            const PropField* source = findProp(*self, name);
+            if (source && source->kind == field->kind) {
+                code << indent(depth + 1) << propsVar << "." << field->identifier
+                     << " = props." << source->identifier << ";\n";
+                continue;
+            }
+        }
+
+        std::string literal = literalFor(*field, attr->value);
+        if (field->kind == FieldKind::Boolean && attr->value.empty()) {
+            literal = "true";  // <Button disabled>
+        }
+        if (!literal.empty()) {
+            code << indent(depth + 1) << propsVar << "." << field->identifier << " = " << literal << ";\n";
+        }
+    }
+
+    // Slot content from children (rendered without the caller's context)
+    std::vector<std::pair<std::string, std::vector<TemplateNode*>>> slotContent;
+    for (const auto& child : element->children) {
+        std::string slotName;
+        if (child->type == ASTNodeType::ELEMENT) {
+            auto* childElement = static_cast<Element*>(child.get());
+            if (childElement->slotDirective) {
+                slotName = childElement->slotDirective->slotName;
+            }
+        }
+
+        auto group = std::find_if(slotContent.begin(), slotContent.end(),
+            [&](const auto& entry) { return entry.first == slotName; });
+        if (group == slotContent.end()) {
+            slotContent.emplace_back(slotName, std::vector<TemplateNode*>{});
+            group = std::prev(slotContent.end());
+        }
+        group->second.push_back(child.get());
+    }
+
+    // Each lambda appends to its own parameter; a unique name keeps nested
+    // slot content from shadowing the enclosing sink
+    std::string slotOut = "slotOut" + suffix;
+    code << indent(depth + 1) << callee.identifier << "Slots " << slotsVar << ";\n";
+    for (const auto& [slotName, nodes] : slotContent) {
+        const SlotField* slot = findSlot(callee, slotName);
+        if (!slot) {
+            continue;
+        }
+
+        code << indent(depth + 1) << slotsVar << "." << slot->identifier << " = [&](std::string& " << slotOut << ") {\n";
+        emitProgram(code, m_html.nodesProgram(nodes), nullptr, slotOut, depth + 2);
+        code << indent(depth + 1) << "};\n";
+    }
+
+    code << indent(depth + 1) << "render" << callee.identifier << "(" << out << ", " << propsVar << ", " << slotsVar << ");\n";
+    code << indent(depth) << "}\n";
+}
+
+void SsrGenerator::emitExpression(std::ostringstream& code, const TemplateExpression& expression,
+                                  std::string_view fallback, const ComponentInfo& self,
+                                  const std::string& out, int depth) {
+    code << indent(depth) << "if (auto value = " << lowerExpression(expression, expression.root(), self) << ") {\n";
+    code << indent(depth + 1) << "artic_ssr::appendValue(" << out << ", *value);\n";
+    if (fallback.empty()) {
+        code << indent(depth) << "}\n";
+    } else {
+        code << indent(depth) << "} else {\n";
+        emitStatic(code, fallback, out, depth + 1);
+        code << indent(depth) << "}\n";
+    }
+}
+
+std::string SsrGenerator::lowerExpression(const TemplateExpression& expression, int index,
+                                          const ComponentInfo& self) const {
+    using NodeKind = TemplateExpression::NodeKind;
+    const TemplateExpression::Node& node = expression.node(index);
+
+    auto operand = [&](int slot) { return lowerExpression(expression, node.operands[slot], self); };
+    auto lazy = [&](int slot) { return "[&] { return " + operand(slot) + "; }"; };
+
+    switch (node.kind) {
+        case NodeKind::Literal:
+            switch (node.literal.type()) {
+                case ExpressionValue::Type::String:
+                    return "artic_ssr::Value::fromString(" + stringLiteral(node.literal.toString()) + ")";
+                case ExpressionValue::Type::Boolean:
+                    return "artic_ssr::Value::fromBoolean(" + node.literal.toString() + ")";
+                case ExpressionValue::Type::Number: {
+                    // Shortest round-trip form is also a valid C++ literal
+                    char buffer[32];
+                    auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), *node.literal.toNumber());
+                    return "artic_ssr::Value::fromNumber(" + std::string(buffer, ptr) + ")";
+                }
+            }
+            break;
+
+        case NodeKind::Reference: {
+            const PropField* field = findProp(self, node.name);
+            std::string member = "props." + field->identifier;
+            switch (field->kind) {
+                case FieldKind::Number: return "artic_ssr::Value::fromNumber(" + member + ")";
+                case FieldKind::Boolean: return "artic_ssr::Value::fromBoolean(" + member + ")";
+                case FieldKind::String: return "artic_ssr::Value::fromString(" + member + ")";
+            }
+            break;
+        }
+
+        case NodeKind::Unary:
+            return "artic_ssr::unary('" + node.op + "', " + operand(0) + ")";
+
+        case NodeKind::Binary: {
+            if (node.op == "&&" || node.op == "||") {
+                return std::string(node.op == "&&" ? "artic_ssr::logicalAnd(" : "artic_ssr::logicalOr(") +
+                       operand(0) + ", " + lazy(1) + ")";
+            }
+            static const std::pair<std::string_view, std::string_view> OPS[] = {
+                {"+", "Add"}, {"-", "Subtract"}, {"*", "Multiply"}, {"/", "Divide"}, {"%", "Modulo"},
+                {"<", "Less"}, {">", "Greater"}, {"<=", "LessEqual"}, {">=", "GreaterEqual"},
+                {"==", "Equal"}, {"!=", "NotEqual"}, {"===", "StrictEqual"}, {"!==", "StrictNotEqual"}
+            };
+            auto op = std::find_if(std::begin(OPS), std::end(OPS),
+                [&](const auto& entry) { return entry.first == node.op; });
+            return "artic_ssr::binary(artic_ssr::Op::" + std::string(op->second) + ", " +
+                   operand(0) + ", " + operand(1) + ")";
+        }
+
+        case NodeKind::Conditional:
+            return "artic_ssr::conditional(" + operand(0) + ", " + lazy(1) + ", " + lazy(2) + ")";
+    }
+    return "artic_ssr::Result()";
+}
+
+void SsrGenerator::emitStatic(std::ostringstream& code, std::string_view bytes, const std::string& out, int depth) {
+    if (bytes.empty()) {
+        return;
+    }
+
+    code << indent(depth) << out << ".append(" << stringLiteral(bytes) << ", " << bytes.size() << ");\n";
+}
+
+std::string SsrGenerator::literalFor(const PropField& field, const std::string& value) const {
+    switch (field.kind) {
+        case FieldKind::Number: {
+            // Plain decimal literals only (from_chars would also accept inf/nan)
+            if (value.empty() || !(std::isdigit(static_cast<unsigned char>(value[0])) ||
+                                   value[0] == '-' || value[0] == '.')) {
+                return "";
+            }
+            double number = 0;
+            auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), number);
+            if (ec != std::errc() || ptr != value.data() + value.size()) {
+                return "";
+            }
+            return value;
+        }
+
+        case FieldKind::Boolean:
+            if (value == "true" || value == "false") {
+                return value;
+            }
+            return "";
+
+        case FieldKind::String:
+        default:
+            return stringLiteral(value);
+    }
+}
+
+std::string SsrGenerator::generateCMakeLists(const std::vector<std::string>& sources) {
+    std::ostringstream cmake;
+
+    cmake << "# Generated by artic. Do not edit.\n";
+    cmake << "#\n";
+    cmake << "# Native render functions for every component. Add this directory\n";
+    cmake << "# with add_subdirectory() and link " << m_options.libraryName << ".\n\n";
+    cmake << "cmake_minimum_required(VERSION 3.16)\n";
+    cmake << "project(" << m_options.libraryName << " LANGUAGES CXX)\n\n";
+    cmake << "add_library(" << m_options.libraryName << " STATIC\n";
+    for (const auto& source : sources) {
+        cmake << "    " << source << "\n";
+    }
+    cmake << ")\n\n";
+    cmake << "target_include_directories(" << m_options.libraryName << " PUBLIC ${CMAKE_CURRENT_SOURCE_DIR})\n";
+    // Generated sources and artic_ssr_runtime.h are C++17 (string_view is the
+    // newest feature used), so host servers need not move to C++20
+    cmake << "target_compile_features(" << m_options.libraryName << " PUBLIC cxx_std_17)\n";
+
+    return cmake.str();
+}
+
+std::string SsrGenerator::generateRuntime() {
+    return R"(// Generated by artic. Do not edit.
+//
+// Helpers used by generated render functions. Output matches static
+// generation byte for byte: the same escaping rules and number formatting.
+#pragma once
+
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#if defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+#include <emmintrin.h>
+#define ARTIC_SSR_SSE2 1
+#endif
+
+namespace artic_ssr {
+
+// Offset of the first <>& at or after from (text.size() if none).
+// Clean text is skipped 16 bytes per compare where SSE2 is available.
+inline size_t findSpecial(std::string_view text, size_t from) {
+    size_t i = from;
+#if defined(ARTIC_SSR_SSE2)
+    const __m128i amp = _mm_set1_epi8('&');
+    const __m128i lt = _mm_set1_epi8('<');
+    const __m128i gt = _mm_set1_epi8('>');
+    for (; i + 16 <= text.size(); i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + i));
+        __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(block, amp),
+                                    _mm_or_si128(_mm_cmpeq_epi8(block, lt), _mm_cmpeq_epi8(block, gt)));
+        int mask = _mm_movemask_epi8(hits);
+        if (mask != 0) {
+            return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+        }
+    }
+#endif
+    for (; i < text.size(); i++) {
+        char c = text[i];
+        if (c == '<' || c == '>' || c == '&') {
+            return i;
+        }
+    }
+    return text.size();
+}
+
+inline bool isAsciiDigit(char c, bool hex) {
+    return (c >= '0' && c <= '9') ||
+           (hex && ((c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F')));
+}
+
+inline bool isAsciiAlnum(char c) {
+    return isAsciiDigit(c, false) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+// Check if text[pos] == '&' starts a character reference ("&amp;", "&#39;", "&#x27;")
+inline bool isCharacterReference(std::string_view text, size_t pos) {
+    size_t i = pos + 1;
+    if (i < text.size() && text[i] == '#') {
+        i++;
+        bool hex = i < text.size() && (text[i] == 'x' || text[i] == 'X');
+        if (hex) {
+            i++;
+        }
+        size_t digitsStart = i;
+        while (i < text.size() && i - digitsStart < 8 && isAsciiDigit(text[i], hex)) {
+            i++;
+        }
+        return i > digitsStart && i < text.size() && text[i] == ';';
+    }
+
+    if (i >= text.size() || isAsciiDigit(text[i], false) || !isAsciiAlnum(text[i])) {
+        return false;
+    }
+    size_t nameStart = i;
+    while (i < text.size() && i - nameStart < 32 && isAsciiAlnum(text[i])) {
+        i++;
+    }
+    return i < text.size() && text[i] == ';';
+}
+
+// Append element text with <>& replaced by entities; character references
+// already in the text ("&copy;") are kept as written
+inline void appendEscaped(std::string& out, std::string_view text) {
+    size_t start = 0;
+    size_t i = findSpecial(text, 0);
+    while (i < text.size()) {
+        out.append(text.data() + start, i - start);
+        switch (text[i]) {
+            case '<': out.append("&lt;", 4); break;
+            case '>': out.append("&gt;", 4); break;
+            default:
+                if (isCharacterReference(text, i)) {
+                    out += '&';
+                } else {
+                    out.append("&amp;", 5);
+                }
+                break;
+        }
+        start = i + 1;
+        i = findSpecial(text, start);
+    }
+    out.append(text.data() + start, text.size() - start);
+}
+
+// Append a number as JavaScript's String(number) writes it: shortest
+// round-trip digits, positional while the decimal exponent is in [-7, 21)
+inline void appendNumber(std::string& out, double value) {
+    if (std::isnan(value)) {
+        out.append("NaN", 3);
+        return;
+    }
+    if (std::isinf(value)) {
+        out.append(value > 0 ? "Infinity" : "-Infinity");
+        return;
+    }
+    if (value == 0) {
+        out += '0';
+        return;
+    }
+
+    char buffer[40];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::scientific);
+    std::string_view scientific(buffer, static_cast<size_t>(result.ptr - buffer));
+    if (scientific.front() == '-') {
+        out += '-';
+        scientific.remove_prefix(1);
+    }
+
+    size_t e = scientific.find('e');
+    std::string digits;
+    for (char c : scientific.substr(0, e)) {
+        if (c != '.') {
+            digits += c;
+        }
+    }
+    std::string_view exponent = scientific.substr(e + 1);
+    if (exponent.front() == '+') {
+        exponent.remove_prefix(1);
+    }
+    int n = 0;
+    std::from_chars(exponent.data(), exponent.data() + exponent.size(), n);
+    n++;
+    int k = static_cast<int>(digits.size());
+
+    if (k <= n && n <= 21) {
+        out += digits;
+        out.append(static_cast<size_t>(n - k), '0');
+    } else if (0 < n && n <= 21) {
+        out.append(digits, 0, static_cast<size_t>(n));
+        out += '.';
+        out.append(digits, static_cast<size_t>(n), std::string::npos);
+    } else if (-6 < n && n <= 0) {
+        out.append("0.", 2);
+        out.append(static_cast<size_t>(-n), '0');
+        out += digits;
+    } else {
+        out += digits[0];
+        if (k > 1) {
+            out += '.';
+            out.append(digits, 1, std::string::npos);
+        }
+        out.append(n - 1 < 0 ? "e-" : "e+", 2);
+        out += std::to_string(std::abs(n - 1));
+    }
+}
+
+// ===== Template expressions =====
+//
+// Expressions other than a bare {prop} are lowered to calls below, which
+// follow the compiler's evaluator: JavaScript-like concatenation, truthiness
+// and loose equality. An empty result renders the expression's placeholder.
+
+struct Value {
+    enum class Type { String, Number, Boolean };
+
+    Type type = Type::String;
+    std::string text;
+    double number = 0;
+    bool flag = false;
+
+    static Value fromString(std::string value) {
+        Value result;
+        result.text = std::move(value);
+        return result;
+    }
+
+    static Value fromNumber(double value) {
+        Value result;
+        result.type = Type::Number;
+        result.number = value;
+        return result;
+    }
+
+    static Value fromBoolean(bool value) {
+        Value result;
+        result.type = Type::Boolean;
+        result.flag = value;
+        return result;
+    }
+};
+
+using Result = std::optional<Value>;
+
+enum class Op {
+    Add, Subtract, Multiply, Divide, Modulo,
+    Less, Greater, LessEqual, GreaterEqual,
+    Equal, NotEqual, StrictEqual, StrictNotEqual
+};
+
+inline bool truthy(const Value& value) {
+    switch (value.type) {
+        case Value::Type::String: return !value.text.empty();
+        case Value::Type::Number: return value.number != 0 && !std::isnan(value.number);
+        case Value::Type::Boolean: return value.flag;
+    }
+    return false;
+}
+
+inline std::optional<double> toNumber(const Value& value) {
+    switch (value.type) {
+        case Value::Type::Number:
+            return value.number;
+        case Value::Type::Boolean:
+            return value.flag ? 1.0 : 0.0;
+        case Value::Type::String: {
+            double number = 0;
+            const char* end = value.text.data() + value.text.size();
+            auto result = std::from_chars(value.text.data(), end, number);
+            if (value.text.empty() || result.ec != std::errc() || result.ptr != end) {
+                return std::nullopt;
+            }
+            return number;
+        }
+    }
+    return std::nullopt;
+}
+
+inline std::string toString(const Value& value) {
+    switch (value.type) {
+        case Value::Type::String: return value.text;
+        case Value::Type::Boolean: return value.flag ? "true" : "false";
+        case Value::Type::Number: break;
+    }
+    std::string text;
+    appendNumber(text, value.number);
+    return text;
+}
+
+inline bool strictEqual(const Value& left, const Value& right) {
+    if (left.type != right.type) {
+        return false;
+    }
+    switch (left.type) {
+        case Value::Type::String: return left.text == right.text;
+        case Value::Type::Number: return left.number == right.number;
+        case Value::Type::Boolean: return left.flag == right.flag;
+    }
+    return false;
+}
+
+inline Result unary(char op, const Result& operand) {
+    if (!operand) {
+        return std::nullopt;
+    }
+    if (op == '!') {
+        return Value::fromBoolean(!truthy(*operand));
+    }
+    auto number = toNumber(*operand);
+    if (!number) {
+        return std::nullopt;
+    }
+    return Value::fromNumber(op == '-' ? -*number : *number);
+}
+
+inline Result binary(Op op, const Result& left, const Result& right) {
+    if (!left || !right) {
+        return std::nullopt;
+    }
+
+    // String concatenation wins over addition
+    if (op == Op::Add && (left->type == Value::Type::String || right->type == Value::Type::String)) {
+        return Value::fromString(toString(*left) + toString(*right));
+    }
+
+    if (op == Op::Equal || op == Op::NotEqual || op == Op::StrictEqual || op == Op::StrictNotEqual) {
+        bool equal = strictEqual(*left, *right);
+        // Loose equality compares mixed types numerically: "3" == 3
+        if (!equal && (op == Op::Equal || op == Op::NotEqual) && left->type != right->type) {
+            auto a = toNumber(*left);
+            auto b = toNumber(*right);
+            equal = a && b && *a == *b;
+        }
+        return Value::fromBoolean(equal != (op == Op::NotEqual || op == Op::StrictNotEqual));
+    }
+
+    if (op == Op::Less || op == Op::Greater || op == Op::LessEqual || op == Op::GreaterEqual) {
+        int order = 0;
+        if (left->type == Value::Type::String && right->type == Value::Type::String) {
+            int cmp = left->text.compare(right->text);
+            order = cmp < 0 ? -1 : (cmp > 0 ? 1 : 0);
+        } else {
+            auto a = toNumber(*left);
+            auto b = toNumber(*right);
+            if (!a || !b) {
+                return std::nullopt;
+            }
+            if (std::isnan(*a) || std::isnan(*b)) {
+                return Value::fromBoolean(false);
+            }
+            order = *a < *b ? -1 : (*a > *b ? 1 : 0);
+        }
+        switch (op) {
+            case Op::Less: return Value::fromBoolean(order < 0);
+            case Op::Greater: return Value::fromBoolean(order > 0);
+            case Op::LessEqual: return Value::fromBoolean(order <= 0);
+            default: return Value::fromBoolean(order >= 0);
+        }
+    }
+
+    auto a = toNumber(*left);
+    auto b = toNumber(*right);
+    if (!a || !b) {
+        return std::nullopt;
+    }
+    switch (op) {
+        case Op::Add: return Value::fromNumber(*a + *b);
+        case Op::Subtract: return Value::fromNumber(*a - *b);
+        case Op::Multiply: return Value::fromNumber(*a * *b);
+        default: break;
+    }
+
+    // Division by zero keeps the placeholder, as in static generation
+    if (*b == 0) {
+        return std::nullopt;
+    }
+    return Value::fromNumber(op == Op::Divide ? *a / *b : std::fmod(*a, *b));
+}
+
+// && and || yield the deciding operand; the right side runs only if needed
+template <typename Right>
+Result logicalAnd(const Result& left, Right right) {
+    if (!left) {
+        return std::nullopt;
+    }
+    return truthy(*left) ? Result(right()) : left;
+}
+
+template <typename Right>
+Result logicalOr(const Result& left, Right right) {
+    if (!left) {
+        return std::nullopt;
+    }
+    return truthy(*left) ? left : Result(right());
+}
+
+template <typename WhenTrue, typename WhenFalse>
+Result conditional(const Result& condition, WhenTrue whenTrue, WhenFalse whenFalse) {
+    if (!condition) {
+        return std::nullopt;
+    }
+    return truthy(*condition) ? Result(whenTrue()) : Result(whenFalse());
+}
+
+inline void appendValue(std::string& out, const Value& value) {
+    appendEscaped(out, toString(value));
+}
+
+} // namespace artic_ssr
+)";
+}
+
+const SsrGenerator::PropField* SsrGenerator::findProp(const ComponentInfo& info, const std::string& name) {
+    for (const auto& field : info.props) {
+        if (field.name == name) {
+            return &field;
+        }
+    }
+    return nullptr;
+}
+
+const SsrGenerator::SlotField* SsrGenerator::findSlot(const ComponentInfo& info, const std::string& name) {
+    for (const auto& slot : info.slots) {
+        if (slot.name == name) {
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+std::string SsrGenerator::typeIdentifier(const std::string& name) {
+    std::string identifier;
+    for (char c : name) {
+        identifier += std::isalnum(static_cast<unsigned char>(c)) ? c : '_';
+    }
+
+    if (identifier.empty() || std::isdigit(static_cast<unsigned char>(identifier[0]))) {
+        identifier = "_" + identifier;
+    }
+    identifier[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(identifier[0])));
+
+    return identifier;
+}
+
+std::string SsrGenerator::memberIdentifier(const std::string& name) {
+    std::string identifier;
+    for (char c : name) {
+        identifier += std::isalnum(static_cast<unsigned char>(c)) ? c : '_';
+    }
+
+    if (identifier.empty() || std::isdigit(static_cast<unsigned char>(identifier[0]))) {
+        identifier = "_" + identifier;
+    }
+    if (CPP_KEYWORDS.count(identifier)) {
+        identifier += "_";
+    }
+
+    return identifier;
+}
+
+std::string SsrGenerator::stringLiteral(std::string_view bytes) {
+    static constexpr size_t LINE_WIDTH = 100;
+
+    std::string literal = "\"";
+    size_t lineLength = 0;
+
+    for (size_t i = 0; i < bytes.size(); i++) {
+        unsigned char c = static_cast<unsigned char>(bytes[i]);
+
+        switch (c) {
+            case '"': literal += "\\\""; break;
+            case '\\': literal += "\\\\"; break;
+            case '\n': literal += "\\n"; break;
+            case '\t': literal += "\\t"; break;
+            case '\r': literal += "\\r"; break;
+            case '?': literal += "\\?"; break;  // No trigraphs
+            default:
+                if (c < 0x20 || c == 0x7f) {
+                    // Three-digit octal escapes never swallow following digits
+                    char escape[5];
+                    std::snprintf(escape, sizeof(escape), "\\%03o", c);
+                    literal += escape;
+                } else {
+                    literal += static_cast<char>(c);
+                }
+                break;
+        }
+
+        // Split long chunks across lines (adjacent literals concatenate)
+        if (++lineLength >= LINE_WIDTH && i + 1 < bytes.size() && (c == '\n' || c == '>' || c == ' ')) {
+            literal += "\"\n        \"";
+            lineLength = 0;
+        }
+    }
+
+    literal += "\"";
+    return literal;
+}
+
+std::string SsrGenerator::indent(int depth) {
+    return std::string(static_cast<size_t>(depth) * 4, ' ');
+}
+
+} // namespace artic
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "frontend/ast/Component.h"
+#include "backend/html/HtmlGenerator.h"
+#include "backend/html/TemplateProgram.h"
+
+namespace artic {
+
+// Forward declarations
+class ComponentRegistry;
+class ClassNameMangler;
+
+/**
+ * @brief Options for SSR code generation
+ */
+struct SsrGeneratorOptions {
+    bool minify = false;                      // Minified static HTML (otherwise compact)
+    bool includeDoctype = true;               // Include <!DOCTYPE html> in page functions
+    std::string cssFile = "style.css";        // CSS file linked from page functions
+    std::string namespaceName = "artic_pages"; // C++ namespace for generated code
+    std::string libraryName = "artic_pages";   // CMake target name
+    const ClassNameMangler* classMangler = nullptr; // Short class names (must match CSS)
+};
+
+/**
+ * @brief A generated source file (name relative to the SSR output directory)
+ */
+struct GeneratedFile {
+    std::string name;
+    std::string contents;
+};
+
+/**
+ * @brief SSR Generator - Converts components to native C++ render functions
+ *
+ * Each component's TemplateProgram is emitted as straight-line C++:
+ * static chunks become string appends, prop holes become escaped appends
+ * of typed fields, other expressions become calls into the runtime's
+ * evaluator, slots become optional callbacks and nested components become
+ * direct calls.
+ *
+ * props { title: string, count?: number = 0 }
+ * <h1>{title}</h1>
+ *
+ * →
+ *
+ * struct CardProps { std::string title; double count = 0; };
+ * void renderCard(std::string& out, const CardProps& props, const CardSlots& slots) {
+ *     out.append("<h1>", 4);
+ *     artic_ssr::appendEscaped(out, props.title);
+ *     out.append("</h1>", 5);
+ * }
+ *
+ * Output is always depth-independent (compact or minified), so one
+ * function serves every use site.
+ */
+class SsrGenerator {
+public:
+    SsrGenerator(const SsrGeneratorOptions& options, const ComponentRegistry& registry);
+
+    /**
+     * @brief Generate sources for the page and every component it imports
+     * @param root Page component (also gets a render<Name>Page function)
+     * @return Headers, sources, runtime header and CMakeLists.txt
+     */
+    std::vector<GeneratedFile> generate(Component* root);
+
+    /**
+     * @brief Convert a name to a C++ type-style identifier ("my-card" → "My_card")
+     */
+    static std::string typeIdentifier(const std::string& name);
+
+private:
+    enum class FieldKind { String, Number, Boolean };
+
+    struct PropField {
+        std::string name;        // Prop name in templates
+        std::string identifier;  // C++ member name
+        FieldKind kind = FieldKind::String;
+        std::string initializer; // Default value (C++ expression), may be empty
+        std::string sourceType;  // Declared type, for the generated comment
+    };
+
+    struct SlotField {
+        std::string name;        // Slot name ("" = default slot)
+        std::string identifier;  // C++ member name
+    };
+
+    struct ComponentInfo {
+        std::string name;        // Registry name (file stem)
+        std::string identifier;  // C++ identifier
+        std::vector<PropField> props;
+        std::vector<SlotField> slots;
+    };
+
+    SsrGeneratorOptions m_options;
+    const ComponentRegistry& m_registry;
+    HtmlGenerator m_html;
+    std::unordered_map<const Component*, ComponentInfo> m_infos;
+    std::vector<std::string> m_dependencies;  // Components called by the current source
+    int m_tempCounter = 0;
+
+    const ComponentInfo& info(Component* component, const std::string& name);
+    void collectSlots(const TemplateProgram& program, ComponentInfo& info);
+    void collectExpressionProps(const TemplateProgram& program, ComponentInfo& info);
+
+    std::string generateHeader(const ComponentInfo& info, bool isPage);
+    std::string generateSource(Component* component, const ComponentInfo& info, bool isPage);
+    std::string generateCMakeLists(const std::vector<std::string>& sources);
+    static std::string generateRuntime();
+
+    // Emit C++ statements for a program; self = component whose props and
+    // slots are in scope (nullptr for slot content, which renders without context),
+    // out = name of the std::string being appended to
+    void emitProgram(std::ostringstream& code, const TemplateProgram& program,
+                     const ComponentInfo* self, const std::string& out, int depth);
+    void emitStatic(std::ostringstream& code, std::string_view bytes, const std::string& out, int depth);
+    void emitExpression(std::ostringstream& code, const TemplateExpression& expression,
+                        std::string_view fallback, const ComponentInfo& self,
+                        const std::string& out, int depth);
+    // C++ expression of type artic_ssr::Result for one node of the tree
+    std::string lowerExpression(const TemplateExpression& expression, int index,
+                                const ComponentInfo& self) const;
+    void emitComponentCall(std::ostringstream& code, const TemplateInstruction& instruction,
+                           const ComponentInfo* self, const std::string& out, int depth);
+    std::string literalFor(const PropField& field, const std::string& value) const;
+
+    static const PropField* findProp(const ComponentInfo& info, const std::string& name);
+    static const SlotField* findSlot(const ComponentInfo& info, const std::string& name);
+    static std::string memberIdentifier(const std::string& name);
+    static std::string stringLiteral(std::string_view bytes);
+    static std::string indent(int depth);
+};
+
+} // namespace artic
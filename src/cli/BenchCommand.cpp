@@ -0,0 +1,379 @@
+#include "cli/BenchCommand.h"
+#include "compiler/Compiler.h"
+#include "compiler/CompilationProfile.h"
+#include "backend/css/UtilityCache.h"
+#include "shared/utils/MemoryStats.h"
+#include "shared/utils/Metrics.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace artic::cli {
+
+namespace {
+
+struct BenchOptions {
+    std::string input;
+    int iterations = 20;
+    int warmup = 2;
+    bool json = false;
+    std::string metricsFile;  // Prometheus text of every iteration (empty = off)
+    size_t memoryBudget = 0;  // Adds the "shared" variant (0 = off)
+    CompilerOptions compiler;
+};
+
+// Row "total" follows the pipeline phases
+constexpr size_t TOTAL_ROW = COMPILATION_PHASE_COUNT;
+
+/**
+ * @brief Per-iteration samples of one variant
+ */
+struct VariantResult {
+    std::string name;
+    std::string description;
+    std::vector<std::vector<double>> samples;  // [phase or TOTAL_ROW][iteration], milliseconds
+    AllocationCounts allocations;              // Summed over the measured iterations
+};
+
+void printBenchUsage() {
+    std::cout << "Usage: artic bench <file|dir> [options]\n\n";
+    std::cout << "Compile repeatedly in-process and report per-phase latency.\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --iterations <n>     Measured iterations (default: 20)\n";
+    std::cout << "  --warmup <n>         Unmeasured iterations first (default: 2)\n";
+    std::cout << "  --json               Machine-readable output\n";
+    std::cout << "  --metrics <file>     Write compiler metrics (Prometheus text format)\n";
+    std::cout << "  --memory-budget <n>  Also bench one registry shared by all pages, bounded to n[kb|mb]\n";
+    std::cout << "  --minify-css         Minify CSS output\n";
+    std::cout << "  --minify-html        Minify HTML output\n";
+    std::cout << "  --mangle-classes     Shorten utility class names\n";
+    std::cout << "  --max-depth <n>      Maximum element/component nesting (default: 1024)\n";
+}
+
+bool parsePositive(int argc, char* argv[], int& i, int& value, const char* option) {
+    if (i + 1 < argc && std::atoi(argv[i + 1]) > 0) {
+        value = std::atoi(argv[++i]);
+        return true;
+    }
+    std::cerr << "Error: " << option << " expects a positive number\n";
+    return false;
+}
+
+bool parseOptions(int argc, char* argv[], BenchOptions& options) {
+    if (argc < 3) {
+        std::cerr << "Error: Missing file or directory\n";
+        std::cerr << "Usage: artic bench <file|dir> [--iterations N]\n";
+        return false;
+    }
+
+    options.input = argv[2];
+    options.compiler.silent = true;
+
+    for (int i = 3; i < argc; i++) {
+        std::string arg = argv[i];
+
+        if (arg == "--iterations" || arg == "-n") {
+            if (!parsePositive(argc, argv, i, options.iterations, "--iterations")) {
+                return false;
+            }
+        } else if (arg == "--warmup") {
+            // Zero warm-up iterations is allowed
+            if (i + 1 < argc && std::atoi(argv[i + 1]) >= 0) {
+                options.warmup = std::atoi(argv[++i]);
+            } else {
+                std::cerr << "Error: --warmup expects a number\n";
+                return false;
+            }
+        } else if (arg == "--json") {
+            options.json = true;
+        } else if (arg == "--memory-budget") {
+            auto budget = i + 1 < argc ? parseByteSize(argv[i + 1]) : std::nullopt;
+            if (!budget || *budget == 0) {
+                std::cerr << "Error: --memory-budget expects a size, e.g. 64mb\n";
+                return false;
+            }
+            options.memoryBudget = *budget;
+            i++;
+        } else if (arg == "--metrics") {
+            if (i + 1 < argc) {
+                options.metricsFile = argv[++i];
+            } else {
+                std::cerr << "Error: Missing metrics file\n";
+                return false;
+            }
+        } else if (arg == "--minify-css") {
+            options.compiler.minifyCss = true;
+        } else if (arg == "--minify-html") {
+            options.compiler.minifyHtml = true;
+        } else if (arg == "--mangle-classes") {
+            options.compiler.mangleClassNames = true;
+        } else if (arg == "--max-depth") {
+            int depth = 0;
+            if (!parsePositive(argc, argv, i, depth, "--max-depth")) {
+                return false;
+            }
+            options.compiler.maxTemplateDepth = static_cast<size_t>(depth);
+        } else {
+            std::cerr << "Warning: Unknown option '" << arg << "'\n";
+        }
+    }
+
+    return true;
+}
+
+std::vector<std::string> collectInputs(const std::string& input) {
+    std::vector<std::string> files;
+
+    if (std::filesystem::is_directory(input)) {
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(input)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".atc") {
+                files.push_back(entry.path().string());
+            }
+        }
+        std::sort(files.begin(), files.end());
+    } else if (std::filesystem::is_regular_file(input)) {
+        files.push_back(input);
+    }
+
+    return files;
+}
+
+double toMilliseconds(std::chrono::nanoseconds time) {
+    return std::chrono::duration<double, std::milli>(time).count();
+}
+
+// Nearest-rank percentile of sorted samples
+double percentile(const std::vector<double>& sorted, double p) {
+    size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * static_cast<double>(sorted.size())));
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+/**
+ * @brief Run one variant
+ * @param compileAll Compiles every file once, adding phase times to profile
+ * @return false if a compilation failed
+ */
+template <typename CompileAll>
+bool runVariant(const BenchOptions& options, VariantResult& result, CompileAll&& compileAll) {
+    result.samples.assign(COMPILATION_PHASE_COUNT + 1, {});
+
+    for (int i = 0; i < options.warmup + options.iterations; i++) {
+        bool measured = i >= options.warmup;
+        CompilationProfile profile;
+
+        AllocationCounts before = MemoryStats::allocations();
+        auto start = std::chrono::steady_clock::now();
+        if (!compileAll(profile)) {
+            return false;
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        AllocationCounts after = MemoryStats::allocations();
+
+        if (!measured) {
+            continue;
+        }
+
+        for (size_t phase = 0; phase < COMPILATION_PHASE_COUNT; phase++) {
+            result.samples[phase].push_back(toMilliseconds(profile.time[phase]));
+        }
+        result.samples[TOTAL_ROW].push_back(
+            toMilliseconds(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)));
+        result.allocations += after - before;
+    }
+
+    for (auto& samples : result.samples) {
+        std::sort(samples.begin(), samples.end());
+    }
+    return true;
+}
+
+bool compileFile(Compiler& compiler, const std::string& file, CompilationProfile& profile) {
+    CompilationResult result = compiler.compileToString();
+    if (!result.success) {
+        std::cerr << "Error: " << file << ": " << result.errorMessage << "\n";
+        return false;
+    }
+
+    for (size_t phase = 0; phase < COMPILATION_PHASE_COUNT; phase++) {
+        profile.time[phase] += compiler.profile().time[phase];
+    }
+    return true;
+}
+
+const char* rowName(size_t row) {
+    return row == TOTAL_ROW ? "total" : phaseName(static_cast<CompilationPhase>(row));
+}
+
+void printText(const BenchOptions& options, size_t fileCount, const std::vector<VariantResult>& variants) {
+    std::cout << "artic bench: " << fileCount << (fileCount == 1 ? " file, " : " files, ")
+              << options.iterations << " iterations (+" << options.warmup << " warm-up)\n";
+
+    for (const auto& variant : variants) {
+        std::cout << "\n" << variant.name << ": " << variant.description << "\n";
+        std::printf("  %-8s %12s %12s %12s %12s\n", "phase", "min", "median", "p95", "p99");
+
+        for (size_t row = 0; row < variant.samples.size(); row++) {
+            const auto& samples = variant.samples[row];
+            std::printf("  %-8s %9.3f ms %9.3f ms %9.3f ms %9.3f ms\n", rowName(row),
+                        samples.front(), percentile(samples, 50), percentile(samples, 95),
+                        percentile(samples, 99));
+        }
+
+        double iterations = static_cast<double>(options.iterations);
+        if (MemoryStats::available()) {
+            std::printf("  allocations: %.0f per iteration (%.2f MB)\n",
+                        static_cast<double>(variant.allocations.count) / iterations,
+                        static_cast<double>(variant.allocations.bytes) / iterations / 1e6);
+        } else {
+            std::printf("  allocations: n/a (configure with -DARTIC_MEMORY_PROFILING=ON)\n");
+        }
+    }
+
+    std::printf("\npeak RSS: %.1f MB\n", static_cast<double>(MemoryStats::peakResidentBytes()) / 1e6);
+}
+
+void printJson(const BenchOptions& options, size_t fileCount, const std::vector<VariantResult>& variants) {
+    std::cout << "{\n";
+    std::cout << "  \"files\": " << fileCount << ",\n";
+    std::cout << "  \"iterations\": " << options.iterations << ",\n";
+    std::cout << "  \"warmup\": " << options.warmup << ",\n";
+    std::cout << "  \"variants\": [\n";
+
+    for (size_t v = 0; v < variants.size(); v++) {
+        const auto& variant = variants[v];
+        std::cout << "    {\n      \"name\": \"" << variant.name << "\",\n      \"phases\": {\n";
+
+        for (size_t row = 0; row < variant.samples.size(); row++) {
+            const auto& samples = variant.samples[row];
+            std::cout << "        \"" << rowName(row) << "\": {\"min_ms\": " << samples.front()
+                      << ", \"median_ms\": " << percentile(samples, 50)
+                      << ", \"p95_ms\": " << percentile(samples, 95)
+                      << ", \"p99_ms\": " << percentile(samples, 99) << "}"
+                      << (row + 1 < variant.samples.size() ? ",\n" : "\n");
+        }
+
+        std::cout << "      },\n";
+        // null when the build does not count allocations
+        auto perIteration = [&](std::uint64_t total) {
+            return MemoryStats::available() ? std::to_string(total / static_cast<std::uint64_t>(options.iterations))
+                                            : std::string("null");
+        };
+        std::cout << "      \"allocations_per_iteration\": " << perIteration(variant.allocations.count) << ",\n";
+        std::cout << "      \"allocated_bytes_per_iteration\": " << perIteration(variant.allocations.bytes) << "\n";
+        std::cout << "    }" << (v + 1 < variants.size() ? ",\n" : "\n");
+    }
+
+    std::cout << "  ],\n";
+    std::cout << "  \"peak_rss_bytes\": " << MemoryStats::peakResidentBytes() << "\n";
+    std::cout << "}\n";
+}
+
+} // namespace
+
+int benchCommand(int argc, char* argv[]) {
+    if (argc >= 3 && (std::string(argv[2]) == "--help" || std::string(argv[2]) == "-h")) {
+        printBenchUsage();
+        return 0;
+    }
+
+    BenchOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    std::vector<std::string> files = collectInputs(options.input);
+    if (files.empty()) {
+        std::cerr << "Error: No .atc files found at " << options.input << "\n";
+        return 1;
+    }
+
+    // Counters accumulate over warm-up and measured iterations of both variants
+    MetricsRegistry metrics;
+    if (!options.metricsFile.empty()) {
+        options.compiler.metrics = &metrics;
+    }
+
+    auto compilerOptionsFor = [&](const std::string& file) {
+        CompilerOptions compilerOptions = options.compiler;
+        compilerOptions.inputFile = file;
+        return compilerOptions;
+    };
+
+    std::vector<VariantResult> variants(2);
+
+    // Cold: nothing survives between iterations
+    variants[0].name = "cold";
+    variants[0].description = "new compiler and empty utility cache per iteration";
+    bool ok = runVariant(options, variants[0], [&](CompilationProfile& profile) {
+        UtilityCache::shared().clear();
+        for (const auto& file : files) {
+            Compiler compiler(compilerOptionsFor(file));
+            if (!compileFile(compiler, file, profile)) {
+                return false;
+            }
+        }
+        return true;
+    });
+
+    // Warm: each page keeps its compiler, so components are loaded once
+    std::vector<std::unique_ptr<Compiler>> compilers;
+    for (const auto& file : files) {
+        compilers.push_back(std::make_unique<Compiler>(compilerOptionsFor(file)));
+    }
+
+    variants[1].name = "warm";
+    variants[1].description = "components stay loaded between iterations";
+    ok = ok && runVariant(options, variants[1], [&](CompilationProfile& profile) {
+        for (size_t i = 0; i < files.size(); i++) {
+            if (!compileFile(*compilers[i], files[i], profile)) {
+                return false;
+            }
+        }
+        return true;
+    });
+
+    // Shared: one bounded registry for the whole site, as a large site build would
+    if (ok && options.memoryBudget > 0) {
+        ComponentRegistry registry;
+        registry.setMemoryBudget(options.memoryBudget);
+
+        VariantResult shared;
+        shared.name = "shared";
+        shared.description = "one registry for all pages, memory budget " + formatBytes(options.memoryBudget);
+        ok = runVariant(options, shared, [&](CompilationProfile& profile) {
+            for (const auto& file : files) {
+                Compiler compiler(compilerOptionsFor(file), registry);
+                if (!compileFile(compiler, file, profile)) {
+                    return false;
+                }
+            }
+            return true;
+        });
+        variants.push_back(std::move(shared));
+    }
+
+    if (!ok) {
+        return 1;
+    }
+
+    if (options.json) {
+        printJson(options, files.size(), variants);
+    } else {
+        printText(options, files.size(), variants);
+    }
+
+    if (!options.metricsFile.empty() && !metrics.writePrometheus(options.metricsFile)) {
+        std::cerr << "Error: Failed to write metrics: " << options.metricsFile << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace artic::cli
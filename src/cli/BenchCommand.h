@@ -0,0 +1,21 @@
+#pragma once
+
+namespace artic::cli {
+
+/**
+ * @brief artic bench <file|dir> [options]
+ *
+ * Compiles the input repeatedly in-process and reports min/median/p95/p99
+ * per phase, allocations per iteration and peak RSS, for two variants:
+ *
+ *   cold    New compiler (empty registry, empty utility cache) per iteration
+ *   warm    One compiler per page; components stay loaded between iterations
+ *   shared  With --memory-budget: one registry for every page, bounded
+ *
+ * A directory compiles every .atc file below it as a page.
+ *
+ * @return Process exit code
+ */
+int benchCommand(int argc, char* argv[]);
+
+} // namespace artic::cli
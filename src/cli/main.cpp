@@ -1,10 +1,13 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <cstdlib>
 
 #include "frontend/lexer/Lexer.h"
 #include "compiler/Compiler.h"
 #include "compiler/CompilerOptions.h"
+#include "shared/utils/Metrics.h"
+#include "cli/BenchCommand.h"
 
 void printUsage() {
     std::cout << "Artic Compiler v0.1.0 (Phase 1 - SSG)\n";
@@ -12,13 +15,26 @@ void printUsage() {
     std::cout << "Commands:\n";
     std::cout << "  lex <file>           Tokenize file and display tokens\n";
     std::cout << "  build <file>         Build Artic file to HTML + CSS\n";
+    std::cout << "  bench <file|dir>     Compile repeatedly and report per-phase latency\n";
     std::cout << "  help                 Show this help message\n\n";
     std::cout << "Build options:\n";
     std::cout << "  -o, --output <dir>   Output directory (default: dist)\n";
-    std::cout << "  -v, --verbose        Verbose output\n";
+    std::cout << "  -v, --verbose        Verbose output (with time/allocations per phase)\n";
+    std::cout << "  --profile <file>     Write time/allocations per phase and file as JSON\n";
+    std::cout << "  --render-profile <p> Per-component render costs: <p>.txt, <p>.bytes.folded, <p>.time.folded\n";
+    std::cout << "  --report             Print output sizes (raw and gzip) and the largest contributors\n";
+    std::cout << "  --budget <spec>      Fail when an output is too large: [/route:]html|html-gzip|css|css-gzip=<n>[kb|mb]\n";
+    std::cout << "  --metrics <file>     Write compiler metrics (Prometheus text format)\n";
     std::cout << "  --minify-css         Minify CSS output\n";
     std::cout << "  --minify-html        Minify HTML output\n";
     std::cout << "  --no-doctype         Don't include <!DOCTYPE html>\n";
+    std::cout << "  --mangle-classes     Shorten utility class names (writes class-map.json)\n";
+    std::cout << "  --ssr                Generate C++ render functions (dist/ssr) instead of HTML\n";
+    std::cout << "  --stream             Write each top-level node as it is parsed (very large pages)\n";
+    std::cout << "  --max-depth <n>      Maximum element/component nesting (default: 1024)\n\n";
+    std::cout << "Bench options (see artic bench --help):\n";
+    std::cout << "  -n, --iterations <n> Measured iterations (default: 20)\n";
+    std::cout << "  --json               Machine-readable output\n";
 }
 
 std::string readFile(const std::string& filename) {
@@ -51,16 +67,17 @@ void lexCommand(const std::string& filename) {
     }
 }
 
-void buildCommand(int argc, char* argv[]) {
+bool buildCommand(int argc, char* argv[]) {
     if (argc < 3) {
         std::cerr << "Error: Missing filename\n";
         std::cerr << "Usage: artic build <file> [options]\n";
-        return;
+        return false;
     }
 
     // Parse options
     artic::CompilerOptions options;
     options.inputFile = argv[2];
+    std::string metricsFile;
 
     // Parse additional arguments
     for (int i = 3; i < argc; i++) {
@@ -72,16 +89,61 @@ void buildCommand(int argc, char* argv[]) {
                 i++;
             } else {
                 std::cerr << "Error: Missing output directory\n";
-                return;
+                return false;
             }
         } else if (arg == "-v" || arg == "--verbose") {
             options.verbose = true;
+        } else if (arg == "--report") {
+            options.sizeReport = true;
+        } else if (arg == "--budget") {
+            auto budget = i + 1 < argc ? artic::SizeBudget::parse(argv[i + 1]) : std::nullopt;
+            if (!budget) {
+                std::cerr << "Error: --budget expects [/route:]metric=size, e.g. html-gzip=20kb\n";
+                return false;
+            }
+            options.budgets.push_back(*budget);
+            i++;
+        } else if (arg == "--render-profile") {
+            if (i + 1 < argc) {
+                options.renderProfilePrefix = argv[++i];
+            } else {
+                std::cerr << "Error: Missing render profile prefix\n";
+                return false;
+            }
+        } else if (arg == "--profile") {
+            if (i + 1 < argc) {
+                options.profileFile = argv[++i];
+            } else {
+                std::cerr << "Error: Missing profile file\n";
+                return false;
+            }
+        } else if (arg == "--metrics") {
+            if (i + 1 < argc) {
+                metricsFile = argv[++i];
+            } else {
+                std::cerr << "Error: Missing metrics file\n";
+                return false;
+            }
         } else if (arg == "--minify-css") {
             options.minifyCss = true;
         } else if (arg == "--minify-html") {
             options.minifyHtml = true;
         } else if (arg == "--no-doctype") {
             options.includeDoctype = false;
+        } else if (arg == "--mangle-classes") {
+            options.mangleClassNames = true;
+        } else if (arg == "--ssr") {
+            options.mode = artic::CompilationMode::SSR;
+        } else if (arg == "--stream") {
+            options.streamTemplate = true;
+        } else if (arg == "--max-depth") {
+            if (i + 1 < argc && std::atoi(argv[i + 1]) > 0) {
+                options.maxTemplateDepth = static_cast<size_t>(std::atoi(argv[i + 1]));
+                i++;
+            } else {
+                std::cerr << "Error: --max-depth expects a positive number\n";
+                return false;
+            }
         } else {
             std::cerr << "Warning: Unknown option '" << arg << "'\n";
         }
@@ -91,15 +153,28 @@ void buildCommand(int argc, char* argv[]) {
     std::cout << "Artic Compiler - Phase 1 (SSG)\n";
     std::cout << "================================\n\n";
 
+    artic::MetricsRegistry metrics;
+    if (!metricsFile.empty()) {
+        options.metrics = &metrics;
+    }
+
     artic::Compiler compiler(options);
     bool success = compiler.compile();
 
+    // Failed builds are counted too
+    if (!metricsFile.empty() && !metrics.writePrometheus(metricsFile)) {
+        std::cerr << "Error: Failed to write metrics: " << metricsFile << "\n";
+        success = false;
+    }
+
     if (success) {
         std::cout << "\n✓ Compilation successful!\n";
     } else {
         std::cerr << "\n✗ Compilation failed\n";
         std::cerr << "Error: " << compiler.getLastError() << "\n";
     }
+
+    return success;
 }
 
 int main(int argc, char* argv[]) {
@@ -127,8 +202,11 @@ int main(int argc, char* argv[]) {
     }
 
     if (command == "build") {
-        buildCommand(argc, argv);
-        return 0;
+        return buildCommand(argc, argv) ? 0 : 1;
+    }
+
+    if (command == "bench") {
+        return artic::cli::benchCommand(argc, argv);
     }
 
     std::cerr << "Error: Unknown command '" << command << "'\n";
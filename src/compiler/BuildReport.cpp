@@ -0,0 +1,173 @@
+#include "compiler/BuildReport.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdio>
+
+namespace artic {
+
+namespace {
+
+constexpr BudgetMetric ALL_METRICS[] = {
+    BudgetMetric::Html, BudgetMetric::HtmlGzip, BudgetMetric::Css, BudgetMetric::CssGzip};
+
+} // namespace
+
+std::optional<size_t> parseByteSize(std::string_view text) {
+    size_t value = 0;
+    auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc() || end == text.data()) {
+        return std::nullopt;
+    }
+
+    std::string unit(end, text.data() + text.size());
+    std::transform(unit.begin(), unit.end(), unit.begin(), [](unsigned char c) { return std::tolower(c); });
+
+    if (unit.empty() || unit == "b") {
+        return value;
+    }
+    if (unit == "kb" || unit == "k") {
+        return value * 1024;
+    }
+    if (unit == "mb" || unit == "m") {
+        return value * 1024 * 1024;
+    }
+    return std::nullopt;
+}
+
+const char* budgetMetricName(BudgetMetric metric) {
+    switch (metric) {
+        case BudgetMetric::Html: return "html";
+        case BudgetMetric::HtmlGzip: return "html-gzip";
+        case BudgetMetric::Css: return "css";
+        case BudgetMetric::CssGzip: return "css-gzip";
+    }
+    return "?";
+}
+
+std::optional<SizeBudget> SizeBudget::parse(std::string_view spec) {
+    SizeBudget budget;
+
+    // Optional route prefix: "/docs:html=50kb"
+    if (!spec.empty() && spec.front() == '/') {
+        size_t colon = spec.find(':');
+        if (colon == std::string_view::npos) {
+            return std::nullopt;
+        }
+        budget.route = std::string(spec.substr(0, colon));
+        spec.remove_prefix(colon + 1);
+    }
+
+    size_t equals = spec.find('=');
+    if (equals == std::string_view::npos) {
+        return std::nullopt;
+    }
+
+    std::string_view name = spec.substr(0, equals);
+    auto metric = std::find_if(std::begin(ALL_METRICS), std::end(ALL_METRICS),
+                               [&](BudgetMetric m) { return name == budgetMetricName(m); });
+    if (metric == std::end(ALL_METRICS)) {
+        return std::nullopt;
+    }
+    budget.metric = *metric;
+
+    auto limit = parseByteSize(spec.substr(equals + 1));
+    if (!limit) {
+        return std::nullopt;
+    }
+    budget.limit = *limit;
+
+    return budget;
+}
+
+size_t BuildReport::size(BudgetMetric metric) const {
+    switch (metric) {
+        case BudgetMetric::Html: return htmlBytes;
+        case BudgetMetric::HtmlGzip: return htmlGzipBytes;
+        case BudgetMetric::Css: return cssBytes;
+        case BudgetMetric::CssGzip: return cssGzipBytes;
+    }
+    return 0;
+}
+
+std::vector<BudgetViolation> BuildReport::check(const std::vector<SizeBudget>& budgets) const {
+    std::vector<BudgetViolation> violations;
+
+    for (BudgetMetric metric : ALL_METRICS) {
+        // The last matching budget wins; a budget for this route beats a general one
+        const SizeBudget* applicable = nullptr;
+        for (const auto& budget : budgets) {
+            if (budget.metric != metric) {
+                continue;
+            }
+            if (budget.route.empty() && (!applicable || applicable->route.empty())) {
+                applicable = &budget;
+            } else if (!budget.route.empty() && budget.route == route) {
+                applicable = &budget;
+            }
+        }
+
+        if (applicable && size(metric) > applicable->limit) {
+            violations.push_back({metric, size(metric), applicable->limit});
+        }
+    }
+
+    return violations;
+}
+
+std::string BuildReport::format(size_t top) const {
+    char line[256];
+    std::string out;
+
+    out += "Size report: " + page + (route.empty() ? "" : " (" + route + ")") + "\n";
+    std::snprintf(line, sizeof(line), "  %-6s %12s %12s\n", "", "raw", "gzip (est.)");
+    out += line;
+    std::snprintf(line, sizeof(line), "  %-6s %12s %12s\n", "html", formatBytes(htmlBytes).c_str(),
+                  formatBytes(htmlGzipBytes).c_str());
+    out += line;
+    std::snprintf(line, sizeof(line), "  %-6s %12s %12s\n", "css", formatBytes(cssBytes).c_str(),
+                  formatBytes(cssGzipBytes).c_str());
+    out += line;
+
+    if (!utilities.empty()) {
+        out += "  CSS by utility:\n";
+        for (size_t i = 0; i < std::min(top, utilities.size()); i++) {
+            std::snprintf(line, sizeof(line), "    %12s  %s\n", formatBytes(utilities[i].bytes).c_str(),
+                          utilities[i].name.c_str());
+            out += line;
+        }
+        if (utilities.size() > top) {
+            out += "    ... " + std::to_string(utilities.size() - top) + " more\n";
+        }
+    }
+
+    // The page itself is the first entry; list what it is made of
+    if (components.size() > 1) {
+        out += "  HTML by component (inclusive, expansions):\n";
+        for (size_t i = 1; i < std::min(top + 1, components.size()); i++) {
+            const RenderCost& cost = components[i].cost;
+            std::snprintf(line, sizeof(line), "    %12s  %s x%zu\n", formatBytes(cost.inclusiveBytes).c_str(),
+                          components[i].name.c_str(), cost.expansions);
+            out += line;
+        }
+        if (components.size() > top + 1) {
+            out += "    ... " + std::to_string(components.size() - top - 1) + " more\n";
+        }
+    }
+
+    return out;
+}
+
+std::string formatBytes(size_t bytes) {
+    char buffer[32];
+    if (bytes < 1024) {
+        std::snprintf(buffer, sizeof(buffer), "%zu B", bytes);
+    } else if (bytes < 1024 * 1024) {
+        std::snprintf(buffer, sizeof(buffer), "%.1f KB", static_cast<double>(bytes) / 1024);
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "%.2f MB", static_cast<double>(bytes) / (1024 * 1024));
+    }
+    return buffer;
+}
+
+} // namespace artic
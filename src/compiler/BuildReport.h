@@ -0,0 +1,108 @@
+#pragma once
+
+#include "backend/html/RenderProfile.h"
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace artic {
+
+/**
+ * @brief Output size a budget limits
+ */
+enum class BudgetMetric {
+    Html,      // index.html bytes
+    HtmlGzip,  // index.html, gzip-estimated
+    Css,       // style.css bytes
+    CssGzip    // style.css, gzip-estimated
+};
+
+/**
+ * @brief Name used in budget specs and reports ("html", "html-gzip", ...)
+ */
+const char* budgetMetricName(BudgetMetric metric);
+
+/**
+ * @brief Maximum size of one build output
+ *
+ * Spec syntax (artic build --budget): [route:]metric=size, e.g.
+ *
+ *   html=50kb          every page
+ *   /docs:css-gzip=8kb only the page with @route("/docs")
+ *
+ * Sizes take an optional b, kb or mb suffix (1 kb = 1024 bytes). A
+ * route-specific budget replaces the general one for the same metric.
+ */
+struct SizeBudget {
+    std::string route;  // Empty: applies to every page
+    BudgetMetric metric = BudgetMetric::Html;
+    size_t limit = 0;
+
+    /**
+     * @brief Parse a budget spec
+     * @return std::nullopt if the spec is malformed
+     */
+    static std::optional<SizeBudget> parse(std::string_view spec);
+};
+
+/**
+ * @brief A budget the build exceeded
+ */
+struct BudgetViolation {
+    BudgetMetric metric;
+    size_t actual;
+    size_t limit;
+};
+
+/**
+ * @brief CSS bytes a single @utility contributes
+ */
+struct UtilitySize {
+    std::string name;
+    size_t bytes;
+};
+
+/**
+ * @brief Output sizes of one built page (artic build --report)
+ */
+struct BuildReport {
+    std::string page;                          // Input file name
+    std::string route;                         // @route path (empty if none)
+    size_t htmlBytes = 0;
+    size_t htmlGzipBytes = 0;
+    size_t cssBytes = 0;
+    size_t cssGzipBytes = 0;
+    std::vector<UtilitySize> utilities;        // Largest first; each generated on its own
+    std::vector<RenderCostEntry> components;   // Largest inclusive HTML first
+
+    /**
+     * @brief Size of the output a metric refers to
+     */
+    size_t size(BudgetMetric metric) const;
+
+    /**
+     * @brief Budgets that apply to this page and are exceeded
+     */
+    std::vector<BudgetViolation> check(const std::vector<SizeBudget>& budgets) const;
+
+    /**
+     * @brief Human-readable report
+     * @param top Utilities and components listed (largest first)
+     */
+    std::string format(size_t top = 10) const;
+};
+
+/**
+ * @brief Format a byte count for reports ("812 B", "48.3 KB")
+ */
+std::string formatBytes(size_t bytes);
+
+/**
+ * @brief Parse a byte count with an optional b, kb or mb suffix ("512", "20kb")
+ * @return std::nullopt if malformed
+ */
+std::optional<size_t> parseByteSize(std::string_view text);
+
+} // namespace artic
@@ -0,0 +1,107 @@
+#include "compiler/CompilationProfile.h"
+#include <cstdio>
+#include <sstream>
+
+namespace artic {
+
+namespace {
+
+double milliseconds(std::chrono::nanoseconds time) {
+    return std::chrono::duration<double, std::milli>(time).count();
+}
+
+std::string formatRow(const char* name, const PhaseCost& cost) {
+    char line[160];
+    std::snprintf(line, sizeof(line), "%-8s %10.3f ms", name, milliseconds(cost.time));
+
+    std::string row = line;
+    if (MemoryStats::available()) {
+        std::snprintf(line, sizeof(line), " %10llu %12llu %12llu",
+                      static_cast<unsigned long long>(cost.allocations.count),
+                      static_cast<unsigned long long>(cost.allocations.bytes),
+                      static_cast<unsigned long long>(cost.peakLiveBytes));
+        row += line;
+    }
+    return row;
+}
+
+std::string jsonString(const std::string& value) {
+    std::string quoted = "\"";
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            quoted += '\\';
+        }
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+void writeCost(std::ostringstream& json, const PhaseCost& cost) {
+    json << "{\"time_ms\": " << milliseconds(cost.time);
+    if (MemoryStats::available()) {
+        json << ", \"allocations\": " << cost.allocations.count
+             << ", \"allocated_bytes\": " << cost.allocations.bytes
+             << ", \"peak_live_bytes\": " << cost.peakLiveBytes;
+    }
+    json << "}";
+}
+
+PhaseCost phaseCost(const CompilationProfile& profile, size_t phase) {
+    return {profile.time[phase], profile.allocations[phase], profile.peakLiveBytes[phase]};
+}
+
+} // namespace
+
+std::vector<std::string> CompilationProfile::summaryLines() const {
+    std::vector<std::string> lines;
+
+    std::string header = "phase           time";
+    if (MemoryStats::available()) {
+        header += "     allocs        bytes    peak live";
+    }
+    lines.push_back(header);
+
+    PhaseCost total;
+    for (size_t phase = 0; phase < COMPILATION_PHASE_COUNT; phase++) {
+        PhaseCost cost = phaseCost(*this, phase);
+        lines.push_back(formatRow(phaseName(static_cast<CompilationPhase>(phase)), cost));
+        total.add(cost);
+    }
+    lines.push_back(formatRow("total", total));
+
+    if (!files.empty()) {
+        lines.push_back("read + lex + parse per file:");
+        for (const auto& file : files) {
+            lines.push_back(formatRow("", file.cost) + "  " + file.path);
+        }
+    }
+
+    return lines;
+}
+
+std::string CompilationProfile::toJson() const {
+    std::ostringstream json;
+
+    json << "{\n";
+    json << "  \"memory_tracked\": " << (MemoryStats::available() ? "true" : "false") << ",\n";
+    json << "  \"phases\": {\n";
+    for (size_t phase = 0; phase < COMPILATION_PHASE_COUNT; phase++) {
+        json << "    \"" << phaseName(static_cast<CompilationPhase>(phase)) << "\": ";
+        writeCost(json, phaseCost(*this, phase));
+        json << (phase + 1 < COMPILATION_PHASE_COUNT ? ",\n" : "\n");
+    }
+    json << "  },\n";
+
+    json << "  \"files\": [\n";
+    for (size_t i = 0; i < files.size(); i++) {
+        json << "    {\"path\": " << jsonString(files[i].path) << ", \"cost\": ";
+        writeCost(json, files[i].cost);
+        json << "}" << (i + 1 < files.size() ? ",\n" : "\n");
+    }
+    json << "  ]\n";
+    json << "}\n";
+
+    return json.str();
+}
+
+} // namespace artic
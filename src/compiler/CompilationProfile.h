@@ -0,0 +1,161 @@
+#pragma once
+
+#include "shared/utils/MemoryStats.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace artic {
+
+/**
+ * @brief Pipeline phase a compilation spends time in
+ */
+enum class CompilationPhase : std::uint8_t {
+    Read,   // Reading .atc files (root and imports, through the registry)
+    Lex,    // Lexer::tokenize
+    Parse,  // Parser::parse
+    Css,    // CSS generation
+    Html,   // HTML generation (template compilation + rendering) or SSR sources
+    Write,  // Output directory, class map and SSR files
+    Count
+};
+
+constexpr std::size_t COMPILATION_PHASE_COUNT = static_cast<std::size_t>(CompilationPhase::Count);
+
+/**
+ * @brief Lowercase phase name ("read", "lex", ...)
+ */
+constexpr const char* phaseName(CompilationPhase phase) {
+    switch (phase) {
+        case CompilationPhase::Read: return "read";
+        case CompilationPhase::Lex: return "lex";
+        case CompilationPhase::Parse: return "parse";
+        case CompilationPhase::Css: return "css";
+        case CompilationPhase::Html: return "html";
+        case CompilationPhase::Write: return "write";
+        case CompilationPhase::Count: break;
+    }
+    return "?";
+}
+
+/**
+ * @brief Cost of one phase (or of loading one file)
+ */
+struct PhaseCost {
+    std::chrono::nanoseconds time{};
+    AllocationCounts allocations;     // ARTIC_MEMORY_PROFILING builds (zero otherwise)
+    std::uint64_t peakLiveBytes = 0;  // Live heap high-water mark (same)
+
+    void add(const PhaseCost& other) {
+        time += other.time;
+        allocations += other.allocations;
+        peakLiveBytes = std::max(peakLiveBytes, other.peakLiveBytes);
+    }
+};
+
+/**
+ * @brief Read + lex + parse cost of one component file
+ *
+ * Imports are loaded after their parent is parsed and get their own entry.
+ */
+struct FileProfile {
+    std::string path;
+    PhaseCost cost;
+};
+
+/**
+ * @brief Time and heap allocations per phase during one compilation
+ *
+ * Read, lex and parse are summed over the root component and all of its
+ * imports; files lists them one by one. Allocations are only counted
+ * where MemoryStats::available().
+ */
+struct CompilationProfile {
+    std::array<std::chrono::nanoseconds, COMPILATION_PHASE_COUNT> time{};
+    std::array<AllocationCounts, COMPILATION_PHASE_COUNT> allocations{};
+    std::array<std::uint64_t, COMPILATION_PHASE_COUNT> peakLiveBytes{};
+    std::vector<FileProfile> files;
+
+    std::chrono::nanoseconds& operator[](CompilationPhase phase) {
+        return time[static_cast<std::size_t>(phase)];
+    }
+
+    std::chrono::nanoseconds operator[](CompilationPhase phase) const {
+        return time[static_cast<std::size_t>(phase)];
+    }
+
+    void add(CompilationPhase phase, const PhaseCost& cost) {
+        auto index = static_cast<std::size_t>(phase);
+        time[index] += cost.time;
+        allocations[index] += cost.allocations;
+        peakLiveBytes[index] = std::max(peakLiveBytes[index], cost.peakLiveBytes);
+    }
+
+    void reset() {
+        time.fill(std::chrono::nanoseconds::zero());
+        allocations.fill(AllocationCounts{});
+        peakLiveBytes.fill(0);
+        files.clear();
+    }
+
+    /**
+     * @brief Per-phase and per-file table, one line per row (for --verbose)
+     */
+    std::vector<std::string> summaryLines() const;
+
+    /**
+     * @brief The same data as a JSON object
+     */
+    std::string toJson() const;
+};
+
+/**
+ * @brief Attributes the time and allocations until destruction to a phase
+ *
+ * Spans are not nested: each one restarts peak live tracking. A file
+ * profile, when given, accumulates the same cost. Without a profile the
+ * span does nothing.
+ */
+class PhaseSpan {
+public:
+    PhaseSpan(CompilationProfile* profile, CompilationPhase phase, FileProfile* file = nullptr)
+        : m_profile(profile), m_phase(phase), m_file(file) {
+        if (m_profile) {
+            MemoryStats::resetPeakLiveBytes();
+            m_allocations = MemoryStats::allocations();
+            m_start = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~PhaseSpan() {
+        if (!m_profile) {
+            return;
+        }
+
+        PhaseCost cost;
+        cost.time = std::chrono::steady_clock::now() - m_start;
+        cost.allocations = MemoryStats::allocations() - m_allocations;
+        cost.peakLiveBytes = MemoryStats::peakLiveBytes();
+
+        m_profile->add(m_phase, cost);
+        if (m_file) {
+            m_file->cost.add(cost);
+        }
+    }
+
+    PhaseSpan(const PhaseSpan&) = delete;
+    PhaseSpan& operator=(const PhaseSpan&) = delete;
+
+private:
+    CompilationProfile* m_profile;
+    CompilationPhase m_phase;
+    FileProfile* m_file;
+    AllocationCounts m_allocations;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+} // namespace artic
@@ -1,15 +1,85 @@
 #include "compiler/Compiler.h"
 #include "shared/utils/FileSystem.h"
+#include "shared/utils/GzipEstimator.h"
 #include "frontend/parser/ParseError.h"
-#include <iostream>
+#include <algorithm>
 
 namespace artic {
 
+namespace {
+
+LogLevel logThreshold(const CompilerOptions& options) {
+    return options.silent ? LogLevel::Off : options.verbose ? LogLevel::Debug : LogLevel::Info;
+}
+
+} // namespace
+
 Compiler::Compiler(const CompilerOptions& options)
-    : m_options(options) {}
+    : m_options(options),
+      m_logger(logThreshold(options)),
+      m_ownedRegistry(std::make_unique<ComponentRegistry>()),
+      m_registry(m_ownedRegistry.get()) {
+    if (m_options.metrics) {
+        m_metrics = std::make_unique<CompilerMetrics>(*m_options.metrics);
+    }
+    attachRegistry();
+}
+
+Compiler::Compiler(const CompilerOptions& options, ComponentRegistry& registry)
+    : m_options(options),
+      m_logger(logThreshold(options)),
+      m_registry(&registry) {
+    if (m_options.metrics) {
+        m_metrics = std::make_unique<CompilerMetrics>(*m_options.metrics);
+    }
+    attachRegistry();
+}
+
+Compiler::~Compiler() {
+    // A shared registry outlives this compiler's logger, profile and metrics
+    m_registry->setLogger(&Logger::fallback());
+    m_registry->setProfile(nullptr);
+    m_registry->setMetrics(nullptr);
+}
+
+void Compiler::attachRegistry() {
+    m_registry->setLogger(&m_logger);
+    m_registry->setMaxTemplateDepth(m_options.maxTemplateDepth);
+    m_registry->setProfile(&m_profile);
+    m_registry->setMetrics(m_metrics.get());
+}
 
 bool Compiler::compile() {
-    log("Starting compilation...");
+    m_profile.reset();
+    m_sizeReport.reset();
+    attachRegistry();
+
+    bool success = runCompile();
+    recordMetrics(success);
+    return success;
+}
+
+CompilationResult Compiler::compileToString() {
+    m_profile.reset();
+    attachRegistry();
+
+    CompilationResult result = runCompileToString();
+    if (m_metrics && result.success) {
+        m_metrics->cssBytes.inc(result.generatedCss.size());
+        m_metrics->htmlBytes.inc(result.generatedHtml.size());
+    }
+    recordMetrics(result.success);
+    return result;
+}
+
+void Compiler::recordMetrics(bool success) {
+    if (m_metrics) {
+        m_metrics->recordCompilation(m_profile, success);
+    }
+}
+
+bool Compiler::runCompile() {
+    ARTIC_LOG_INFO(m_logger, "Starting compilation...");
 
     // Validate options
     if (!m_options.validate()) {
@@ -17,12 +87,16 @@ bool Compiler::compile() {
         return false;
     }
 
-    logVerbose("Input file: " + m_options.inputFile);
-    logVerbose("Output directory: " + m_options.outputDir);
+    ARTIC_LOG_DEBUG(m_logger, "Input file: " + m_options.inputFile);
+    ARTIC_LOG_DEBUG(m_logger, "Output directory: " + m_options.outputDir);
 
-    // 1. Load component with registry (this also loads all imports)
-    log("Lexing...");
-    log("Parsing...");
+    if (m_options.streamTemplate) {
+        return runStreamingCompile();
+    }
+
+    // 1. Load component with registry (this also loads all imports; each
+    //    file logs its own lex and parse steps)
+    ARTIC_LOG_INFO(m_logger, "Loading components...");
     Component* component = loadComponentWithRegistry(m_options.inputFile);
 
     if (!component) {
@@ -30,49 +104,181 @@ bool Compiler::compile() {
         return false;
     }
 
-    logVerbose("Component loaded successfully");
-    logVerbose("  Utilities: " + std::to_string(component->utilities.size()));
-    logVerbose("  Template nodes: " + std::to_string(component->templateNodes.size()));
-    logVerbose("  Imported components: " + std::to_string(m_registry.getAllComponents().size() - 1));
+    // A shared registry keeps this page's components until it is done
+    ComponentRegistry::PagePin pin(*m_registry, component);
 
-    // 2. Generate CSS
-    log("Generating CSS...");
-    std::string css;
-    try {
-        css = generateCss(component);
-    } catch (const std::exception& e) {
-        logError("CSS generation error: " + std::string(e.what()));
+    ARTIC_LOG_DEBUG(m_logger, "Component loaded successfully");
+    ARTIC_LOG_DEBUG(m_logger, "  Utilities: " + std::to_string(component->utilities.size()));
+    ARTIC_LOG_DEBUG(m_logger, "  Template nodes: " + std::to_string(component->templateNodes.size()));
+    ARTIC_LOG_DEBUG(m_logger, "  Imported components: " + std::to_string(m_registry->closure(component).size() - 1));
+
+    if (m_options.mangleClassNames) {
+        prepareClassMangler(component);
+        ARTIC_LOG_DEBUG(m_logger, "Mangled " + std::to_string(m_classMangler->size()) + " utility class names");
+    }
+
+    // 2. Create output directory and write the class map
+    ARTIC_LOG_INFO(m_logger, "Writing output files...");
+    if (!writeOutputFiles()) {
+        return false;
+    }
+
+    // 3. Generate CSS straight into the output file
+    ARTIC_LOG_INFO(m_logger, "Generating CSS...");
+    if (!streamToFile(m_options.getCssOutputPath(), OutputFile::Css,
+                      [&](OutputSink& out) { generateCss(component, out); return true; })) {
         return false;
     }
 
-    logVerbose("Generated " + std::to_string(css.size()) + " bytes of CSS");
+    auto cacheStats = UtilityCache::shared().stats();
+    ARTIC_LOG_DEBUG(m_logger, "Utility cache: " + std::to_string(cacheStats.hits) + " hits, " +
+               std::to_string(cacheStats.misses) + " misses, " +
+               std::to_string(cacheStats.evictions) + " evictions");
 
-    // 3. Generate HTML
-    log("Generating HTML...");
-    std::string html;
-    try {
-        html = generateHtml(component);
-    } catch (const std::exception& e) {
-        logError("HTML generation error: " + std::string(e.what()));
+    // 4. SSR: native render functions instead of a static page
+    if (m_options.mode == CompilationMode::SSR) {
+        ARTIC_LOG_INFO(m_logger, "Generating SSR sources...");
+        if (!writeSsrSources(component)) {
+            return false;
+        }
+
+        ARTIC_LOG_INFO(m_logger, "Compilation successful!");
+        ARTIC_LOG_INFO(m_logger, "  CSS: " + m_options.getCssOutputPath().string());
+        ARTIC_LOG_INFO(m_logger, "  SSR: " + m_options.getSsrOutputPath().string());
+
+        return reportProfile();
+    }
+
+    // 5. Generate HTML straight into the output file
+    ARTIC_LOG_INFO(m_logger, "Generating HTML...");
+    if (!streamToFile(m_options.getHtmlOutputPath(), OutputFile::Html,
+                      [&](OutputSink& out) { generateHtml(component, out); return true; })) {
         return false;
     }
 
-    logVerbose("Generated " + std::to_string(html.size()) + " bytes of HTML");
+    if (!writeRenderProfile() || !checkOutputSize(component)) {
+        return false;
+    }
+
+    ARTIC_LOG_INFO(m_logger, "Compilation successful!");
+    ARTIC_LOG_INFO(m_logger, "  CSS: " + m_options.getCssOutputPath().string());
+    ARTIC_LOG_INFO(m_logger, "  HTML: " + m_options.getHtmlOutputPath().string());
+
+    return reportProfile();
+}
 
-    // 6. Write output files
-    log("Writing output files...");
-    if (!writeOutputFiles(css, html)) {
+bool Compiler::runStreamingCompile() {
+    // Mangling counts class usage over the whole template and SSR compiles
+    // it as a whole: both need the complete AST
+    if (m_options.mangleClassNames || m_options.mode == CompilationMode::SSR) {
+        logError("Streaming mode does not support class name mangling or SSR");
         return false;
     }
 
-    log("Compilation successful!");
-    log("  CSS: " + m_options.getCssOutputPath().string());
-    log("  HTML: " + m_options.getHtmlOutputPath().string());
+    auto inputPath = m_options.getInputPath();
+    FileProfile fileProfile{inputPath.lexically_normal().string(), {}};
 
-    return true;
+    std::string source;
+    {
+        PhaseSpan span(&m_profile, CompilationPhase::Read, &fileProfile);
+        if (!readSourceFile(source)) {
+            return false;
+        }
+    }
+
+    ARTIC_LOG_INFO(m_logger, "Writing output files...");
+    if (!writeOutputFiles()) {
+        return false;
+    }
+
+    // 1. Parse and write the page one top-level node at a time; the lexer
+    // runs as the parser pulls tokens, so lexing counts as parsing
+    ARTIC_LOG_INFO(m_logger, "Parsing and generating HTML...");
+    HtmlGenerator generator(htmlGeneratorOptions(), m_registry);
+    std::unique_ptr<Component> component;
+    std::optional<ComponentRegistry::PagePin> pin;
+    size_t nodes = 0;
+
+    auto streamPage = [&](OutputSink& out) {
+        RenderProfile* profile = m_renderProfile.get();
+        Lexer lexer(std::move(source));
+        Parser parser(lexer, m_options.maxTemplateDepth);
+        std::optional<PhaseSpan> parseSpan;
+        parseSpan.emplace(&m_profile, CompilationPhase::Parse, &fileProfile);
+
+        auto writeNode = [&](Component& page, std::unique_ptr<TemplateNode> node) {
+            parseSpan.reset();
+
+            // Imports are parsed by now: load them before the first node uses them
+            if (nodes == 0) {
+                pin.emplace(*m_registry, m_registry->loadPageImports(&page, m_options.inputFile));
+                PhaseSpan span(&m_profile, CompilationPhase::Html);
+                if (profile) {
+                    profile->enterRoot(out.size());
+                }
+                generator.generateDocumentStart(&page, out);
+            }
+
+            {
+                PhaseSpan span(&m_profile, CompilationPhase::Html);
+                generator.generatePageNode(&page, node.get(), out);
+                node.reset();
+            }
+            nodes++;
+            parseSpan.emplace(&m_profile, CompilationPhase::Parse, &fileProfile);
+        };
+
+        try {
+            component = parser.parse(writeNode);
+        } catch (const ParseError& e) {
+            logError("Parse error in " + inputPath.string() + ": " + e.what());
+            return false;
+        }
+        parseSpan.reset();
+
+        if (nodes > 0) {
+            PhaseSpan span(&m_profile, CompilationPhase::Html);
+            generator.generateDocumentEnd(out);
+            if (profile) {
+                profile->leave(out.size());
+            }
+        }
+        return true;
+    };
+    bool written = streamToFile(m_options.getHtmlOutputPath(), OutputFile::Html, streamPage);
+
+    m_profile.files.push_back(std::move(fileProfile));
+    if (m_metrics) {
+        m_metrics->filesParsed.inc();
+    }
+    recordFragmentStats(generator);
+
+    if (!written) {
+        return false;
+    }
+
+    ARTIC_LOG_DEBUG(m_logger, "  Utilities: " + std::to_string(component->utilities.size()));
+    ARTIC_LOG_DEBUG(m_logger, "  Template nodes streamed: " + std::to_string(nodes));
+
+    // 2. CSS only needs the utilities, which precede the template
+    ARTIC_LOG_INFO(m_logger, "Generating CSS...");
+    if (!streamToFile(m_options.getCssOutputPath(), OutputFile::Css,
+                      [&](OutputSink& out) { generateCss(component.get(), out); return true; })) {
+        return false;
+    }
+
+    if (!writeRenderProfile() || !checkOutputSize(component.get())) {
+        return false;
+    }
+
+    ARTIC_LOG_INFO(m_logger, "Compilation successful!");
+    ARTIC_LOG_INFO(m_logger, "  CSS: " + m_options.getCssOutputPath().string());
+    ARTIC_LOG_INFO(m_logger, "  HTML: " + m_options.getHtmlOutputPath().string());
+
+    return reportProfile();
 }
 
-CompilationResult Compiler::compileToString() {
+CompilationResult Compiler::runCompileToString() {
     CompilationResult result;
 
     // Load component with registry
@@ -83,6 +289,13 @@ CompilationResult Compiler::compileToString() {
         return result;
     }
 
+    ComponentRegistry::PagePin pin(*m_registry, component);
+
+    if (m_options.mangleClassNames) {
+        prepareClassMangler(component);
+        result.classMap = m_classMangler->toJson();
+    }
+
     // Generate CSS
     try {
         result.generatedCss = generateCss(component);
@@ -135,83 +348,313 @@ std::vector<Token> Compiler::lex(const std::string& source) {
 }
 
 std::unique_ptr<Component> Compiler::parse(const std::vector<Token>& tokens) {
-    Parser parser(tokens);
+    Parser parser(tokens, m_options.maxTemplateDepth);
     return parser.parse();
 }
 
 Component* Compiler::loadComponentWithRegistry(const std::string& filePath) {
-    return m_registry.loadComponent(filePath);
+    return m_registry->loadComponent(filePath);
+}
+
+void Compiler::prepareClassMangler(Component* component) {
+    m_classMangler = std::make_unique<ClassNameMangler>();
+
+    // CSS is generated from the root component's utilities only
+    m_classMangler->addUtilities(component);
+
+    // Count usage across every template that can end up in the page
+    for (const auto& name : m_registry->closure(component)) {
+        m_classMangler->countUsage(m_registry->getComponent(name));
+    }
+
+    m_classMangler->assignNames();
 }
 
 std::string Compiler::generateCss(Component* component) {
+    StringSink out;
+    generateCss(component, out);
+    return out.take();
+}
+
+void Compiler::generateCss(Component* component, OutputSink& out) {
+    PhaseSpan span(&m_profile, CompilationPhase::Css);
+
+    auto before = UtilityCache::shared().stats();
+    CssGenerator generator(cssGeneratorOptions());
+    generator.generate(component, out);
+
+    // The cache is shared by the process: count this generation's lookups only
+    auto after = UtilityCache::shared().stats();
+    if (m_metrics && after.hits >= before.hits && after.misses >= before.misses) {
+        m_metrics->utilityCacheHits.inc(after.hits - before.hits);
+        m_metrics->utilityCacheMisses.inc(after.misses - before.misses);
+    }
+}
+
+CssGeneratorOptions Compiler::cssGeneratorOptions() const {
     CssGeneratorOptions cssOptions;
     cssOptions.minify = m_options.minifyCss;
     cssOptions.pretty = m_options.prettyPrint && !m_options.minifyCss;
-
-    CssGenerator generator(cssOptions);
-    return generator.generate(component);
+    cssOptions.classMangler = m_classMangler.get();
+    return cssOptions;
 }
 
 std::string Compiler::generateHtml(Component* component) {
+    StringSink out;
+    generateHtml(component, out);
+    return out.take();
+}
+
+void Compiler::generateHtml(Component* component, OutputSink& out) {
+    PhaseSpan span(&m_profile, CompilationPhase::Html);
+
+    // Pass registry to enable component expansion
+    HtmlGenerator generator(htmlGeneratorOptions(), m_registry);
+    generator.generate(component, out);
+    recordFragmentStats(generator);
+}
+
+HtmlGeneratorOptions Compiler::htmlGeneratorOptions() {
     HtmlGeneratorOptions htmlOptions;
     htmlOptions.pretty = m_options.prettyPrint && !m_options.minifyHtml;
     htmlOptions.includeDoctype = m_options.includeDoctype;
     htmlOptions.indentSize = m_options.indentSize;
     htmlOptions.minify = m_options.minifyHtml;
+    htmlOptions.classMangler = m_classMangler.get();
+    htmlOptions.maxRenderDepth = m_options.maxTemplateDepth;
 
-    // Pass registry to enable component expansion
-    HtmlGenerator generator(htmlOptions, &m_registry);
-    return generator.generate(component);
+    // The size report lists the largest components too
+    if (!m_options.renderProfilePrefix.empty() || m_options.sizeReport) {
+        m_renderProfile = std::make_unique<RenderProfile>(std::filesystem::path(m_options.inputFile).stem().string());
+        htmlOptions.renderProfile = m_renderProfile.get();
+    }
+
+    return htmlOptions;
 }
 
-bool Compiler::writeOutputFiles(const std::string& css, const std::string& html) {
+void Compiler::recordFragmentStats(const HtmlGenerator& generator) {
+    auto fragmentStats = generator.fragmentCacheStats();
+    if (m_metrics) {
+        m_metrics->fragmentCacheHits.inc(fragmentStats.hits);
+        m_metrics->fragmentCacheMisses.inc(fragmentStats.misses);
+        m_metrics->componentsExpanded.inc(generator.componentExpansions());
+    }
+    if (fragmentStats.hits + fragmentStats.misses > 0) {
+        ARTIC_LOG_DEBUG(m_logger, "Component fragments: " + std::to_string(fragmentStats.hits) + " reused, " +
+                   std::to_string(fragmentStats.misses) + " rendered");
+    }
+}
+
+bool Compiler::writeOutputFiles() {
+    PhaseSpan span(&m_profile, CompilationPhase::Write);
     auto outputPath = m_options.getOutputPath();
 
     // Create output directory
     if (!FileSystem::directoryExists(outputPath)) {
-        logVerbose("Creating output directory: " + outputPath.string());
+        ARTIC_LOG_DEBUG(m_logger, "Creating output directory: " + outputPath.string());
         if (!FileSystem::createDirectory(outputPath)) {
             logError("Failed to create output directory: " + outputPath.string());
             return false;
         }
     }
 
-    // Write CSS file
-    auto cssPath = m_options.getCssOutputPath();
-    logVerbose("Writing CSS to: " + cssPath.string());
-    if (!FileSystem::writeFile(cssPath, css)) {
-        logError("Failed to write CSS file: " + cssPath.string());
+    // Write class name map
+    if (m_classMangler) {
+        auto mapPath = m_options.getClassMapOutputPath();
+        ARTIC_LOG_DEBUG(m_logger, "Writing class map to: " + mapPath.string());
+        if (!FileSystem::writeFile(mapPath, m_classMangler->toJson())) {
+            logError("Failed to write class map file: " + mapPath.string());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Compiler::writeSsrSources(Component* component) {
+    SsrGeneratorOptions ssrOptions;
+    ssrOptions.minify = m_options.minifyHtml;
+    ssrOptions.includeDoctype = m_options.includeDoctype;
+    ssrOptions.classMangler = m_classMangler.get();
+
+    std::vector<GeneratedFile> files;
+    try {
+        PhaseSpan span(&m_profile, CompilationPhase::Html);
+        SsrGenerator generator(ssrOptions, *m_registry);
+        files = generator.generate(component);
+    } catch (const std::exception& e) {
+        logError("SSR generation error: " + std::string(e.what()));
+        return false;
+    }
+
+    PhaseSpan span(&m_profile, CompilationPhase::Write);
+
+    auto ssrPath = m_options.getSsrOutputPath();
+    if (!FileSystem::directoryExists(ssrPath) && !FileSystem::createDirectory(ssrPath)) {
+        logError("Failed to create SSR output directory: " + ssrPath.string());
+        return false;
+    }
+
+    for (const auto& file : files) {
+        auto filePath = ssrPath / file.name;
+        ARTIC_LOG_DEBUG(m_logger, "Writing " + filePath.string());
+        if (!FileSystem::writeFile(filePath, file.contents)) {
+            logError("Failed to write SSR file: " + filePath.string());
+            return false;
+        }
+    }
+
+    ARTIC_LOG_DEBUG(m_logger, "Generated " + std::to_string(files.size()) + " SSR files");
+    return true;
+}
+
+bool Compiler::streamToFile(const std::filesystem::path& path, OutputFile file,
+                            const std::function<bool(OutputSink&)>& generate) {
+    std::string kind = file == OutputFile::Html ? "HTML" : "CSS";
+    ARTIC_LOG_DEBUG(m_logger, "Writing " + kind + " to: " + path.string());
+
+    // Output is streamed into a sibling temporary file, never held in memory
+    // as a whole; it replaces the previous build's file only once complete
+    std::filesystem::path temp = path;
+    temp += ".tmp";
+    std::error_code error;
+
+    FileSink out(temp);
+    if (!out.isOpen()) {
+        logError("Failed to write " + kind + " file: " + path.string());
         return false;
     }
 
-    // Write HTML file
-    auto htmlPath = m_options.getHtmlOutputPath();
-    logVerbose("Writing HTML to: " + htmlPath.string());
-    if (!FileSystem::writeFile(htmlPath, html)) {
-        logError("Failed to write HTML file: " + htmlPath.string());
+    // The size report measures the output on its way to the file
+    bool measure = m_options.sizeReport || !m_options.budgets.empty();
+    GzipEstimator gzip;
+    GzipMeasuringSink measured(out, gzip);
+
+    bool generated = false;
+    try {
+        generated = generate(measure ? static_cast<OutputSink&>(measured) : out);
+    } catch (const std::exception& e) {
+        logError(kind + " generation error: " + std::string(e.what()));
+    }
+
+    size_t bytes = out.size();
+    bool written = false;
+    {
+        // Generation streams into the file; only the final flush counts as writing
+        PhaseSpan span(&m_profile, CompilationPhase::Write);
+        written = out.close() && generated;
+        if (written) {
+            std::filesystem::rename(temp, path, error);
+            written = !error;
+        }
+    }
+    if (!written) {
+        std::filesystem::remove(temp, error);
+        if (generated) {
+            logError("Failed to write " + kind + " file: " + path.string());
+        }
         return false;
     }
 
+    if (measure) {
+        OutputSize& size = file == OutputFile::Html ? m_htmlSize : m_cssSize;
+        size.bytes = bytes;
+        size.gzipBytes = gzip.finish();
+    }
+
+    if (m_metrics) {
+        (file == OutputFile::Html ? m_metrics->htmlBytes : m_metrics->cssBytes).inc(bytes);
+    }
+
+    ARTIC_LOG_DEBUG(m_logger, "Generated " + std::to_string(bytes) + " bytes of " + kind);
     return true;
 }
 
-void Compiler::log(const std::string& message) {
-    if (!m_options.silent) {
-        std::cout << message << "\n";
+bool Compiler::writeRenderProfile() {
+    if (!m_renderProfile || m_options.renderProfilePrefix.empty()) {
+        return true;
     }
+
+    PhaseSpan span(&m_profile, CompilationPhase::Write);
+    const std::string& prefix = m_options.renderProfilePrefix;
+
+    std::vector<std::pair<std::string, std::string>> files = {
+        {prefix + ".txt", m_renderProfile->report()},
+        {prefix + ".bytes.folded", m_renderProfile->foldedStacks(RenderMetric::Bytes)},
+        {prefix + ".time.folded", m_renderProfile->foldedStacks(RenderMetric::Time)},
+    };
+
+    for (const auto& [path, contents] : files) {
+        ARTIC_LOG_DEBUG(m_logger, "Writing render profile to: " + path);
+        if (!FileSystem::writeFile(path, contents)) {
+            logError("Failed to write render profile: " + path);
+            return false;
+        }
+    }
+
+    return true;
 }
 
-void Compiler::logError(const std::string& message) {
-    m_lastError = message;
-    if (!m_options.silent) {
-        std::cerr << "ERROR: " << message << "\n";
+bool Compiler::checkOutputSize(Component* component) {
+    if (!m_options.sizeReport && m_options.budgets.empty()) {
+        return true;
+    }
+
+    // Outputs were measured by streamToFile while they were written
+    BuildReport report;
+    report.page = m_options.getInputPath().filename().string();
+    report.route = component->route ? component->route->path : "";
+    report.htmlBytes = m_htmlSize.bytes;
+    report.htmlGzipBytes = m_htmlSize.gzipBytes;
+    report.cssBytes = m_cssSize.bytes;
+    report.cssGzipBytes = m_cssSize.gzipBytes;
+
+    // Each utility on its own (minified output may merge rules across utilities)
+    CssGenerator generator(cssGeneratorOptions());
+    for (const auto& utility : component->utilities) {
+        report.utilities.push_back({utility->name, generator.generateUtility(utility.get()).size()});
     }
+    std::stable_sort(report.utilities.begin(), report.utilities.end(),
+                     [](const UtilitySize& a, const UtilitySize& b) { return a.bytes > b.bytes; });
+
+    if (m_renderProfile) {
+        report.components = m_renderProfile->byComponent();
+    }
+
+    if (m_options.sizeReport) {
+        ARTIC_LOG_INFO(m_logger, "\n" + report.format());
+    }
+
+    auto violations = report.check(m_options.budgets);
+    m_sizeReport = std::move(report);
+
+    for (const auto& violation : violations) {
+        logError(std::string("Size budget exceeded: ") + budgetMetricName(violation.metric) + " is " +
+                 formatBytes(violation.actual) + ", budget " + formatBytes(violation.limit));
+    }
+
+    return violations.empty();
 }
 
-void Compiler::logVerbose(const std::string& message) {
-    if (m_options.verbose && !m_options.silent) {
-        std::cout << "  " << message << "\n";
+bool Compiler::reportProfile() {
+    if (m_logger.enabled(LogLevel::Debug)) {
+        ARTIC_LOG_DEBUG(m_logger, "Profile:");
+        for (const auto& line : m_profile.summaryLines()) {
+            ARTIC_LOG_DEBUG(m_logger, "  " + line);
+        }
     }
+
+    if (!m_options.profileFile.empty() && !FileSystem::writeFile(m_options.profileFile, m_profile.toJson())) {
+        logError("Failed to write profile: " + m_options.profileFile);
+        return false;
+    }
+
+    return true;
+}
+
+void Compiler::logError(const std::string& message) {
+    m_lastError = message;
+    ARTIC_LOG_ERROR(m_logger, message);
 }
 
 } // namespace artic
@@ -1,16 +1,24 @@
 #pragma once
 
 #include <string>
+#include <filesystem>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "compiler/CompilerOptions.h"
 #include "compiler/ComponentRegistry.h"
+#include "compiler/CompilationProfile.h"
+#include "compiler/CompilerMetrics.h"
+#include "shared/utils/Logger.h"
 #include "frontend/lexer/Lexer.h"
 #include "frontend/parser/Parser.h"
 #include "frontend/ast/Component.h"
 #include "backend/css/CssGenerator.h"
 #include "backend/html/HtmlGenerator.h"
+#include "backend/html/RenderProfile.h"
+#include "backend/ssr/SsrGenerator.h"
 
 namespace artic {
 
@@ -22,6 +30,7 @@ struct CompilationResult {
     std::string errorMessage;
     std::string generatedCss;
     std::string generatedHtml;
+    std::string classMap;        // JSON class name map (when mangling)
 };
 
 /**
@@ -44,6 +53,22 @@ class Compiler {
 public:
     explicit Compiler(const CompilerOptions& options);
 
+    /**
+     * @brief Compiler loading components through a registry shared with other pages
+     *
+     * Components imported by several pages are parsed once; a registry
+     * memory budget (ComponentRegistry::setMemoryBudget) bounds what stays
+     * loaded between pages. The registry must outlive the compiler and is
+     * not thread-safe: compile one page at a time.
+     */
+    Compiler(const CompilerOptions& options, ComponentRegistry& registry);
+
+    ~Compiler();
+
+    // The registry points at m_profile, so a compiler stays where it was built
+    Compiler(const Compiler&) = delete;
+    Compiler& operator=(const Compiler&) = delete;
+
     /**
      * @brief Compile .atc file to HTML and CSS
      * @return true if successful, false otherwise
@@ -66,24 +91,86 @@ public:
      */
     const CompilerOptions& getOptions() const { return m_options; }
 
+    /**
+     * @brief Send log output to another sink (e.g. one per parallel build job)
+     */
+    void setLogSink(LogSink* sink) { m_logger.setSink(sink); }
+
+    /**
+     * @brief Time and allocations per phase of the last compile() or compileToString()
+     *
+     * Components already loaded by an earlier call on this compiler are not
+     * read, lexed or parsed again, so repeated calls only measure generation.
+     */
+    const CompilationProfile& profile() const { return m_profile; }
+
+    /**
+     * @brief Per-component render costs of the last HTML generation
+     *
+     * Only recorded when CompilerOptions::renderProfilePrefix is set;
+     * null otherwise.
+     */
+    const RenderProfile* renderProfile() const { return m_renderProfile.get(); }
+
+    /**
+     * @brief Output sizes of the last compile() (with sizeReport or budgets set)
+     */
+    const std::optional<BuildReport>& sizeReport() const { return m_sizeReport; }
+
 private:
     CompilerOptions m_options;
+    Logger m_logger;            // Threshold from silent/verbose
     std::string m_lastError;
-    ComponentRegistry m_registry;
+    std::unique_ptr<ComponentRegistry> m_ownedRegistry;  // Unless a shared one was given
+    ComponentRegistry* m_registry;
+    std::unique_ptr<ClassNameMangler> m_classMangler;
+    CompilationProfile m_profile;
+    std::unique_ptr<RenderProfile> m_renderProfile;
+    std::optional<BuildReport> m_sizeReport;
+
+    // Size of each written output, measured while streaming (size report)
+    struct OutputSize {
+        size_t bytes = 0;
+        size_t gzipBytes = 0;
+    };
+    OutputSize m_htmlSize;
+    OutputSize m_cssSize;
+    std::unique_ptr<CompilerMetrics> m_metrics;  // Series in options.metrics (null when off)
+
+    // compile() and compileToString() without the metrics bookkeeping
+    bool runCompile();
+    bool runStreamingCompile();
+    CompilationResult runCompileToString();
+    void recordMetrics(bool success);
+    void attachRegistry();
 
     // Pipeline stages
     bool readSourceFile(std::string& source);
     std::vector<Token> lex(const std::string& source);
     std::unique_ptr<Component> parse(const std::vector<Token>& tokens);
     Component* loadComponentWithRegistry(const std::string& filePath);
+    void prepareClassMangler(Component* component);
     std::string generateCss(Component* component);
+    void generateCss(Component* component, OutputSink& out);
     std::string generateHtml(Component* component);
-    bool writeOutputFiles(const std::string& css, const std::string& html);
+    void generateHtml(Component* component, OutputSink& out);
+    HtmlGeneratorOptions htmlGeneratorOptions();
+    void recordFragmentStats(const HtmlGenerator& generator);
+    bool writeOutputFiles();
+    bool writeSsrSources(Component* component);
+    // generate() returns false after logging its own error; the file is
+    // only replaced when it succeeds
+    enum class OutputFile { Html, Css };
+    bool streamToFile(const std::filesystem::path& path, OutputFile file,
+                      const std::function<bool(OutputSink&)>& generate);
+    bool reportProfile();
+    bool writeRenderProfile();
+    bool checkOutputSize(Component* component);
+    CssGeneratorOptions cssGeneratorOptions() const;
 
-    // Logging
-    void log(const std::string& message);
+    // Errors are always recorded in m_lastError; other messages go through
+    // ARTIC_LOG_* so they are only formatted when enabled
     void logError(const std::string& message);
-    void logVerbose(const std::string& message);
 };
 
 } // namespace artic
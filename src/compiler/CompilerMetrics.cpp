@@ -0,0 +1,63 @@
+#include "compiler/CompilerMetrics.h"
+#include <chrono>
+
+namespace artic {
+
+namespace {
+
+double seconds(std::chrono::nanoseconds time) {
+    return std::chrono::duration<double>(time).count();
+}
+
+} // namespace
+
+CompilerMetrics::CompilerMetrics(MetricsRegistry& registry)
+    : compilations(registry.counter("artic_compilations_total", "Compilations started")),
+      failures(registry.counter("artic_compilation_failures_total", "Compilations that failed")),
+      compileSeconds(registry.histogram("artic_compile_duration_seconds", "Time per compilation (all phases)",
+                                        latencyBounds())),
+      filesParsed(registry.counter("artic_files_parsed_total", "Component files read, lexed and parsed")),
+      tokensLexed(registry.counter("artic_tokens_lexed_total", "Tokens produced by the lexer")),
+      componentCacheHits(registry.counter("artic_component_cache_hits_total",
+                                          "Component loads served by the registry")),
+      componentCacheMisses(registry.counter("artic_component_cache_misses_total",
+                                            "Component loads that read the file")),
+      componentEvictions(registry.counter("artic_component_evictions_total",
+                                          "Components evicted to stay within the registry memory budget")),
+      utilityCacheHits(registry.counter("artic_utility_cache_hits_total", "Utility tokens resolved from the cache")),
+      utilityCacheMisses(registry.counter("artic_utility_cache_misses_total", "Utility tokens resolved and cached")),
+      fragmentCacheHits(registry.counter("artic_fragment_cache_hits_total",
+                                         "Component expansions copied from the fragment cache")),
+      fragmentCacheMisses(registry.counter("artic_fragment_cache_misses_total",
+                                           "Component expansions rendered into the fragment cache")),
+      componentsExpanded(registry.counter("artic_components_expanded_total", "Component uses rendered into pages")),
+      htmlBytes(registry.counter("artic_output_bytes_total", "Bytes of generated output", {{"kind", "html"}})),
+      cssBytes(registry.counter("artic_output_bytes_total", "Bytes of generated output", {{"kind", "css"}})) {
+    for (size_t i = 0; i < COMPILATION_PHASE_COUNT; i++) {
+        auto phase = static_cast<CompilationPhase>(i);
+        phaseSeconds[i] = &registry.histogram("artic_phase_duration_seconds", "Time per compilation phase",
+                                              latencyBounds(), {{"phase", phaseName(phase)}});
+    }
+}
+
+const std::vector<double>& CompilerMetrics::latencyBounds() {
+    static const std::vector<double> bounds = {0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01,
+                                               0.025,  0.05,    0.1,    0.25,  0.5,    1,     2.5, 5, 10};
+    return bounds;
+}
+
+void CompilerMetrics::recordCompilation(const CompilationProfile& profile, bool success) {
+    compilations.inc();
+    if (!success) {
+        failures.inc();
+    }
+
+    std::chrono::nanoseconds total{};
+    for (size_t i = 0; i < COMPILATION_PHASE_COUNT; i++) {
+        phaseSeconds[i]->observe(seconds(profile.time[i]));
+        total += profile.time[i];
+    }
+    compileSeconds.observe(seconds(total));
+}
+
+} // namespace artic
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "compiler/CompilationProfile.h"
+#include "shared/utils/Metrics.h"
+#include <array>
+
+namespace artic {
+
+/**
+ * @brief The compiler's series in a MetricsRegistry, resolved once
+ *
+ * Every Compiler given the same registry (CompilerOptions::metrics)
+ * updates the same series, so a long-running process accumulates totals
+ * over all its builds:
+ *
+ *   artic_compilations_total / artic_compilation_failures_total
+ *   artic_compile_duration_seconds      histogram, whole compilation
+ *   artic_phase_duration_seconds        histogram per phase label
+ *   artic_files_parsed_total, artic_tokens_lexed_total
+ *   artic_component_cache_{hits,misses}_total   registry (already loaded files)
+ *   artic_component_evictions_total     components dropped to stay within the registry budget
+ *   artic_utility_cache_{hits,misses}_total     UtilityCache lookups
+ *   artic_fragment_cache_{hits,misses}_total    rendered component fragments
+ *   artic_components_expanded_total
+ *   artic_output_bytes_total            per kind label (html, css)
+ */
+struct CompilerMetrics {
+    explicit CompilerMetrics(MetricsRegistry& registry);
+
+    Counter& compilations;
+    Counter& failures;
+    Histogram& compileSeconds;
+    std::array<Histogram*, COMPILATION_PHASE_COUNT> phaseSeconds{};
+
+    Counter& filesParsed;
+    Counter& tokensLexed;
+    Counter& componentCacheHits;
+    Counter& componentCacheMisses;
+    Counter& componentEvictions;
+    Counter& utilityCacheHits;
+    Counter& utilityCacheMisses;
+    Counter& fragmentCacheHits;
+    Counter& fragmentCacheMisses;
+    Counter& componentsExpanded;
+    Counter& htmlBytes;
+    Counter& cssBytes;
+
+    /**
+     * @brief Latency buckets, 100 µs to 10 s
+     */
+    static const std::vector<double>& latencyBounds();
+
+    /**
+     * @brief Add one compilation's phase times and outcome
+     */
+    void recordCompilation(const CompilationProfile& profile, bool success);
+};
+
+} // namespace artic
@@ -1,10 +1,14 @@
 #pragma once
 
+#include "compiler/BuildReport.h"
 #include <string>
 #include <filesystem>
+#include <vector>
 
 namespace artic {
 
+class MetricsRegistry;
+
 /**
  * @brief Compilation mode for Artic
  */
@@ -46,9 +50,27 @@ struct CompilerOptions {
 
     // Optimization
     OptimizationLevel optimization = OptimizationLevel::None;
+    bool mangleClassNames = false;                  // Shorten utility class names
+    std::string classMapFile = "class-map.json";    // Original → short name map (debugging)
+
+    // Streaming
+    bool streamTemplate = false;                    // Write each top-level template node as soon as it is parsed, then free it
+
+    // SSR output
+    std::string ssrDir = "ssr";                     // Generated C++ sources (SSR mode)
+
+    // Size budgets
+    bool sizeReport = false;                        // Print output sizes (raw, gzip) and top contributors
+    std::vector<SizeBudget> budgets;                // Fail the build when an output exceeds its budget
+
+    // Safety limits
+    size_t maxTemplateDepth = 1024;                 // Element nesting (parser) and component nesting (render)
 
     // Verbose output
-    bool verbose = false;                           // Print verbose output
+    bool verbose = false;                           // Print verbose output (includes the phase profile)
+    std::string profileFile;                        // Write the phase/memory profile as JSON here (empty = off)
+    std::string renderProfilePrefix;                // Write per-component render costs to <prefix>.txt/.folded (empty = off)
+    MetricsRegistry* metrics = nullptr;             // Update operational counters here (not owned; null = off)
     bool silent = false;                            // Suppress all output
 
     /**
@@ -79,6 +101,20 @@ struct CompilerOptions {
         return getOutputPath() / "style.css";
     }
 
+    /**
+     * @brief Get path to output class name map (when mangling)
+     */
+    std::filesystem::path getClassMapOutputPath() const {
+        return getOutputPath() / classMapFile;
+    }
+
+    /**
+     * @brief Get path to generated SSR sources
+     */
+    std::filesystem::path getSsrOutputPath() const {
+        return getOutputPath() / ssrDir;
+    }
+
     /**
      * @brief Validate options
      * @return true if valid, false otherwise
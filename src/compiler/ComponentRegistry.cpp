@@ -1,72 +1,281 @@
 #include "ComponentRegistry.h"
-#include <iostream>
+#include <algorithm>
 #include <filesystem>
+#include <iterator>
 
 namespace artic {
 
+namespace {
+
+// Heap bytes of a string beyond the object itself (0 while it fits the SSO buffer)
+size_t heapBytes(const std::string& text) {
+    return text.capacity() > std::string().capacity() ? text.capacity() + 1 : 0;
+}
+
+template <typename T>
+size_t heapBytes(const std::vector<T>& items) {
+    return items.capacity() * sizeof(T);
+}
+
+size_t templateBytes(const std::vector<std::unique_ptr<TemplateNode>>& roots) {
+    size_t bytes = 0;
+
+    // Explicit stack: template nesting is only bounded by the depth limit
+    std::vector<const std::vector<std::unique_ptr<TemplateNode>>*> lists = {&roots};
+    while (!lists.empty()) {
+        const auto* nodes = lists.back();
+        lists.pop_back();
+        bytes += heapBytes(*nodes);
+
+        for (const auto& node : *nodes) {
+            switch (node->type) {
+                case ASTNodeType::ELEMENT: {
+                    const auto* element = static_cast<const Element*>(node.get());
+                    bytes += sizeof(Element) + heapBytes(element->tagName) + heapBytes(element->attributes) +
+                             heapBytes(element->classDirectives);
+                    for (const auto& attribute : element->attributes) {
+                        bytes += sizeof(Attribute) + heapBytes(attribute->name) + heapBytes(attribute->value);
+                    }
+                    for (const auto& directive : element->classDirectives) {
+                        bytes += sizeof(ClassDirective) + heapBytes(directive->tokens);
+                    }
+                    if (element->slotDirective) {
+                        bytes += sizeof(SlotDirective) + heapBytes(element->slotDirective->slotName);
+                    }
+                    lists.push_back(&element->children);
+                    break;
+                }
+                case ASTNodeType::TEXT_NODE:
+                    bytes += sizeof(TextNode) + heapBytes(static_cast<const TextNode*>(node.get())->text);
+                    break;
+                case ASTNodeType::EXPRESSION_NODE:
+                    bytes += sizeof(ExpressionNode) +
+                             heapBytes(static_cast<const ExpressionNode*>(node.get())->expression);
+                    break;
+                case ASTNodeType::COMMENT_NODE:
+                    bytes += sizeof(CommentNode) + heapBytes(static_cast<const CommentNode*>(node.get())->comment);
+                    break;
+                case ASTNodeType::SLOT_NODE: {
+                    const auto* slot = static_cast<const SlotNode*>(node.get());
+                    bytes += sizeof(SlotNode) + heapBytes(slot->name);
+                    lists.push_back(&slot->fallback);
+                    break;
+                }
+                default:
+                    bytes += sizeof(TemplateNode);
+                    break;
+            }
+        }
+    }
+
+    return bytes;
+}
+
+/**
+ * @brief Estimated heap footprint of a parsed component
+ *
+ * Walks the AST adding node, string and vector sizes. Allocator overhead
+ * is not included, so this is a lower bound of what evicting it frees.
+ */
+size_t componentBytes(const Component& component) {
+    size_t bytes = sizeof(Component) + heapBytes(component.imports) + heapBytes(component.utilities);
+
+    if (component.route) {
+        bytes += sizeof(RouteDecorator) + heapBytes(component.route->path);
+    }
+    if (component.layout) {
+        bytes += sizeof(LayoutDecorator) + heapBytes(component.layout->layoutName);
+    }
+    for (const auto& import : component.imports) {
+        bytes += heapBytes(import->source);
+        if (import->type != ASTNodeType::NAMED_IMPORT) {
+            bytes += sizeof(ThemeImport);
+        } else {
+            const auto* named = static_cast<const NamedImport*>(import.get());
+            bytes += sizeof(NamedImport) + heapBytes(named->names);
+            for (const auto& name : named->names) {
+                bytes += heapBytes(name);
+            }
+        }
+    }
+    if (component.props) {
+        bytes += sizeof(PropsBlock) + heapBytes(component.props->props);
+        for (const auto& prop : component.props->props) {
+            bytes += sizeof(PropDeclaration) + heapBytes(prop->name) + heapBytes(prop->defaultValue);
+            if (prop->type) {
+                bytes += sizeof(PropType) + heapBytes(prop->type->typeString);
+            }
+        }
+    }
+    for (const auto& utility : component.utilities) {
+        bytes += sizeof(UtilityDeclaration) + heapBytes(utility->name) + heapBytes(utility->tokens);
+        for (const auto& token : utility->tokens) {
+            bytes += sizeof(UtilityToken) + heapBytes(token->prefix) + heapBytes(token->property) +
+                     heapBytes(token->value);
+        }
+    }
+
+    return bytes + templateBytes(component.templateNodes);
+}
+
+} // namespace
+
+ComponentRegistry::PagePin::PagePin(ComponentRegistry& registry, const Component* page)
+    : m_registry(registry), m_names(registry.closure(page)) {
+    for (const auto& name : m_names) {
+        m_registry.m_entries.at(name).pins++;
+    }
+}
+
+ComponentRegistry::PagePin::PagePin(ComponentRegistry& registry, const std::vector<std::string>& names)
+    : m_registry(registry), m_names(registry.closureOf(names)) {
+    for (const auto& name : m_names) {
+        m_registry.m_entries.at(name).pins++;
+    }
+}
+
+ComponentRegistry::PagePin::~PagePin() {
+    for (const auto& name : m_names) {
+        m_registry.m_entries.at(name).pins--;
+    }
+    m_registry.evict({});
+}
+
 Component* ComponentRegistry::loadComponent(const std::string& filePath) {
+    std::string name;
+    return load(filePath, name);
+}
+
+Component* ComponentRegistry::load(const std::string& filePath, std::string& name) {
+    bool topLevel = m_loadDepth == 0;
+    if (topLevel) {
+        m_visitPass++;
+    }
+
+    m_loadDepth++;
+    Component* component = loadFile(filePath, name);
+    m_loadDepth--;
+
+    if (topLevel && component) {
+        evict({name});
+    }
+    return component;
+}
+
+Component* ComponentRegistry::loadFile(const std::string& filePath, std::string& name) {
     // Resolve to absolute path
     std::string absPath;
     try {
-        absPath = std::filesystem::absolute(filePath).string();
+        absPath = std::filesystem::absolute(filePath).lexically_normal().string();
     } catch (const std::exception& e) {
-        std::cerr << "Error resolving path '" << filePath << "': " << e.what() << std::endl;
+        ARTIC_LOG_ERROR(*m_logger, "Error resolving path '" + filePath + "': " + e.what());
         return nullptr;
     }
 
-    // Check if already loaded
+    // Check if already loaded (evicted components are parsed again)
     auto it = m_pathToName.find(absPath);
     if (it != m_pathToName.end()) {
-        // Already loaded, return cached component
-        return m_components[it->second].get();
+        auto cached = m_components.find(it->second);
+        if (cached != m_components.end()) {
+            // Already loaded, return cached component
+            if (m_metrics) {
+                m_metrics->componentCacheHits.inc();
+            }
+            name = it->second;
+            touch(name);
+            return cached->second.get();
+        }
     }
 
     // Check for circular dependency
     if (isCircularDependency(absPath)) {
-        std::cerr << "Circular dependency detected: " << absPath << std::endl;
+        ARTIC_LOG_ERROR(*m_logger, "Circular dependency detected: " + absPath);
         return nullptr;
     }
 
     // Mark as loading
     m_loading.insert(absPath);
+    if (m_metrics) {
+        m_metrics->componentCacheMisses.inc();
+    }
+
+    // Read, lex and parse cost of this file alone (imports get their own entry)
+    FileProfile fileProfile{absPath, {}};
 
     // Read file
-    auto sourceOpt = FileSystem::readFile(absPath);
+    std::optional<std::string> sourceOpt;
+    {
+        PhaseSpan span(m_profile, CompilationPhase::Read, &fileProfile);
+        sourceOpt = FileSystem::readFile(absPath);
+    }
     if (!sourceOpt.has_value()) {
-        std::cerr << "Failed to read file: " << absPath << std::endl;
+        ARTIC_LOG_ERROR(*m_logger, "Failed to read file: " + absPath);
         m_loading.erase(absPath);
         return nullptr;
     }
-    std::string source = sourceOpt.value();
+    std::string source = std::move(sourceOpt.value());
 
     // Lex
-    Lexer lexer(source);
-    std::vector<Token> tokens = lexer.tokenize();
+    ARTIC_LOG_DEBUG(*m_logger, "Lexing " + absPath);
+    std::vector<Token> tokens;
+    {
+        PhaseSpan span(m_profile, CompilationPhase::Lex, &fileProfile);
+        Lexer lexer(source);
+        tokens = lexer.tokenize();
+    }
+    if (m_metrics) {
+        m_metrics->tokensLexed.inc(tokens.size());
+    }
 
     // Parse
-    Parser parser(tokens);
+    ARTIC_LOG_DEBUG(*m_logger, "Parsing " + absPath);
+    Parser parser(tokens, m_maxTemplateDepth);
     std::unique_ptr<Component> component;
 
     try {
+        PhaseSpan span(m_profile, CompilationPhase::Parse, &fileProfile);
         component = parser.parse();
     } catch (const ParseError& e) {
-        std::cerr << "Parse error in " << absPath << ": " << e.what() << std::endl;
+        ARTIC_LOG_ERROR(*m_logger, "Parse error in " + absPath + ": " + e.what());
         m_loading.erase(absPath);
         return nullptr;
     }
 
+    size_t parsedBytes = componentBytes(*component);
+
+    if (m_profile) {
+        m_profile->files.push_back(std::move(fileProfile));
+    }
+    if (m_metrics) {
+        m_metrics->filesParsed.inc();
+    }
+
     // Extract component name from file path
     std::string componentName = extractComponentName(absPath);
 
     // Load all imports for this component
     std::string baseDir = std::filesystem::path(absPath).parent_path().string();
-    loadImports(component.get(), baseDir);
+    std::vector<std::string> imports = loadImports(component.get(), baseDir);
+
+    // Cache component (replacing one with the same name from another directory)
+    Entry& entry = m_entries[componentName];
+    if (m_components.count(componentName)) {
+        m_lru.erase(entry.lru);
+        m_memoryUsage -= entry.bytes;
+    }
 
-    // Cache component
     Component* componentPtr = component.get();
     m_components[componentName] = std::move(component);
     m_pathToName[absPath] = componentName;
 
+    entry.path = absPath;
+    entry.imports = std::move(imports);
+    entry.bytes = parsedBytes;
+    entry.lru = m_lru.insert(m_lru.end(), componentName);
+    entry.visited = m_visitPass;
+    m_memoryUsage += parsedBytes;
+    name = componentName;
+
     // Done loading
     m_loading.erase(absPath);
 
@@ -85,9 +294,10 @@ bool ComponentRegistry::hasComponent(const std::string& componentName) const {
     return m_components.find(componentName) != m_components.end();
 }
 
-void ComponentRegistry::loadImports(Component* component, const std::string& baseDir) {
+std::vector<std::string> ComponentRegistry::loadImports(Component* component, const std::string& baseDir) {
+    std::vector<std::string> loaded;
     if (!component) {
-        return;
+        return loaded;
     }
 
     // Load all named imports: use { Card, Button } from "./components"
@@ -107,10 +317,11 @@ void ComponentRegistry::loadImports(Component* component, const std::string& bas
                 for (const auto& name : namedImport->names) {
                     std::string componentFile = (fsPath / (name + ".atc")).string();
 
-                    if (std::filesystem::exists(componentFile)) {
-                        loadComponent(componentFile);
-                    } else {
-                        std::cerr << "Warning: Component file not found: " << componentFile << std::endl;
+                    std::string loadedName;
+                    if (!std::filesystem::exists(componentFile)) {
+                        ARTIC_LOG_WARNING(*m_logger, "Component file not found: " + componentFile);
+                    } else if (load(componentFile, loadedName)) {
+                        loaded.push_back(loadedName);
                     }
                 }
             } else {
@@ -120,14 +331,109 @@ void ComponentRegistry::loadImports(Component* component, const std::string& bas
                     importPath += ".atc";
                 }
 
-                if (std::filesystem::exists(importPath)) {
-                    loadComponent(importPath);
+                std::string loadedName;
+                if (std::filesystem::exists(importPath) && load(importPath, loadedName)) {
+                    loaded.push_back(loadedName);
                 }
             }
         }
         // Note: ThemeImport (use theme "path") would be handled separately
         // For now, we focus on component imports
     }
+
+    return loaded;
+}
+
+std::vector<std::string> ComponentRegistry::loadPageImports(Component* page, const std::string& pagePath) {
+    std::filesystem::path absPath = std::filesystem::absolute(pagePath).lexically_normal();
+
+    m_visitPass++;
+    m_loadDepth++;
+    m_loading.insert(absPath.string());
+    std::vector<std::string> loaded = loadImports(page, absPath.parent_path().string());
+    m_loading.erase(absPath.string());
+    m_loadDepth--;
+
+    evict(loaded);
+    return loaded;
+}
+
+std::vector<std::string> ComponentRegistry::closure(const Component* root) const {
+    auto rootEntry = std::find_if(m_components.begin(), m_components.end(),
+                                  [&](const auto& loaded) { return loaded.second.get() == root; });
+    if (rootEntry == m_components.end()) {
+        return {};
+    }
+    return closureOf({rootEntry->first});
+}
+
+std::vector<std::string> ComponentRegistry::closureOf(std::vector<std::string> roots) const {
+    std::vector<std::string> names;
+    std::unordered_set<std::string> seen;
+    for (auto& root : roots) {
+        if (m_components.count(root) && seen.insert(root).second) {
+            names.push_back(std::move(root));
+        }
+    }
+
+    // Breadth-first over the recorded imports
+    for (size_t i = 0; i < names.size(); i++) {
+        auto entry = m_entries.find(names[i]);
+        if (entry == m_entries.end()) {
+            continue;
+        }
+        for (const auto& import : entry->second.imports) {
+            if (m_components.count(import) && seen.insert(import).second) {
+                names.push_back(import);
+            }
+        }
+    }
+
+    return names;
+}
+
+void ComponentRegistry::touch(const std::string& name) {
+    Entry& entry = m_entries.at(name);
+    if (entry.visited == m_visitPass) {
+        return;
+    }
+    entry.visited = m_visitPass;
+    m_lru.splice(m_lru.end(), m_lru, entry.lru);
+
+    // An import may have been evicted while this component stayed cached
+    std::vector<std::string> imports = entry.imports;
+    for (const auto& import : imports) {
+        std::string loadedName;
+        load(m_entries.at(import).path, loadedName);
+    }
+}
+
+void ComponentRegistry::evict(const std::vector<std::string>& keep) {
+    if (m_memoryBudget == 0 || m_memoryUsage <= m_memoryBudget) {
+        return;
+    }
+
+    std::vector<std::string> kept = closureOf(keep);
+
+    auto it = m_lru.begin();
+    while (it != m_lru.end() && m_memoryUsage > m_memoryBudget) {
+        std::string name = *it;
+        Entry& entry = m_entries.at(name);
+        if (entry.pins > 0 || std::find(kept.begin(), kept.end(), name) != kept.end()) {
+            ++it;
+            continue;
+        }
+
+        ARTIC_LOG_DEBUG(*m_logger, "Evicted component " + name + " (" + std::to_string(entry.bytes) + " bytes)");
+        m_memoryUsage -= entry.bytes;
+        entry.bytes = 0;
+        m_components.erase(name);
+        it = m_lru.erase(it);
+
+        if (m_metrics) {
+            m_metrics->componentEvictions.inc();
+        }
+    }
 }
 
 std::string ComponentRegistry::resolvePath(const std::string& path, const std::string& baseDir) {
@@ -139,9 +445,9 @@ std::string ComponentRegistry::resolvePath(const std::string& path, const std::s
     }
 
     try {
-        return std::filesystem::absolute(fsPath).string();
+        return std::filesystem::absolute(fsPath).lexically_normal().string();
     } catch (const std::exception& e) {
-        std::cerr << "Error resolving path: " << e.what() << std::endl;
+        ARTIC_LOG_ERROR(*m_logger, std::string("Error resolving path: ") + e.what());
         return path;
     }
 }
@@ -4,11 +4,17 @@
 #include "frontend/lexer/Lexer.h"
 #include "frontend/ast/Component.h"
 #include "shared/utils/FileSystem.h"
+#include "compiler/CompilationProfile.h"
+#include "compiler/CompilerMetrics.h"
+#include "shared/utils/Logger.h"
+#include <cstdint>
 #include <string>
+#include <list>
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
 #include <filesystem>
+#include <vector>
 
 namespace artic {
 
@@ -21,11 +27,43 @@ namespace artic {
  * - Caching parsed components
  * - Resolving relative imports
  * - Detecting circular dependencies
+ * - Optionally, bounding the memory of cached components
+ *
+ * A registry can be shared by the compilers of every page of a site, so a
+ * component imported by many pages is parsed once. With a memory budget,
+ * the least recently used components that no pinned page needs are
+ * evicted and parsed again from their file when a page imports them.
  */
 class ComponentRegistry {
 public:
     ComponentRegistry() = default;
 
+    ComponentRegistry(const ComponentRegistry&) = delete;
+    ComponentRegistry& operator=(const ComponentRegistry&) = delete;
+
+    /**
+     * @brief Keeps a page and everything it imports loaded while in scope
+     */
+    class PagePin {
+    public:
+        PagePin(ComponentRegistry& registry, const Component* page);
+
+        /**
+         * @brief Pin loaded components (and their imports) by name
+         *
+         * For a page that is not itself cached, e.g. a streamed one.
+         */
+        PagePin(ComponentRegistry& registry, const std::vector<std::string>& names);
+        ~PagePin();
+
+        PagePin(const PagePin&) = delete;
+        PagePin& operator=(const PagePin&) = delete;
+
+    private:
+        ComponentRegistry& m_registry;
+        std::vector<std::string> m_names;
+    };
+
     /**
      * @brief Load and parse a component from file
      * @param filePath Absolute or relative path to .atc file
@@ -51,8 +89,26 @@ public:
      * @brief Load all components imported by a component
      * @param component Component to load imports for
      * @param baseDir Base directory for resolving relative paths
+     * @return Names of the imports that loaded
+     */
+    std::vector<std::string> loadImports(Component* component, const std::string& baseDir);
+
+    /**
+     * @brief Load the imports of a page that is parsed outside the registry
+     *
+     * A top-level load: the page's file counts for circular imports and
+     * eviction afterwards keeps what was loaded. Pin the returned names
+     * while the page is generated.
+     * @param page Page being parsed (imports already parsed)
+     * @param pagePath Path of the page's .atc file
+     * @return Names of the imports that loaded
+     */
+    std::vector<std::string> loadPageImports(Component* page, const std::string& pagePath);
+
+    /**
+     * @brief Names of a loaded component and of everything it imports (transitively)
      */
-    void loadImports(Component* component, const std::string& baseDir);
+    std::vector<std::string> closure(const Component* root) const;
 
     /**
      * @brief Get all loaded components
@@ -62,7 +118,56 @@ public:
         return m_components;
     }
 
+    /**
+     * @brief Set the element/slot nesting limit for parsed templates
+     */
+    void setMaxTemplateDepth(size_t maxDepth) { m_maxTemplateDepth = maxDepth; }
+
+    /**
+     * @brief Record read/lex/parse cost of loaded files into a profile (null disables)
+     */
+    void setProfile(CompilationProfile* profile) { m_profile = profile; }
+
+    /**
+     * @brief Where load errors and warnings go (default: Logger::fallback())
+     */
+    void setLogger(const Logger* logger) { m_logger = logger; }
+
+    /**
+     * @brief Count loads, lexed tokens and cache hits (null disables)
+     */
+    void setMetrics(CompilerMetrics* metrics) { m_metrics = metrics; }
+
+    /**
+     * @brief Bound the estimated memory of cached components (0 = unlimited)
+     *
+     * Checked after each top-level load and when a page is unpinned. The
+     * page just loaded and pinned pages are never evicted, so a page larger
+     * than the budget still compiles; the budget is exceeded meanwhile.
+     */
+    void setMemoryBudget(size_t bytes) { m_memoryBudget = bytes; }
+
+    /**
+     * @brief Estimated bytes of the cached components
+     *
+     * Each component counts its AST's nodes, strings and vectors, measured
+     * once when it is parsed.
+     */
+    size_t memoryUsage() const { return m_memoryUsage; }
+
 private:
+    /**
+     * @brief Bookkeeping of a component, kept after it is evicted
+     */
+    struct Entry {
+        std::string path;                       // Absolute file path (reloaded from here)
+        std::vector<std::string> imports;       // Names of the imports that loaded
+        size_t bytes = 0;                       // Estimated footprint (while cached)
+        size_t pins = 0;                        // Pinned pages that need it
+        std::list<std::string>::iterator lru;   // Position in m_lru (while cached)
+        std::uint64_t visited = 0;              // Last touch() pass
+    };
+
     // Map: component name -> parsed component
     std::unordered_map<std::string, std::unique_ptr<Component>> m_components;
 
@@ -72,6 +177,53 @@ private:
     // Set of files currently being loaded (for circular dependency detection)
     std::unordered_set<std::string> m_loading;
 
+    // Nesting limit passed to the parser
+    size_t m_maxTemplateDepth = Parser::DEFAULT_MAX_DEPTH;
+
+    // Phase timings of the current compilation (optional)
+    CompilationProfile* m_profile = nullptr;
+
+    const Logger* m_logger = &Logger::fallback();
+
+    // Operational counters (optional)
+    CompilerMetrics* m_metrics = nullptr;
+
+    // Memory budget: bookkeeping by name, cached names least recently used first
+    std::unordered_map<std::string, Entry> m_entries;
+    std::list<std::string> m_lru;
+    size_t m_memoryBudget = 0;
+    size_t m_memoryUsage = 0;
+    size_t m_loadDepth = 0;         // Nested loadComponent() calls
+    std::uint64_t m_visitPass = 0;  // Incremented per top-level load
+
+    /**
+     * @brief loadComponent(), also returning the component's name
+     *
+     * Evicts down to the budget when a top-level load finishes.
+     */
+    Component* load(const std::string& filePath, std::string& name);
+
+    /**
+     * @brief Read, lex and parse a file (or return it from the cache)
+     */
+    Component* loadFile(const std::string& filePath, std::string& name);
+
+    /**
+     * @brief Mark a cached component as used, reloading evicted imports
+     */
+    void touch(const std::string& name);
+
+    /**
+     * @brief Names of loaded components and of everything they import (transitively)
+     */
+    std::vector<std::string> closureOf(std::vector<std::string> roots) const;
+
+    /**
+     * @brief Evict least recently used components until within the budget
+     * @param keep Components that must stay, with their imports (besides pinned ones)
+     */
+    void evict(const std::vector<std::string>& keep);
+
     /**
      * @brief Resolve relative path to absolute path
      * @param path Path to resolve (can be relative or absolute)
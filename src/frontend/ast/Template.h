@@ -163,7 +163,7 @@ public:
 };
 
 /**
- * @brief Comment node: {/* comment *\/}
+ * @brief Comment node: {/\* comment *\/}
  */
 class CommentNode : public TemplateNode {
 public:
@@ -3,8 +3,8 @@
 
 namespace artic {
 
-Lexer::Lexer(const std::string& source)
-    : m_source(source), m_position(0), m_location() {
+Lexer::Lexer(std::string source)
+    : m_source(std::move(source)), m_position(0), m_location() {
     initKeywords();
 }
 
@@ -34,14 +34,27 @@ std::vector<Token> Lexer::tokenize() {
         }
     }
 
-    // Add EOF token
+    // Add EOF token (at the end of the source)
+    m_tokenStart = m_location;
     tokens.push_back(makeToken(TokenType::END_OF_FILE, ""));
 
     return tokens;
 }
 
+Token Lexer::nextParserToken() {
+    while (!isAtEnd()) {
+        Token token = nextToken();
+        if (token.type != TokenType::COMMENT) {
+            return token;
+        }
+    }
+    m_tokenStart = m_location;
+    return makeToken(TokenType::END_OF_FILE, "");
+}
+
 Token Lexer::nextToken() {
     skipWhitespace();
+    m_tokenStart = m_location;
 
     if (isAtEnd()) {
         return makeToken(TokenType::END_OF_FILE, "");
@@ -80,6 +93,9 @@ Token Lexer::nextToken() {
         case '-': advance(); return makeToken(TokenType::MINUS, "-");
         case '*': advance(); return makeToken(TokenType::STAR, "*");
         case '!': advance(); return makeToken(TokenType::BANG, "!");
+        case '#': advance(); return makeToken(TokenType::HASH, "#");
+        case '%': advance(); return makeToken(TokenType::PERCENT, "%");
+        case '&': advance(); return makeToken(TokenType::AMPERSAND, "&");
 
         case '.':
             advance();
@@ -326,11 +342,11 @@ bool Lexer::isAlphaNumeric(char c) const {
 }
 
 Token Lexer::makeToken(TokenType type, const std::string& lexeme) {
-    return Token(type, lexeme, m_location.line, m_location.column);
+    return Token(type, lexeme, m_tokenStart.line, m_tokenStart.column);
 }
 
 Token Lexer::errorToken(const std::string& message) {
-    return Token(TokenType::ERROR, message, m_location.line, m_location.column);
+    return Token(TokenType::ERROR, message, m_tokenStart.line, m_tokenStart.column);
 }
 
 } // namespace artic
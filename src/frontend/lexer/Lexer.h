@@ -18,9 +18,9 @@ class Lexer {
 public:
     /**
      * @brief Construct a lexer with source code
-     * @param source The source code to tokenize
+     * @param source The source code to tokenize (moved in when possible)
      */
-    explicit Lexer(const std::string& source);
+    explicit Lexer(std::string source);
 
     /**
      * @brief Tokenize the entire source code
@@ -34,6 +34,14 @@ public:
      */
     Token nextToken();
 
+    /**
+     * @brief Next token of the sequence tokenize() returns, one at a time
+     *
+     * Comments are skipped; END_OF_FILE is returned at (and after) the end.
+     * Lets a parser stream a large file without holding all of its tokens.
+     */
+    Token nextParserToken();
+
     /**
      * @brief Check if at end of file
      */
@@ -43,6 +51,7 @@ private:
     std::string m_source;
     size_t m_position;
     SourceLocation m_location;
+    SourceLocation m_tokenStart;  // Where the token being scanned starts
     std::unordered_map<std::string, TokenType> m_keywords;
 
     /**
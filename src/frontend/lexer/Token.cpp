@@ -38,6 +38,9 @@ const char* tokenTypeToString(TokenType type) {
         case TokenType::STAR: return "STAR";
         case TokenType::SLASH: return "SLASH";
         case TokenType::BANG: return "BANG";
+        case TokenType::HASH: return "HASH";
+        case TokenType::PERCENT: return "PERCENT";
+        case TokenType::AMPERSAND: return "AMPERSAND";
         case TokenType::LPAREN: return "LPAREN";
         case TokenType::RPAREN: return "RPAREN";
         case TokenType::LBRACE: return "LBRACE";
@@ -68,7 +71,7 @@ bool Token::isLiteral() const {
 }
 
 bool Token::isOperator() const {
-    return type >= TokenType::EQUALS && type <= TokenType::BANG;
+    return type >= TokenType::EQUALS && type <= TokenType::AMPERSAND;
 }
 
 std::string Token::toString() const {
@@ -39,7 +39,7 @@ enum class TokenType {
     NULL_LITERAL,  // null
     UNDEFINED,     // undefined
 
-    // Operators
+    // Operators (contiguous: isOperator() checks EQUALS..AMPERSAND)
     EQUALS,        // =
     COLON,         // :
     QUESTION,      // ?
@@ -53,6 +53,9 @@ enum class TokenType {
     STAR,          // *
     SLASH,         // /
     BANG,          // !
+    HASH,          // #
+    PERCENT,       // %
+    AMPERSAND,     // &
 
     // Delimiters
     LPAREN,        // (
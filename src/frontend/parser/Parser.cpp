@@ -1,16 +1,28 @@
 #include "frontend/parser/Parser.h"
+#include <algorithm>
+#include <cctype>
 #include <sstream>
 
 namespace artic {
 
-Parser::Parser(const std::vector<Token>& tokens)
-    : m_tokens(tokens), m_position(0) {
-    if (!m_tokens.empty()) {
-        m_current = m_tokens[0];
+Parser::Parser(const std::vector<Token>& tokens, size_t maxDepth)
+    : m_position(0), m_maxDepth(maxDepth) {
+    if (!tokens.empty()) {
+        m_current = tokens[0];
+        m_pending.assign(tokens.begin() + 1, tokens.end());
     }
 }
 
+Parser::Parser(Lexer& lexer, size_t maxDepth)
+    : m_lexer(&lexer), m_position(0), m_current(lexer.nextParserToken()), m_maxDepth(maxDepth) {}
+
 std::unique_ptr<Component> Parser::parse() {
+    return parse([](Component& component, std::unique_ptr<TemplateNode> node) {
+        component.addTemplateNode(std::move(node));
+    });
+}
+
+std::unique_ptr<Component> Parser::parse(const TemplateNodeHandler& onNode) {
     auto component = std::make_unique<Component>();
 
     // Skip leading newlines
@@ -31,7 +43,7 @@ std::unique_ptr<Component> Parser::parse() {
     parseUtilities(component.get());
 
     // 5. Template (required)
-    parseTemplate(component.get());
+    parseTemplate(component.get(), onNode);
 
     return component;
 }
@@ -43,11 +55,18 @@ Token& Parser::current() {
 }
 
 Token Parser::peek(int offset) const {
-    size_t pos = m_position + offset;
-    if (pos >= m_tokens.size()) {
-        return m_tokens.back(); // Return END_OF_FILE
+    if (offset <= 0) {
+        return m_current;
+    }
+
+    size_t needed = static_cast<size_t>(offset);
+    while (m_lexer && m_pending.size() < needed) {
+        m_pending.push_back(m_lexer->nextParserToken());
+    }
+    if (m_pending.size() < needed) {
+        return m_pending.empty() ? m_current : m_pending.back(); // Return END_OF_FILE
     }
-    return m_tokens[pos];
+    return m_pending[needed - 1];
 }
 
 bool Parser::isAtEnd() const {
@@ -58,8 +77,12 @@ Token Parser::advance() {
     Token previous = m_current;
     if (!isAtEnd()) {
         m_position++;
-        if (m_position < m_tokens.size()) {
-            m_current = m_tokens[m_position];
+        if (m_pending.empty() && m_lexer) {
+            m_pending.push_back(m_lexer->nextParserToken());
+        }
+        if (!m_pending.empty()) {
+            m_current = std::move(m_pending.front());
+            m_pending.pop_front();
         }
     }
     return previous;
@@ -91,6 +114,11 @@ void Parser::skipNewlines() {
     }
 }
 
+bool Parser::isAdjacent(const Token& first, const Token& second) const {
+    return first.line == second.line &&
+           first.column + static_cast<int>(first.lexeme.size()) == second.column;
+}
+
 ParseError Parser::error(const std::string& message) {
     return ParseError(m_current, message);
 }
@@ -412,50 +440,14 @@ std::unique_ptr<UtilityToken> Parser::parseUtilityToken() {
 
     // Check for colon (property:value or prefix:property:value)
     if (match(TokenType::COLON)) {
-        // Next could be a value or another property
-        if (check(TokenType::IDENTIFIER) || check(TokenType::NUMBER)) {
-            Token second = advance();
-
-            // Check if there's another colon (prefix:property:value case)
-            if (match(TokenType::COLON)) {
-                // This was prefix:property:value
-                prefix = property;
-                property = second.lexeme;
-
-                // Now parse the value
-                if (check(TokenType::IDENTIFIER) || check(TokenType::NUMBER)) {
-                    Token valueToken = advance();
-                    value = valueToken.lexeme;
-
-                    // Handle adjacent identifier after number (3xl, 2xl, etc.)
-                    if (valueToken.type == TokenType::NUMBER && check(TokenType::IDENTIFIER)) {
-                        value += advance().lexeme;
-                    }
-
-                    // Handle compound values like "blue-500"
-                    while (match(TokenType::MINUS)) {
-                        if (check(TokenType::IDENTIFIER) || check(TokenType::NUMBER)) {
-                            value += "-" + advance().lexeme;
-                        }
-                    }
-                }
-            } else {
-                // This was property:value (2 parts)
-                value = second.lexeme;
-
-                // Handle adjacent identifier after number (3xl, 2xl, etc.)
-                if (second.type == TokenType::NUMBER && check(TokenType::IDENTIFIER)) {
-                    value += advance().lexeme;
-                }
-
-                // Handle compound values like "blue-500"
-                while (match(TokenType::MINUS)) {
-                    if (check(TokenType::IDENTIFIER) || check(TokenType::NUMBER)) {
-                        value += "-" + advance().lexeme;
-                    }
-                }
-            }
+        // prefix:property:value — the middle part is a plain identifier
+        if (check(TokenType::IDENTIFIER) && peek(1).type == TokenType::COLON) {
+            prefix = property;
+            property = advance().lexeme;
+            advance(); // consume ':'
         }
+
+        value = parseUtilityValue();
     }
 
     return std::make_unique<UtilityToken>(
@@ -466,15 +458,60 @@ std::unique_ptr<UtilityToken> Parser::parseUtilityToken() {
     );
 }
 
+std::string Parser::parseUtilityValue() {
+    std::string value;
+
+    // Arbitrary value: [37px], [#1da1f2], [calc(100%_-_1rem)]
+    if (match(TokenType::LBRACKET)) {
+        value = "[";
+        while (!check(TokenType::RBRACKET) && !check(TokenType::NEWLINE) &&
+               !check(TokenType::RBRACE) && !isAtEnd()) {
+            value += advance().lexeme;
+        }
+        expect(TokenType::RBRACKET, "Expected ']' after arbitrary value");
+        value += "]";
+        return value;
+    }
+
+    if (!check(TokenType::IDENTIFIER) && !check(TokenType::NUMBER)) {
+        return value;
+    }
+
+    Token valueToken = advance();
+    value = valueToken.lexeme;
+
+    // Handle adjacent identifier after number (3xl, 2xl, etc.)
+    if (valueToken.type == TokenType::NUMBER && check(TokenType::IDENTIFIER) &&
+        isAdjacent(valueToken, current())) {
+        value += advance().lexeme;
+    }
+
+    // Handle compound values like "blue-500"
+    while (match(TokenType::MINUS)) {
+        if (check(TokenType::IDENTIFIER) || check(TokenType::NUMBER)) {
+            value += "-" + advance().lexeme;
+        }
+    }
+
+    // Handle fractions like "1/2"
+    if (valueToken.type == TokenType::NUMBER && check(TokenType::SLASH) &&
+        peek(1).type == TokenType::NUMBER) {
+        advance(); // consume '/'
+        value += "/" + advance().lexeme;
+    }
+
+    return value;
+}
+
 // ===== Template parsing =====
 
-void Parser::parseTemplate(Component* component) {
+void Parser::parseTemplate(Component* component, const TemplateNodeHandler& onNode) {
     skipNewlines();
 
     while (!isAtEnd() && check(TokenType::LT)) {
         auto node = parseTemplateNode();
         if (node) {
-            component->addTemplateNode(std::move(node));
+            onNode(*component, std::move(node));
         }
         skipNewlines();
     }
@@ -497,14 +534,73 @@ std::unique_ptr<TemplateNode> Parser::parseTemplateNode() {
 }
 
 std::unique_ptr<Element> Parser::parseElement() {
+    auto root = parseOpeningTag();
+    if (root->isSelfClosing) {
+        return root;
+    }
+
+    // Elements whose children are being parsed, innermost last. Nesting
+    // lives on this stack rather than the call stack, so deep templates
+    // cannot overflow it; the depth limit bounds it instead.
+    std::vector<Element*> open;
+    enterNesting();
+    open.push_back(root.get());
+
+    while (!open.empty()) {
+        Element* element = open.back();
+
+        // Closing tag of the innermost open element
+        if (check(TokenType::LT_SLASH) || isAtEnd()) {
+            parseClosingTag(element->tagName);
+            open.pop_back();
+            m_depth--;
+            continue;
+        }
+
+        size_t positionBefore = m_position;
+
+        if (!check(TokenType::LT) && !check(TokenType::LBRACE)) {
+            // Text content
+            auto textNode = parseTextNode();
+            if (textNode && !textNode->text.empty()) {
+                element->addChild(std::move(textNode));
+            }
+        } else if (check(TokenType::LT) && peek(1).type != TokenType::SLOT) {
+            // Child element: parse its opening tag, then its children on the stack
+            auto child = parseOpeningTag();
+            Element* childPtr = child.get();
+            bool selfClosing = child->isSelfClosing;
+            element->addChild(std::move(child));
+
+            if (!selfClosing) {
+                enterNesting();
+                open.push_back(childPtr);
+            }
+        } else {
+            // Slot or expression
+            auto child = parseTemplateNode();
+            if (child) {
+                element->addChild(std::move(child));
+            }
+        }
+
+        // Safety check: if we didn't advance, force advancement to prevent infinite loop
+        if (m_position == positionBefore && !check(TokenType::LT_SLASH) && !isAtEnd()) {
+            advance(); // Force advance to prevent infinite loop
+        }
+    }
+
+    return root;
+}
+
+std::unique_ptr<Element> Parser::parseOpeningTag() {
     Token ltToken = expect(TokenType::LT, "Expected '<'");
 
     // Get tag name
     Token tagToken = expect(TokenType::IDENTIFIER, "Expected tag name");
-    std::string tagName = tagToken.lexeme;
 
     auto element = std::make_unique<Element>(
-        tagName,
+        tagToken.lexeme,
         false,
         SourceLocation(ltToken.line, ltToken.column, 0)
     );
@@ -521,35 +617,10 @@ std::unique_ptr<Element> Parser::parseElement() {
     // Expect >
     expect(TokenType::GT, "Expected '>' or '/>'");
 
-    // Parse children (until closing tag)
-    while (!check(TokenType::LT_SLASH) && !isAtEnd()) {
-        size_t positionBefore = m_position;
-
-        // Check for text content
-        if (!check(TokenType::LT) && !check(TokenType::LBRACE)) {
-            auto textNode = parseTextNode();
-            if (textNode && !textNode->text.empty()) {
-                element->addChild(std::move(textNode));
-            }
-        } else {
-            auto child = parseTemplateNode();
-            if (child) {
-                element->addChild(std::move(child));
-            }
-        }
-
-        // Safety check: if we didn't advance, force advancement to prevent infinite loop
-        if (m_position == positionBefore && !check(TokenType::LT_SLASH) && !isAtEnd()) {
-            advance(); // Force advance to prevent infinite loop
-        }
-
-        // Break if we hit the closing tag
-        if (check(TokenType::LT_SLASH)) {
-            break;
-        }
-    }
+    return element;
+}
 
-    // Parse closing tag
+void Parser::parseClosingTag(const std::string& tagName) {
     expect(TokenType::LT_SLASH, "Expected '</'");
     Token closingTag = expect(TokenType::IDENTIFIER, "Expected closing tag name");
 
@@ -558,8 +629,13 @@ std::unique_ptr<Element> Parser::parseElement() {
     }
 
     expect(TokenType::GT, "Expected '>' after closing tag");
+}
 
-    return element;
+void Parser::enterNesting() {
+    if (m_depth >= m_maxDepth) {
+        throw error("Template nesting exceeds the maximum depth of " + std::to_string(m_maxDepth));
+    }
+    m_depth++;
 }
 
 void Parser::parseAttributesAndDirectives(Element* element) {
@@ -680,7 +756,7 @@ std::unique_ptr<TextNode> Parser::parseTextNode() {
 std::unique_ptr<ExpressionNode> Parser::parseExpressionNode() {
     expect(TokenType::LBRACE, "Expected '{'");
 
-    std::string expr = collectText();
+    std::string expr = collectExpression();
 
     expect(TokenType::RBRACE, "Expected '}'");
 
@@ -712,6 +788,9 @@ std::unique_ptr<SlotNode> Parser::parseSlotNode() {
     // Expect >
     expect(TokenType::GT, "Expected '>' or '/>'");
 
+    // Fallback content nests elements inside the slot
+    enterNesting();
+
     // Parse fallback content until closing tag
     while (!check(TokenType::LT_SLASH) && !isAtEnd()) {
         size_t positionBefore = m_position;
@@ -755,10 +834,70 @@ std::unique_ptr<SlotNode> Parser::parseSlotNode() {
     }
 
     expect(TokenType::GT, "Expected '>' after closing slot tag");
+    m_depth--;
 
     return slotNode;
 }
 
+std::string Parser::collectExpression() {
+    // Rebuild the source text of the expression: string literals are quoted
+    // again and tokens are separated only where the source had whitespace,
+    // so operators like "==", "&&" and "<=" survive as written
+    std::string expr;
+    int braceDepth = 0;
+    int previousLine = -1;  // None yet
+    size_t previousEnd = 0;
+
+    while (!isAtEnd()) {
+        if (check(TokenType::RBRACE)) {
+            if (braceDepth == 0) {
+                break;
+            }
+            braceDepth--;
+        } else if (check(TokenType::LBRACE)) {
+            braceDepth++;
+        }
+
+        if (check(TokenType::NEWLINE) || check(TokenType::COMMENT)) {
+            advance();
+            continue;
+        }
+
+        const Token& token = m_current;
+
+        std::string text = token.lexeme;
+        if (token.type == TokenType::STRING) {
+            text = "\"";
+            for (char c : token.lexeme) {
+                switch (c) {
+                    case '"': text += "\\\""; break;
+                    case '\\': text += "\\\\"; break;
+                    case '\n': text += "\\n"; break;
+                    case '\t': text += "\\t"; break;
+                    default: text += c; break;
+                }
+            }
+            text += '"';
+        }
+
+        // Tokens record their start column; string lexemes exclude the quotes
+        size_t sourceLength = token.lexeme.size() + (token.type == TokenType::STRING ? 2 : 0);
+        size_t start = static_cast<size_t>(token.column);
+
+        bool adjacent = previousLine == token.line && previousEnd == start;
+        if (!expr.empty() && !adjacent) {
+            expr += ' ';
+        }
+        expr += text;
+
+        previousEnd = start + sourceLength;
+        previousLine = token.line;
+        advance();
+    }
+
+    return expr;
+}
+
 std::string Parser::collectText() {
     std::string text;
 
@@ -4,6 +4,8 @@
 #include "frontend/lexer/Lexer.h"
 #include "frontend/ast/Component.h"
 #include "ParseError.h"
+#include <deque>
+#include <functional>
 #include <vector>
 #include <memory>
 #include <string>
@@ -18,11 +20,33 @@ namespace artic {
  */
 class Parser {
 public:
+    /**
+     * @brief Default limit for element and slot nesting in templates
+     */
+    static constexpr size_t DEFAULT_MAX_DEPTH = 1024;
+
     /**
      * @brief Construct parser with tokens
      * @param tokens Vector of tokens from Lexer
+     * @param maxDepth Maximum element/slot nesting before a ParseError is thrown
+     */
+    explicit Parser(const std::vector<Token>& tokens, size_t maxDepth = DEFAULT_MAX_DEPTH);
+
+    /**
+     * @brief Construct parser pulling tokens from a lexer as it goes
+     *
+     * Only the current token and one of lookahead are held, not the whole
+     * file's tokens. The lexer must outlive the parser.
      */
-    explicit Parser(const std::vector<Token>& tokens);
+    explicit Parser(Lexer& lexer, size_t maxDepth = DEFAULT_MAX_DEPTH);
+
+    /**
+     * @brief Receives each top-level template node as soon as it is parsed
+     *
+     * The component has everything that precedes the template (metadata,
+     * imports, props, utilities) but no template nodes.
+     */
+    using TemplateNodeHandler = std::function<void(Component& component, std::unique_ptr<TemplateNode> node)>;
 
     /**
      * @brief Parse tokens into Component AST
@@ -31,10 +55,23 @@ public:
      */
     std::unique_ptr<Component> parse();
 
+    /**
+     * @brief Parse, handing top-level template nodes to a handler instead of keeping them
+     *
+     * With the lexer constructor, memory stays proportional to the largest
+     * top-level node rather than to the whole template.
+     * @return The component without template nodes
+     * @throws ParseError on syntax error (nodes before it were already handled)
+     */
+    std::unique_ptr<Component> parse(const TemplateNodeHandler& onNode);
+
 private:
-    std::vector<Token> m_tokens;
-    size_t m_position;
+    mutable std::deque<Token> m_pending;  // Tokens after m_current (filled by peek() when streaming)
+    Lexer* m_lexer = nullptr;             // Token source when streaming
+    size_t m_position;                    // Tokens consumed so far
     Token m_current;
+    size_t m_maxDepth;
+    size_t m_depth = 0;  // Currently open elements and slots
 
     // ===== Helper methods =====
 
@@ -80,6 +117,11 @@ private:
      */
     void skipNewlines();
 
+    /**
+     * @brief Check if two tokens touch in the source (no whitespace between)
+     */
+    bool isAdjacent(const Token& first, const Token& second) const;
+
     /**
      * @brief Create parse error
      */
@@ -163,9 +205,14 @@ private:
     std::unique_ptr<UtilityToken> parseUtilityToken();
 
     /**
-     * @brief Parse template nodes
+     * @brief Parse utility value (4, blue-500, 2xl, 1/2, [37px])
      */
-    void parseTemplate(Component* component);
+    std::string parseUtilityValue();
+
+    /**
+     * @brief Parse template nodes, passing each top-level one to onNode
+     */
+    void parseTemplate(Component* component, const TemplateNodeHandler& onNode);
 
     /**
      * @brief Parse single template node (element, text, expression)
@@ -174,9 +221,27 @@ private:
 
     /**
      * @brief Parse element: <tag>...</tag>
+     *
+     * Nested elements are parsed with an explicit stack (no recursion per level).
      */
     std::unique_ptr<Element> parseElement();
 
+    /**
+     * @brief Parse opening tag with attributes: <tag ...> or <tag ... />
+     */
+    std::unique_ptr<Element> parseOpeningTag();
+
+    /**
+     * @brief Parse closing tag </tag> and check it matches
+     */
+    void parseClosingTag(const std::string& tagName);
+
+    /**
+     * @brief Count one more open element or slot
+     * @throws ParseError if the nesting limit is exceeded
+     */
+    void enterNesting();
+
     /**
      * @brief Parse attributes and directives for an element
      */
@@ -211,6 +276,11 @@ private:
      * @brief Collect text until < or { is found
      */
     std::string collectText();
+
+    /**
+     * @brief Collect the source of an expression up to its closing }
+     */
+    std::string collectExpression();
 };
 
 } // namespace artic
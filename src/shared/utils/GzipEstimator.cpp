@@ -0,0 +1,222 @@
+#include "shared/utils/GzipEstimator.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace artic {
+
+namespace {
+
+constexpr size_t WINDOW_SIZE = 32768;
+constexpr size_t MIN_MATCH = 3;
+constexpr size_t MAX_MATCH = 258;
+constexpr size_t MAX_CHAIN = 128;          // Candidates tried per position (zlib -6 uses 128)
+constexpr size_t HASH_BITS = 15;
+constexpr size_t BLOCK_SYMBOLS = 16384;    // Symbols per deflate block (zlib's default buffer)
+constexpr size_t GZIP_OVERHEAD = 18;       // 10-byte header + CRC32 + size
+constexpr double TABLE_BITS_PER_SYMBOL = 5;  // Rough cost of a code length in the block header
+
+// RFC 1951, 3.2.5: first length/distance of each code and its extra bits
+constexpr std::array<std::uint16_t, 29> LENGTH_BASE = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr std::array<std::uint8_t, 29> LENGTH_EXTRA = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+constexpr std::array<std::uint16_t, 30> DISTANCE_BASE = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+constexpr std::array<std::uint8_t, 30> DISTANCE_EXTRA = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+template <size_t N>
+size_t codeFor(const std::array<std::uint16_t, N>& bases, size_t value) {
+    return static_cast<size_t>(std::upper_bound(bases.begin(), bases.end(), value) - bases.begin()) - 1;
+}
+
+/**
+ * @brief Symbol statistics of one deflate block
+ */
+struct Block {
+    std::array<size_t, 286> literalLength{};  // 0-255 literals, 256 end of block, 257+ lengths
+    std::array<size_t, 30> distance{};
+    double extraBits = 0;
+    size_t symbols = 0;
+
+    void literal(unsigned char c) {
+        literalLength[c]++;
+        symbols++;
+    }
+
+    void match(size_t length, size_t dist) {
+        size_t lengthCode = codeFor(LENGTH_BASE, length);
+        size_t distanceCode = codeFor(DISTANCE_BASE, dist);
+        literalLength[257 + lengthCode]++;
+        distance[distanceCode]++;
+        extraBits += LENGTH_EXTRA[lengthCode] + DISTANCE_EXTRA[distanceCode];
+        symbols++;
+    }
+
+    // Entropy-coded size of the block (bits), Huffman table included
+    double bits() {
+        literalLength[256]++;  // End of block
+        return entropyBits(literalLength.begin(), literalLength.end()) +
+               entropyBits(distance.begin(), distance.end()) + extraBits + 3;
+    }
+
+    template <typename It>
+    static double entropyBits(It first, It last) {
+        double total = 0;
+        size_t used = 0;
+        for (It it = first; it != last; ++it) {
+            total += static_cast<double>(*it);
+            used += *it > 0 ? 1 : 0;
+        }
+
+        double bits = 0;
+        for (It it = first; it != last; ++it) {
+            if (*it > 0) {
+                double count = static_cast<double>(*it);
+                // Huffman codes are at least one bit long
+                bits += count * std::max(1.0, std::log2(total / count));
+            }
+        }
+        return bits + static_cast<double>(used) * TABLE_BITS_PER_SYMBOL;
+    }
+};
+
+std::uint32_t hash3(const unsigned char* p) {
+    std::uint32_t value = (std::uint32_t(p[0]) << 16) | (std::uint32_t(p[1]) << 8) | p[2];
+    return (value * 2654435761u) >> (32 - HASH_BITS);
+}
+
+} // namespace
+
+/**
+ * @brief LZ77 state carried between chunks
+ *
+ * Positions are absolute offsets into the whole input; buffer holds the
+ * bytes from base onward (the window behind pos plus the lookahead).
+ */
+struct GzipEstimator::State {
+    std::vector<std::int64_t> head = std::vector<std::int64_t>(size_t(1) << HASH_BITS, -1);
+    std::vector<std::int64_t> prev = std::vector<std::int64_t>(WINDOW_SIZE, -1);
+    std::vector<unsigned char> buffer;
+    size_t base = 0;   // Absolute position of buffer[0]
+    size_t pos = 0;    // Next position to encode
+    double bits = 0;
+    Block block;
+
+    size_t size() const { return base + buffer.size(); }
+    const unsigned char* at(size_t position) const { return buffer.data() + (position - base); }
+
+    // Encode positions up to end; until the input is complete, stop early
+    // enough that every match search sees as many bytes as it would in
+    // one pass (MAX_MATCH, plus MIN_MATCH to hash the last matched byte)
+    void encode(size_t end) {
+        const size_t size = this->size();
+
+        auto insert = [&](size_t p) {
+            if (p + MIN_MATCH <= size) {
+                std::uint32_t h = hash3(at(p));
+                prev[p % WINDOW_SIZE] = head[h];
+                head[h] = static_cast<std::int64_t>(p);
+            }
+        };
+
+        while (pos < end) {
+            size_t bestLength = 0;
+            size_t bestDistance = 0;
+
+            if (pos + MIN_MATCH <= size) {
+                std::int64_t candidate = head[hash3(at(pos))];
+                size_t limit = std::min(MAX_MATCH, size - pos);
+
+                for (size_t chain = 0; candidate >= 0 && chain < MAX_CHAIN; chain++) {
+                    size_t distance = pos - static_cast<size_t>(candidate);
+                    if (distance > WINDOW_SIZE - 1) {
+                        break;
+                    }
+
+                    const unsigned char* a = at(static_cast<size_t>(candidate));
+                    const unsigned char* b = at(pos);
+                    size_t length = 0;
+                    while (length < limit && a[length] == b[length]) {
+                        length++;
+                    }
+                    if (length > bestLength) {
+                        bestLength = length;
+                        bestDistance = distance;
+                        if (length == limit) {
+                            break;
+                        }
+                    }
+
+                    std::int64_t next = prev[static_cast<size_t>(candidate) % WINDOW_SIZE];
+                    if (next >= candidate) {
+                        break;  // Slot reused by a newer position
+                    }
+                    candidate = next;
+                }
+            }
+
+            if (bestLength >= MIN_MATCH) {
+                block.match(bestLength, bestDistance);
+                for (size_t i = 0; i < bestLength; i++) {
+                    insert(pos + i);
+                }
+                pos += bestLength;
+            } else {
+                block.literal(*at(pos));
+                insert(pos);
+                pos++;
+            }
+
+            if (block.symbols == BLOCK_SYMBOLS) {
+                bits += block.bits();
+                block = Block();
+            }
+        }
+    }
+};
+
+GzipEstimator::GzipEstimator() : m_state(std::make_unique<State>()) {}
+
+GzipEstimator::~GzipEstimator() = default;
+
+void GzipEstimator::update(std::string_view data) {
+    State& state = *m_state;
+    state.buffer.insert(state.buffer.end(), data.begin(), data.end());
+
+    constexpr size_t LOOKAHEAD = MAX_MATCH + MIN_MATCH;
+    if (state.size() < state.pos + LOOKAHEAD) {
+        return;
+    }
+    state.encode(state.size() - LOOKAHEAD);
+
+    // Drop bytes that fell out of the window (in bulk, to amortize the move)
+    if (state.pos - state.base > 2 * WINDOW_SIZE) {
+        size_t drop = state.pos - WINDOW_SIZE - state.base;
+        state.buffer.erase(state.buffer.begin(), state.buffer.begin() + static_cast<std::ptrdiff_t>(drop));
+        state.base += drop;
+    }
+}
+
+size_t GzipEstimator::finish() {
+    State& state = *m_state;
+    state.encode(state.size());
+    state.bits += state.block.bits();
+    return GZIP_OVERHEAD + static_cast<size_t>(std::ceil(state.bits / 8));
+}
+
+size_t GzipEstimator::estimate(std::string_view data) {
+    GzipEstimator estimator;
+    estimator.update(data);
+    return estimator.finish();
+}
+
+} // namespace artic
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include "shared/utils/OutputSink.h"
+
+namespace artic {
+
+/**
+ * @brief Estimates the gzip-compressed size of text without zlib
+ *
+ * Runs deflate's LZ77 stage (32 KB window, hash chains, greedy matching)
+ * and prices the resulting symbols at their Shannon entropy plus the
+ * length/distance extra bits, a per-block Huffman table allowance and
+ * the gzip header and trailer. On HTML and CSS the estimate is usually
+ * within a few percent of `gzip -6`, which is enough for size budgets.
+ */
+class GzipEstimator {
+public:
+    GzipEstimator();
+    ~GzipEstimator();
+
+    GzipEstimator(const GzipEstimator&) = delete;
+    GzipEstimator& operator=(const GzipEstimator&) = delete;
+
+    /**
+     * @brief Feed the next chunk of data
+     *
+     * Only the 32 KB window and a short lookahead are kept, so memory does
+     * not grow with the input. Chunking does not change the estimate.
+     */
+    void update(std::string_view data);
+
+    /**
+     * @brief Estimated size in bytes of everything fed (call once, last)
+     */
+    size_t finish();
+
+    /**
+     * @brief Estimated size in bytes of data compressed with gzip
+     */
+    static size_t estimate(std::string_view data);
+
+private:
+    struct State;
+    std::unique_ptr<State> m_state;
+};
+
+/**
+ * @brief Sink that forwards to another sink and feeds a GzipEstimator
+ *
+ * Lets the size report measure outputs while they are written instead of
+ * reading the files back.
+ */
+class GzipMeasuringSink : public OutputSink {
+public:
+    GzipMeasuringSink(OutputSink& out, GzipEstimator& gzip) : m_out(out), m_gzip(gzip) {}
+
+    void write(const char* data, size_t size) override {
+        m_out.write(data, size);
+        m_gzip.update(std::string_view(data, size));
+    }
+    size_t size() const override { return m_out.size(); }
+    void flush() override { m_out.flush(); }
+
+private:
+    OutputSink& m_out;
+    GzipEstimator& m_gzip;
+};
+
+} // namespace artic
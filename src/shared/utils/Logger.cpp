@@ -0,0 +1,52 @@
+#include "shared/utils/Logger.h"
+#include <cstdio>
+
+namespace artic {
+
+namespace {
+
+std::string_view prefix(LogLevel level) {
+    switch (level) {
+        case LogLevel::Debug: return "  ";
+        case LogLevel::Warning: return "Warning: ";
+        case LogLevel::Error: return "ERROR: ";
+        case LogLevel::Info:
+        case LogLevel::Off: break;
+    }
+    return "";
+}
+
+} // namespace
+
+void StreamLogSink::write(LogLevel level, std::string_view message) {
+    // One buffer, one call: concurrent lines cannot interleave
+    std::string line;
+    std::string_view head = prefix(level);
+    line.reserve(head.size() + message.size() + 1);
+    line += head;
+    line += message;
+    if (line.empty() || line.back() != '\n') {
+        line += '\n';
+    }
+
+    if (level >= LogLevel::Warning) {
+        // Like std::cerr (tied to std::cout): earlier progress lines come first.
+        // Only warnings and errors pay for the flush
+        std::fflush(stdout);
+        std::fwrite(line.data(), 1, line.size(), stderr);
+    } else {
+        std::fwrite(line.data(), 1, line.size(), stdout);
+    }
+}
+
+StreamLogSink& StreamLogSink::shared() {
+    static StreamLogSink sink;
+    return sink;
+}
+
+Logger& Logger::fallback() {
+    static Logger logger(LogLevel::Warning);
+    return logger;
+}
+
+} // namespace artic
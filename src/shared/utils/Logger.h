@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Lowest level compiled in (0 debug, 1 info, 2 warning, 3 error, 4 off)
+ *
+ * Set with -DARTIC_MIN_LOG_LEVEL=<n> at configure time. Messages below it
+ * are removed by the ARTIC_LOG_* macros, arguments included.
+ */
+#ifndef ARTIC_MIN_LOG_LEVEL
+#define ARTIC_MIN_LOG_LEVEL 0
+#endif
+
+namespace artic {
+
+/**
+ * @brief Message severity (ordered)
+ */
+enum class LogLevel : std::uint8_t {
+    Debug,    // --verbose details
+    Info,     // Progress
+    Warning,
+    Error,
+    Off       // As a threshold: log nothing
+};
+
+/**
+ * @brief Lowest level compiled in, as a LogLevel
+ */
+constexpr LogLevel MIN_LOG_LEVEL = static_cast<LogLevel>(ARTIC_MIN_LOG_LEVEL);
+
+/**
+ * @brief Whether messages of a level are compiled in
+ */
+constexpr bool logLevelCompiledIn(LogLevel level) {
+    return level >= MIN_LOG_LEVEL;
+}
+
+/**
+ * @brief Destination of log lines
+ *
+ * write() receives one complete message and may be called from several
+ * threads at once.
+ */
+class LogSink {
+public:
+    virtual ~LogSink() = default;
+    virtual void write(LogLevel level, std::string_view message) = 0;
+};
+
+/**
+ * @brief Writes debug/info lines to stdout and warnings/errors to stderr
+ *
+ * Each message becomes one fwrite of the complete line (level prefix and
+ * newline included), so lines from parallel builds never interleave and
+ * progress lines are not flushed: the only synchronization is the stdio
+ * stream lock held for a single call. Warnings and errors flush stdout
+ * first so they appear after the progress that led to them.
+ */
+class StreamLogSink : public LogSink {
+public:
+    void write(LogLevel level, std::string_view message) override;
+
+    /**
+     * @brief Process-wide instance (the default sink of every Logger)
+     */
+    static StreamLogSink& shared();
+};
+
+/**
+ * @brief Levelled logger with deferred formatting
+ *
+ * Messages are only built when their level is enabled; use the macros so
+ * the message expression is not evaluated otherwise:
+ *
+ *   ARTIC_LOG_DEBUG(m_logger, "Generated " + std::to_string(bytes) + " bytes");
+ *
+ * A silent logger (threshold LogLevel::Off) costs one comparison per call
+ * site, and nothing at all below ARTIC_MIN_LOG_LEVEL.
+ */
+class Logger {
+public:
+    explicit Logger(LogLevel threshold = LogLevel::Info, LogSink* sink = &StreamLogSink::shared())
+        : m_threshold(threshold), m_sink(sink) {}
+
+    bool enabled(LogLevel level) const {
+        return level >= m_threshold && level != LogLevel::Off && m_sink != nullptr;
+    }
+
+    /**
+     * @brief Write an already formatted message (no level check)
+     */
+    void write(LogLevel level, std::string_view message) const { m_sink->write(level, message); }
+
+    LogLevel threshold() const { return m_threshold; }
+    void setThreshold(LogLevel threshold) { m_threshold = threshold; }
+    void setSink(LogSink* sink) { m_sink = sink; }
+
+    /**
+     * @brief Warnings and errors only, to the shared stream sink
+     */
+    static Logger& fallback();
+
+private:
+    LogLevel m_threshold;
+    LogSink* m_sink;
+};
+
+} // namespace artic
+
+// `message` is only evaluated when the level is compiled in and enabled
+#define ARTIC_LOG(logger, level, message)                                                  \
+    do {                                                                                   \
+        if constexpr (::artic::logLevelCompiledIn(level)) {                                \
+            if ((logger).enabled(level)) {                                                 \
+                (logger).write(level, (message));                                          \
+            }                                                                              \
+        }                                                                                  \
+    } while (0)
+
+#define ARTIC_LOG_DEBUG(logger, message) ARTIC_LOG(logger, ::artic::LogLevel::Debug, message)
+#define ARTIC_LOG_INFO(logger, message) ARTIC_LOG(logger, ::artic::LogLevel::Info, message)
+#define ARTIC_LOG_WARNING(logger, message) ARTIC_LOG(logger, ::artic::LogLevel::Warning, message)
+#define ARTIC_LOG_ERROR(logger, message) ARTIC_LOG(logger, ::artic::LogLevel::Error, message)
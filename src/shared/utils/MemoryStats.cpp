@@ -0,0 +1,108 @@
+#include "shared/utils/MemoryStats.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#if ARTIC_MEMORY_PROFILING
+
+namespace {
+
+// Every block starts with its size so frees can be subtracted from the
+// live total. The header keeps the user pointer aligned for any type.
+constexpr std::size_t HEADER_SIZE = alignof(std::max_align_t);
+
+std::atomic<std::uint64_t> g_allocationCount{0};
+std::atomic<std::uint64_t> g_allocatedBytes{0};
+std::atomic<std::uint64_t> g_liveBytes{0};
+std::atomic<std::uint64_t> g_peakLiveBytes{0};
+
+void raisePeak(std::uint64_t live) {
+    std::uint64_t peak = g_peakLiveBytes.load(std::memory_order_relaxed);
+    while (live > peak && !g_peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+}
+
+void* countedAllocate(std::size_t size) {
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    auto* block = static_cast<unsigned char*>(std::malloc(size + HEADER_SIZE));
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    *reinterpret_cast<std::size_t*>(block) = size;
+    raisePeak(g_liveBytes.fetch_add(size, std::memory_order_relaxed) + size);
+    return block + HEADER_SIZE;
+}
+
+void countedFree(void* p) noexcept {
+    if (!p) {
+        return;
+    }
+    auto* block = static_cast<unsigned char*>(p) - HEADER_SIZE;
+    g_liveBytes.fetch_sub(*reinterpret_cast<std::size_t*>(block), std::memory_order_relaxed);
+    std::free(block);
+}
+
+} // namespace
+
+// Replacement global allocation functions (the nothrow forms call these)
+void* operator new(std::size_t size) { return countedAllocate(size); }
+void* operator new[](std::size_t size) { return countedAllocate(size); }
+void operator delete(void* p) noexcept { countedFree(p); }
+void operator delete[](void* p) noexcept { countedFree(p); }
+void operator delete(void* p, std::size_t) noexcept { countedFree(p); }
+void operator delete[](void* p, std::size_t) noexcept { countedFree(p); }
+
+namespace artic {
+
+bool MemoryStats::available() { return true; }
+
+AllocationCounts MemoryStats::allocations() {
+    return {g_allocationCount.load(std::memory_order_relaxed), g_allocatedBytes.load(std::memory_order_relaxed)};
+}
+
+std::uint64_t MemoryStats::liveBytes() { return g_liveBytes.load(std::memory_order_relaxed); }
+std::uint64_t MemoryStats::peakLiveBytes() { return g_peakLiveBytes.load(std::memory_order_relaxed); }
+void MemoryStats::resetPeakLiveBytes() { g_peakLiveBytes.store(liveBytes(), std::memory_order_relaxed); }
+
+} // namespace artic
+
+#else
+
+// Without the replacement operators the counters are unavailable
+namespace artic {
+
+bool MemoryStats::available() { return false; }
+AllocationCounts MemoryStats::allocations() { return {}; }
+std::uint64_t MemoryStats::liveBytes() { return 0; }
+std::uint64_t MemoryStats::peakLiveBytes() { return 0; }
+void MemoryStats::resetPeakLiveBytes() {}
+
+} // namespace artic
+
+#endif
+
+namespace artic {
+
+std::size_t MemoryStats::peakResidentBytes() {
+#if defined(__unix__) || defined(__APPLE__)
+    struct rusage usage {};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#if defined(__APPLE__)
+    return static_cast<std::size_t>(usage.ru_maxrss);         // Bytes
+#else
+    return static_cast<std::size_t>(usage.ru_maxrss) * 1024;  // Kilobytes
+#endif
+#else
+    return 0;
+#endif
+}
+
+} // namespace artic
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace artic {
+
+/**
+ * @brief Heap allocations made so far (or between two points)
+ */
+struct AllocationCounts {
+    std::uint64_t count = 0;   // operator new calls
+    std::uint64_t bytes = 0;   // Bytes requested
+
+    AllocationCounts operator-(const AllocationCounts& earlier) const {
+        return {count - earlier.count, bytes - earlier.bytes};
+    }
+
+    AllocationCounts& operator+=(const AllocationCounts& other) {
+        count += other.count;
+        bytes += other.bytes;
+        return *this;
+    }
+};
+
+/**
+ * @brief Process memory statistics for benchmarks and reports
+ *
+ * Heap counters come from replacement global operator new/delete, which
+ * are only compiled into builds configured with -DARTIC_MEMORY_PROFILING=ON
+ * (each allocation then pays a few relaxed atomic updates and carries a
+ * small size header). Other builds allocate through the default operators
+ * at no cost; available() is false there and the counters read 0.
+ * Over-aligned allocations (operator new with std::align_val_t) are not
+ * counted.
+ */
+class MemoryStats {
+public:
+    /**
+     * @brief Whether this build counts heap allocations (ARTIC_MEMORY_PROFILING)
+     */
+    static bool available();
+
+    /**
+     * @brief Allocations since process start (zero when not available())
+     */
+    static AllocationCounts allocations();
+
+    /**
+     * @brief Heap bytes currently allocated through operator new
+     */
+    static std::uint64_t liveBytes();
+
+    /**
+     * @brief Highest liveBytes() since start or the last resetPeakLiveBytes()
+     */
+    static std::uint64_t peakLiveBytes();
+
+    /**
+     * @brief Restart peak tracking from the current live bytes
+     */
+    static void resetPeakLiveBytes();
+
+    /**
+     * @brief Peak resident set size of the process in bytes (0 if unavailable)
+     */
+    static std::size_t peakResidentBytes();
+};
+
+} // namespace artic
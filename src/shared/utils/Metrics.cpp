@@ -0,0 +1,205 @@
+#include "shared/utils/Metrics.h"
+#include "shared/utils/FileSystem.h"
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+
+namespace artic {
+
+namespace {
+
+std::string formatValue(double value) {
+    char buffer[32];
+    auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::general);
+    return ec == std::errc() ? std::string(buffer, end) : "NaN";
+}
+
+// Label values escape backslash, double quote and newline
+void appendLabelValue(std::string& out, const std::string& value) {
+    for (char c : value) {
+        switch (c) {
+            case '\\': out += "\\\\"; break;
+            case '"': out += "\\\""; break;
+            case '\n': out += "\\n"; break;
+            default: out += c;
+        }
+    }
+}
+
+// {a="1",b="2"} plus an optional trailing le label; nothing if both are empty
+std::string formatLabels(const MetricLabels& labels, const std::string& le = "") {
+    if (labels.empty() && le.empty()) {
+        return "";
+    }
+
+    std::string out = "{";
+    for (const auto& [name, value] : labels) {
+        if (out.size() > 1) {
+            out += ',';
+        }
+        out += name + "=\"";
+        appendLabelValue(out, value);
+        out += '"';
+    }
+    if (!le.empty()) {
+        out += (out.size() > 1 ? ",le=\"" : "le=\"") + le + '"';
+    }
+    out += '}';
+    return out;
+}
+
+} // namespace
+
+// ============================================================================
+// Histogram
+// ============================================================================
+
+Histogram::Histogram(std::vector<double> bounds)
+    : m_bounds(std::move(bounds)),
+      m_buckets(std::make_unique<std::atomic<std::uint64_t>[]>(m_bounds.size() + 1)) {
+    std::sort(m_bounds.begin(), m_bounds.end());
+}
+
+void Histogram::observe(double value) {
+    auto index = static_cast<size_t>(std::lower_bound(m_bounds.begin(), m_bounds.end(), value) - m_bounds.begin());
+    m_buckets[index].fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+}
+
+std::vector<std::uint64_t> Histogram::bucketCounts() const {
+    std::vector<std::uint64_t> counts(m_bounds.size() + 1);
+    for (size_t i = 0; i < counts.size(); i++) {
+        counts[i] = m_buckets[i].load(std::memory_order_relaxed);
+    }
+    return counts;
+}
+
+std::uint64_t Histogram::count() const {
+    std::uint64_t total = 0;
+    for (size_t i = 0; i <= m_bounds.size(); i++) {
+        total += m_buckets[i].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+std::vector<double> Histogram::exponentialBounds(double start, double factor, size_t count) {
+    std::vector<double> bounds;
+    bounds.reserve(count);
+    for (double bound = start; bounds.size() < count; bound *= factor) {
+        bounds.push_back(bound);
+    }
+    return bounds;
+}
+
+// ============================================================================
+// MetricsRegistry
+// ============================================================================
+
+struct MetricsRegistry::Family {
+    struct Series {
+        MetricLabels labels;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Histogram> histogram;
+    };
+
+    std::string name;
+    std::string help;
+    bool histogram = false;
+    std::vector<Series> series;
+
+    Series* find(const MetricLabels& labels) {
+        auto it = std::find_if(series.begin(), series.end(), [&](const Series& s) { return s.labels == labels; });
+        return it != series.end() ? &*it : nullptr;
+    }
+};
+
+MetricsRegistry::MetricsRegistry() = default;
+MetricsRegistry::~MetricsRegistry() = default;
+
+MetricsRegistry::Family& MetricsRegistry::family(const std::string& name, const std::string& help, bool histogram) {
+    auto it = std::find_if(m_families.begin(), m_families.end(),
+                           [&](const std::unique_ptr<Family>& f) { return f->name == name; });
+    if (it != m_families.end()) {
+        if ((*it)->histogram != histogram) {
+            throw std::invalid_argument("Metric '" + name + "' is already registered as a " +
+                                        ((*it)->histogram ? "histogram" : "counter"));
+        }
+        return **it;
+    }
+
+    auto created = std::make_unique<Family>();
+    created->name = name;
+    created->help = help;
+    created->histogram = histogram;
+    m_families.push_back(std::move(created));
+    return *m_families.back();
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help, const MetricLabels& labels) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Family& f = family(name, help, false);
+
+    if (auto* series = f.find(labels)) {
+        return *series->counter;
+    }
+    f.series.push_back({labels, std::make_unique<Counter>(), nullptr});
+    return *f.series.back().counter;
+}
+
+Histogram& MetricsRegistry::histogram(const std::string& name, const std::string& help,
+                                      const std::vector<double>& bounds, const MetricLabels& labels) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Family& f = family(name, help, true);
+
+    if (auto* series = f.find(labels)) {
+        return *series->histogram;
+    }
+    f.series.push_back({labels, nullptr, std::make_unique<Histogram>(bounds)});
+    return *f.series.back().histogram;
+}
+
+std::string MetricsRegistry::toPrometheus() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::string out;
+
+    for (const auto& f : m_families) {
+        out += "# HELP " + f->name + " " + f->help + "\n";
+        out += "# TYPE " + f->name + (f->histogram ? " histogram\n" : " counter\n");
+
+        for (const auto& series : f->series) {
+            if (!f->histogram) {
+                out += f->name + formatLabels(series.labels) + " " + std::to_string(series.counter->value()) + "\n";
+                continue;
+            }
+
+            // Buckets are cumulative; _count is the +Inf bucket
+            const Histogram& h = *series.histogram;
+            std::vector<std::uint64_t> counts = h.bucketCounts();
+            std::uint64_t cumulative = 0;
+            for (size_t i = 0; i < counts.size(); i++) {
+                cumulative += counts[i];
+                std::string le = i < h.bounds().size() ? formatValue(h.bounds()[i]) : "+Inf";
+                out += f->name + "_bucket" + formatLabels(series.labels, le) + " " + std::to_string(cumulative) + "\n";
+            }
+            out += f->name + "_sum" + formatLabels(series.labels) + " " + formatValue(h.sum()) + "\n";
+            out += f->name + "_count" + formatLabels(series.labels) + " " + std::to_string(cumulative) + "\n";
+        }
+    }
+
+    return out;
+}
+
+bool MetricsRegistry::writePrometheus(const std::string& path) const {
+    std::string temp = path + ".tmp";
+    if (!FileSystem::writeFile(temp, toPrometheus())) {
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temp, path, error);
+    return !error;
+}
+
+} // namespace artic
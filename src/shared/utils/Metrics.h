@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace artic {
+
+/**
+ * @brief Label name/value pairs of one series, e.g. {{"phase", "lex"}}
+ */
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+/**
+ * @brief Monotonic counter (one relaxed atomic add per update)
+ */
+class Counter {
+public:
+    void inc(std::uint64_t amount = 1) { m_value.fetch_add(amount, std::memory_order_relaxed); }
+    std::uint64_t value() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<std::uint64_t> m_value{0};
+};
+
+/**
+ * @brief Distribution of observed values over fixed buckets
+ *
+ * observe() is lock-free: one bucket increment and one add to the sum.
+ * Bucket bounds are upper bounds (value <= bound), ascending; values above
+ * the last one fall in the implicit +Inf bucket.
+ */
+class Histogram {
+public:
+    explicit Histogram(std::vector<double> bounds);
+
+    void observe(double value);
+
+    const std::vector<double>& bounds() const { return m_bounds; }
+
+    /**
+     * @brief Observations per bucket (not cumulative); the last one is +Inf
+     */
+    std::vector<std::uint64_t> bucketCounts() const;
+
+    std::uint64_t count() const;
+    double sum() const { return m_sum.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Bounds start, start*factor, ... (count of them)
+     */
+    static std::vector<double> exponentialBounds(double start, double factor, size_t count);
+
+private:
+    std::vector<double> m_bounds;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> m_buckets;  // bounds.size() + 1
+    std::atomic<double> m_sum{0};
+};
+
+/**
+ * @brief Named counters and histograms, exported in Prometheus text format
+ *
+ * Looking up a metric takes a lock, so resolve the ones a hot path needs
+ * once and keep the references: they stay valid for the registry's
+ * lifetime and updating them never locks. Asking again for the same name
+ * and labels returns the same series.
+ *
+ * Example:
+ * ```cpp
+ * MetricsRegistry metrics;
+ * Counter& files = metrics.counter("artic_files_parsed_total", "Component files parsed");
+ * files.inc();
+ * metrics.writePrometheus("artic.prom");
+ * ```
+ */
+class MetricsRegistry {
+public:
+    MetricsRegistry();
+    ~MetricsRegistry();
+
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    /**
+     * @brief Get or create a counter series
+     * @throws std::invalid_argument if the name is already a histogram
+     */
+    Counter& counter(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+
+    /**
+     * @brief Get or create a histogram series
+     * @param bounds Bucket upper bounds (ignored if the series exists)
+     * @throws std::invalid_argument if the name is already a counter
+     */
+    Histogram& histogram(const std::string& name, const std::string& help, const std::vector<double>& bounds,
+                         const MetricLabels& labels = {});
+
+    /**
+     * @brief All series in the Prometheus text exposition format (0.0.4)
+     */
+    std::string toPrometheus() const;
+
+    /**
+     * @brief Write toPrometheus() to a file
+     *
+     * Written to <path>.tmp and renamed, so a scraper (e.g. the node
+     * exporter textfile collector) never reads a partial file.
+     */
+    bool writePrometheus(const std::string& path) const;
+
+private:
+    struct Family;
+
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<Family>> m_families;  // Registration order
+
+    Family& family(const std::string& name, const std::string& help, bool histogram);
+};
+
+} // namespace artic
@@ -0,0 +1,95 @@
+#include "shared/utils/OutputSink.h"
+#include <algorithm>
+#include <cstring>
+
+namespace artic {
+
+void OutputSink::appendRepeated(char c, size_t count) {
+    static constexpr size_t CHUNK = 64;
+    char chunk[CHUNK];
+    std::memset(chunk, c, std::min(count, CHUNK));
+
+    while (count > 0) {
+        size_t n = std::min(count, CHUNK);
+        write(chunk, n);
+        count -= n;
+    }
+}
+
+StringSink::StringSink(size_t reserveBytes) {
+    m_buffer.reserve(reserveBytes);
+}
+
+FileSink::FileSink(const std::filesystem::path& filePath, size_t bufferBytes)
+    : m_buffer(bufferBytes > 0 ? bufferBytes : 1) {
+    auto parentPath = filePath.parent_path();
+    std::error_code ec;
+    if (!parentPath.empty() && !std::filesystem::exists(parentPath, ec)) {
+        std::filesystem::create_directories(parentPath, ec);
+    }
+
+    m_file = std::fopen(filePath.string().c_str(), "wb");
+    if (m_file) {
+        // We buffer ourselves; avoid a second copy inside stdio
+        std::setvbuf(m_file, nullptr, _IONBF, 0);
+    }
+}
+
+FileSink::~FileSink() {
+    close();
+}
+
+void FileSink::write(const char* data, size_t size) {
+    if (!m_file) {
+        return;
+    }
+
+    m_written += size;
+
+    // Small writes are coalesced in the buffer
+    if (m_used + size <= m_buffer.size()) {
+        std::memcpy(m_buffer.data() + m_used, data, size);
+        m_used += size;
+        return;
+    }
+
+    flush();
+
+    // Large writes bypass the buffer entirely
+    if (size >= m_buffer.size()) {
+        if (std::fwrite(data, 1, size, m_file) != size) {
+            m_failed = true;
+        }
+        return;
+    }
+
+    std::memcpy(m_buffer.data(), data, size);
+    m_used = size;
+}
+
+void FileSink::flush() {
+    if (!m_file || m_used == 0) {
+        return;
+    }
+
+    if (std::fwrite(m_buffer.data(), 1, m_used, m_file) != m_used) {
+        m_failed = true;
+    }
+    m_used = 0;
+}
+
+bool FileSink::close() {
+    if (!m_file) {
+        return false;
+    }
+
+    flush();
+    if (std::fclose(m_file) != 0) {
+        m_failed = true;
+    }
+    m_file = nullptr;
+
+    return !m_failed;
+}
+
+} // namespace artic
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace artic {
+
+/**
+ * @brief Append-only destination for generated output
+ *
+ * Generators write every byte straight into a sink instead of building and
+ * returning intermediate strings, so output is copied once regardless of
+ * how deeply it is nested.
+ */
+class OutputSink {
+public:
+    virtual ~OutputSink() = default;
+
+    /**
+     * @brief Append raw bytes
+     */
+    virtual void write(const char* data, size_t size) = 0;
+
+    /**
+     * @brief Total number of bytes written so far
+     */
+    virtual size_t size() const = 0;
+
+    /**
+     * @brief Flush buffered bytes to the underlying destination
+     */
+    virtual void flush() {}
+
+    void append(std::string_view text) { write(text.data(), text.size()); }
+    void append(char c) { write(&c, 1); }
+
+    /**
+     * @brief Append a character repeated count times (indentation)
+     */
+    void appendRepeated(char c, size_t count);
+
+    OutputSink& operator<<(std::string_view text) { append(text); return *this; }
+    OutputSink& operator<<(const char* text) { append(std::string_view(text)); return *this; }
+    OutputSink& operator<<(const std::string& text) { append(std::string_view(text)); return *this; }
+    OutputSink& operator<<(char c) { append(c); return *this; }
+};
+
+/**
+ * @brief Sink backed by a growable contiguous buffer
+ */
+class StringSink : public OutputSink {
+public:
+    explicit StringSink(size_t reserveBytes = 0);
+
+    void write(const char* data, size_t size) override { m_buffer.append(data, size); }
+    size_t size() const override { return m_buffer.size(); }
+
+    /**
+     * @brief View the accumulated output
+     */
+    const std::string& str() const { return m_buffer; }
+
+    /**
+     * @brief Move the accumulated output out of the sink
+     */
+    std::string take() { return std::move(m_buffer); }
+
+private:
+    std::string m_buffer;
+};
+
+/**
+ * @brief Sink that writes to a file through a fixed-size buffer
+ *
+ * Output never accumulates in memory beyond the buffer, which keeps peak
+ * memory independent of the size of the generated file.
+ */
+class FileSink : public OutputSink {
+public:
+    explicit FileSink(const std::filesystem::path& filePath, size_t bufferBytes = 64 * 1024);
+    ~FileSink() override;
+
+    FileSink(const FileSink&) = delete;
+    FileSink& operator=(const FileSink&) = delete;
+
+    /**
+     * @brief Check if the file was opened successfully
+     */
+    bool isOpen() const { return m_file != nullptr; }
+
+    /**
+     * @brief Check if every write so far succeeded
+     */
+    bool good() const { return m_file != nullptr && !m_failed; }
+
+    void write(const char* data, size_t size) override;
+    size_t size() const override { return m_written; }
+    void flush() override;
+
+    /**
+     * @brief Flush and close the file
+     * @return true if every write succeeded
+     */
+    bool close();
+
+private:
+    std::FILE* m_file = nullptr;
+    std::vector<char> m_buffer;
+    size_t m_used = 0;
+    size_t m_written = 0;
+    bool m_failed = false;
+};
+
+} // namespace artic
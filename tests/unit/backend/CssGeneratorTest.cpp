@@ -2,13 +2,25 @@
 #include <iostream>
 #include <string>
 #include <cassert>
+#include <thread>
+#include <vector>
 
 #include "frontend/lexer/Lexer.h"
 #include "frontend/parser/Parser.h"
 #include "backend/css/CssGenerator.h"
+#include "backend/css/CssMinifier.h"
 
 using namespace artic;
 
+void assert_not_contains(const std::string& haystack, const std::string& needle, const std::string& testName) {
+    if (haystack.find(needle) != std::string::npos) {
+        std::cerr << "FAILED: " << testName << "\n";
+        std::cerr << "  Expected NOT to find: \"" << needle << "\"\n";
+        std::cerr << "  In: \"" << haystack << "\"\n";
+        assert(false);
+    }
+}
+
 void assert_contains(const std::string& haystack, const std::string& needle, const std::string& testName) {
     if (haystack.find(needle) == std::string::npos) {
         std::cerr << "FAILED: " << testName << "\n";
@@ -348,6 +360,381 @@ void test12_CompleteButton() {
     std::cout << "PASSED ✓\n";
 }
 
+void test13_MinifiedOutput() {
+    std::cout << "Test 13: Minified output (no whitespace, short values)... ";
+
+    std::string source = R"(
+        @utility
+        btn {
+            px:4 m:0
+            bg:white
+            sm:py:2
+        }
+    )";
+
+    Lexer lexer(source);
+    auto tokens = lexer.tokenize();
+
+    Parser parser(tokens);
+    auto component = parser.parse();
+
+    CssGeneratorOptions options;
+    options.minify = true;
+    options.pretty = false;
+
+    CssGenerator generator(options);
+    std::string css = generator.generate(component.get());
+
+    if (css != ".btn{padding-left:1rem;padding-right:1rem;margin:0;background-color:#fff}"
+               "@media (min-width:640px){.btn{padding-top:.5rem;padding-bottom:.5rem}}") {
+        std::cerr << "FAILED: Test 13\n  Got: \"" << css << "\"\n";
+        assert(false);
+    }
+
+    std::cout << "PASSED ✓\n";
+}
+
+void test14_MinifierMergesAdjacentRules() {
+    std::cout << "Test 14: Minifier merges adjacent identical rules... ";
+
+    std::string source = R"(
+        @utility
+        title {
+            text:gray-900
+        }
+
+        @utility
+        heading {
+            text:gray-900
+        }
+
+        @utility
+        muted {
+            text:gray-500
+        }
+
+        @utility
+        inset {
+            px:4
+        }
+
+        @utility
+        gutter {
+            pl:4 pr:4
+        }
+    )";
+
+    Lexer lexer(source);
+    auto tokens = lexer.tokenize();
+
+    Parser parser(tokens);
+    auto component = parser.parse();
+
+    CssGeneratorOptions options;
+    options.minify = true;
+
+    CssGenerator generator(options);
+    std::string css = generator.generate(component.get());
+
+    assert_contains(css, ".title,.heading{color:#111827}", "Test 14");
+    assert_contains(css, ".muted{color:#6b7280}", "Test 14");
+    // Different tokens rendering the same body also merge
+    assert_contains(css, ".inset,.gutter{padding-left:1rem;padding-right:1rem}", "Test 14");
+    assert_not_contains(css, ";}", "Test 14");
+
+    std::cout << "PASSED ✓\n";
+}
+
+void test15_MinifierValues() {
+    std::cout << "Test 15: Minifier value compression... ";
+
+    assert(CssMinifier::minifyValue("#FFFFFF") == "#fff");
+    assert(CssMinifier::minifyValue("#3b82f6") == "#3b82f6");
+    assert(CssMinifier::minifyValue("#aabbccdd") == "#abcd");
+    assert(CssMinifier::minifyValue("0rem") == "0");
+    assert(CssMinifier::minifyValue("0.50rem") == ".5rem");
+    assert(CssMinifier::minifyValue("-0.25rem") == "-.25rem");
+    assert(CssMinifier::minifyValue("0%") == "0%");
+    assert(CssMinifier::minifyValue("rgba(0, 0, 0, 0.5)") == "rgba(0,0,0,.5)");
+    assert(CssMinifier::minifyDeclaration("border-radius: 9999px") == "border-radius:9999px");
+    assert(CssMinifier::minifyMediaQuery("@media (prefers-color-scheme: dark)") ==
+           "@media (prefers-color-scheme:dark)");
+
+    std::cout << "PASSED ✓\n";
+}
+
+void test16_PrettyMediaQuery() {
+    std::cout << "Test 16: Pretty media query nesting... ";
+
+    std::string source = R"(
+        @utility
+        box {
+            md:p:4
+        }
+    )";
+
+    Lexer lexer(source);
+    auto tokens = lexer.tokenize();
+
+    Parser parser(tokens);
+    auto component = parser.parse();
+
+    CssGenerator generator;
+    std::string css = generator.generate(component.get());
+
+    assert_contains(css, "@media (min-width: 768px) {\n  .box {\n    padding: 1rem;\n  }\n}", "Test 16");
+
+    std::cout << "PASSED ✓\n";
+}
+
+void test17_SharedResolverTables() {
+    std::cout << "Test 17: Shared resolver with compile-time tables... ";
+
+    const UtilityResolver& resolver = UtilityResolver::instance();
+    assert(&resolver == &UtilityResolver::instance());
+
+    auto spacing = resolver.resolve("mx", "64");
+    assert(spacing.size() == 2);
+    assert(spacing[0] == "margin-left: 16rem");
+    assert(spacing[1] == "margin-right: 16rem");
+
+    assert(resolver.resolve("block", "")[0] == "display: block");
+    assert(resolver.resolve("h", "screen")[0] == "height: 100vh");
+    assert(resolver.resolve("text", "xs")[1] == "line-height: 1rem");
+    assert(resolver.resolve("rounded", "")[0] == "border-radius: 0.375rem");
+    assert(resolver.resolve("unknown", "4").empty());
+    assert(resolver.isValidProperty("py"));
+    assert(resolver.getCssProperties("py").size() == 2);
+
+    std::cout << "PASSED ✓\n";
+}
+
+void test18_UtilityCache() {
+    std::cout << "Test 18: Memoized utility cache... ";
+
+    std::string source = R"(
+        @utility
+        btn {
+            px:4
+            hover:px:4
+        }
+
+        @utility
+        card {
+            px:4
+        }
+    )";
+
+    Lexer lexer(source);
+    auto tokens = lexer.tokenize();
+
+    Parser parser(tokens);
+    auto component = parser.parse();
+
+    UtilityCache cache;
+    CssGeneratorOptions options;
+    options.cache = &cache;
+
+    CssGenerator generator(options);
+    std::string css = generator.generate(component.get());
+
+    assert_contains(css, ".btn:hover", "Test 18");
+    assert_contains(css, ".card {\n  padding-left: 1rem;", "Test 18");
+
+    // px:4 resolved once, reused twice (prefix does not affect the key)
+    auto stats = cache.stats();
+    assert(stats.misses == 1);
+    assert(stats.hits == 2);
+    assert(stats.entries == 1);
+
+    // Concurrent lookups agree and never re-resolve a cached token
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&cache]() {
+            for (int i = 0; i < 1000; i++) {
+                auto entry = cache.resolve("bg", "blue-500");
+                assert(entry->block == "background-color: #3b82f6;\n");
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    stats = cache.stats();
+    assert(stats.entries == 2);
+    assert(stats.hits + stats.misses == 4003);
+
+    cache.clear();
+    assert(cache.stats().entries == 0);
+
+    // Arbitrary values are capped: a full cache evicts, and an evicted
+    // entry stays valid for whoever still holds it
+    UtilityCache small(UtilityResolver::instance(), 32);
+    auto first = small.resolve("w", "[1px]");
+    for (int i = 2; i <= 500; i++) {
+        small.resolve("w", "[" + std::to_string(i) + "px]");
+    }
+    stats = small.stats();
+    assert(stats.entries <= 32);
+    assert(stats.evictions >= 500 - 32);
+    assert(first->block == "width: 1px;\n");
+
+    std::cout << "PASSED ✓\n";
+}
+
+void test19_ParametricValues() {
+    std::cout << "Test 19: Parametric spacing, fractions, arbitrary values, palette... ";
+
+    std::string source = R"(
+        @utility
+        panel {
+            p:0.5 m:96 gap:px
+            w:1/2 h:[37px] w:2/3
+            bg:emerald-950 text:sky-400
+            mt:[calc(100%_-_1rem)] bg:[#1da1f2]
+        }
+    )";
+
+    Lexer lexer(source);
+    auto tokens = lexer.tokenize();
+
+    Parser parser(tokens);
+    auto component = parser.parse();
+
+    CssGenerator generator;
+    std::string css = generator.generate(component.get());
+
+    assert_contains(css, "padding: 0.125rem", "Test 19 spacing fraction");
+    assert_contains(css, "margin: 24rem", "Test 19 spacing beyond table");
+    assert_contains(css, "gap: 1px", "Test 19 px");
+    assert_contains(css, "width: 50%", "Test 19 1/2");
+    assert_contains(css, "width: 66.666667%", "Test 19 2/3");
+    assert_contains(css, "height: 37px", "Test 19 arbitrary");
+    assert_contains(css, "background-color: #022c22", "Test 19 palette");
+    assert_contains(css, "color: #38bdf8", "Test 19 palette");
+    assert_contains(css, "margin-top: calc(100% - 1rem)", "Test 19 arbitrary calc");
+    assert_contains(css, "background-color: #1da1f2", "Test 19 arbitrary color");
+
+    std::cout << "PASSED ✓\n";
+}
+
+void test20_StreamingWriter() {
+    std::cout << "Test 20: Streaming CSS writer... ";
+
+    std::string source = R"(
+        @utility
+        btn {
+            px:4 hover:bg:blue-700
+            md:px:6 bg:blue-500
+            hover:text:white
+        }
+
+        @utility
+        card {
+            p:4 dark:bg:gray-900
+        }
+    )";
+
+    Lexer lexer(source);
+    auto tokens = lexer.tokenize();
+
+    Parser parser(tokens);
+    auto component = parser.parse();
+
+    CssGenerator generator;
+    std::string css = generator.generate(component.get());
+
+    // Prefix groups keep first-appearance order, base rule first
+    std::string expected =
+        ".btn {\n"
+        "  padding-left: 1rem;\n"
+        "  padding-right: 1rem;\n"
+        "  background-color: #3b82f6;\n"
+        "}\n"
+        ".btn:hover {\n"
+        "  background-color: #1d4ed8;\n"
+        "  color: #ffffff;\n"
+        "}\n"
+        "@media (min-width: 768px) {\n"
+        "  .btn {\n"
+        "    padding-left: 1.5rem;\n"
+        "    padding-right: 1.5rem;\n"
+        "  }\n"
+        "}\n";
+    assert(css.substr(0, expected.size()) == expected);
+
+    // Writing into an existing sink appends; reusing the generator's
+    // scratch state gives identical output
+    StringSink sink;
+    sink.append("/* a */");
+    generator.generate(component.get(), sink);
+    assert(sink.str() == "/* a */" + css);
+
+    StringSink utilitySink;
+    generator.generateUtility(component->utilities[1].get(), utilitySink);
+    assert(utilitySink.str() == generator.generateUtility(component->utilities[1].get()));
+    assert_contains(utilitySink.str(), "@media (prefers-color-scheme: dark)", "Test 20");
+
+    // Compact (non-pretty) output
+    CssGeneratorOptions options;
+    options.pretty = false;
+    CssGenerator compact(options);
+    assert_contains(compact.generate(component.get()),
+                    "@media (min-width: 768px) {.btn {padding-left: 1.5rem;padding-right: 1.5rem;}}",
+                    "Test 20");
+
+    std::cout << "PASSED ✓\n";
+}
+
+void test21_MinifierMathFunctions() {
+    std::cout << "Test 21: Minifier keeps zero units inside math functions... ";
+
+    assert(CssMinifier::minifyValue("calc(100% - 0px)") == "calc(100% - 0px)");
+    assert(CssMinifier::minifyValue("min(0rem, 10vw)") == "min(0rem,10vw)");
+    assert(CssMinifier::minifyValue("clamp(0px, 0.50rem, 2rem)") == "clamp(0px,.5rem,2rem)");
+    assert(CssMinifier::minifyValue("calc(var(--gap, 0px) + 0em)") == "calc(var(--gap,0px) + 0em)");
+    assert(CssMinifier::minifyValue("calc(1px + 0px) 0px") == "calc(1px + 0px) 0");
+    assert(CssMinifier::minifyValue("translate(0px, 0rem)") == "translate(0,0)");
+
+    std::cout << "PASSED ✓\n";
+}
+
+void test22_MinifierQuotedStrings() {
+    std::cout << "Test 22: Minifier leaves quoted strings untouched... ";
+
+    assert(CssMinifier::minifyValue("\"a  b ,  c\"") == "\"a  b ,  c\"");
+    assert(CssMinifier::minifyValue("'Open  Sans', sans-serif") == "'Open  Sans',sans-serif");
+    assert(CssMinifier::minifyValue("\"0px\"  \"#FFFFFF\"") == "\"0px\" \"#FFFFFF\"");
+    assert(CssMinifier::minifyValue("url( \"a ( b ).png\" )") == "url(\"a ( b ).png\")");
+    assert(CssMinifier::minifyValue("\"say \\\"hi  there\\\"\"") == "\"say \\\"hi  there\\\"\"");
+    assert(CssMinifier::minifyDeclaration("content: \"  \"") == "content:\"  \"");
+
+    std::cout << "PASSED ✓\n";
+}
+
+void test23_AlignmentKeywords() {
+    std::cout << "Test 23: items/justify accept only alignment keywords... ";
+
+    const UtilityResolver& resolver = UtilityResolver::instance();
+    using Decls = std::vector<std::string>;
+
+    assert(resolver.resolve("items", "center") == Decls{"align-items: center"});
+    assert(resolver.resolve("items", "baseline") == Decls{"align-items: baseline"});
+    assert(resolver.resolve("justify", "between") == Decls{"justify-content: space-between"});
+    assert(resolver.resolve("justify", "space-evenly") == Decls{"justify-content: space-evenly"});
+    assert(resolver.resolve("justify", "start") == Decls{"justify-content: start"});
+
+    // Spacing values and keywords of the other property are rejected
+    assert(resolver.resolve("items", "4").empty());
+    assert(resolver.resolve("items", "[3px]").empty());
+    assert(resolver.resolve("items", "between").empty());
+    assert(resolver.resolve("justify", "baseline").empty());
+    assert(resolver.resolve("justify", "px").empty());
+
+    std::cout << "PASSED ✓\n";
+}
+
 int main() {
     std::cout << "=================================\n";
     std::cout << "  CSS GENERATOR UNIT TESTS\n";
@@ -366,6 +753,17 @@ int main() {
         test10_WidthHeight();
         test11_MultipleUtilities();
         test12_CompleteButton();
+        test13_MinifiedOutput();
+        test14_MinifierMergesAdjacentRules();
+        test15_MinifierValues();
+        test16_PrettyMediaQuery();
+        test17_SharedResolverTables();
+        test18_UtilityCache();
+        test19_ParametricValues();
+        test20_StreamingWriter();
+        test21_MinifierMathFunctions();
+        test22_MinifierQuotedStrings();
+        test23_AlignmentKeywords();
 
         std::cout << "\n=================================\n";
         std::cout << "  ALL TESTS PASSED! ✓\n";
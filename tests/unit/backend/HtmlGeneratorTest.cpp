@@ -2,10 +2,18 @@
 #include <iostream>
 #include <string>
 #include <cassert>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
 
 #include "frontend/lexer/Lexer.h"
 #include "frontend/parser/Parser.h"
 #include "backend/html/HtmlGenerator.h"
+#include "backend/html/HtmlEscape.h"
+#include "backend/html/RenderProfile.h"
+#include "shared/utils/OutputSink.h"
+#include "compiler/ComponentRegistry.h"
 
 using namespace artic;
 
@@ -352,6 +360,546 @@ void test13_Form() {
     std::cout << "PASSED ✓\n";
 }
 
+void test14_OutputSinks() {
+    std::cout << "Test 14: String and file sinks produce identical output... ";
+
+    std::string source = R"(
+        <section class:(page)>
+            <h1>Title</h1>
+            <p>Some <strong>bold</strong> text</p>
+            <img src="a.png" />
+        </section>
+    )";
+
+    Lexer lexer(source);
+    auto tokens = lexer.tokenize();
+
+    Parser parser(tokens);
+    auto component = parser.parse();
+
+    HtmlGenerator generator;
+    std::string expected = generator.generate(component.get());
+
+    // StringSink appends to an existing buffer
+    StringSink stringSink;
+    stringSink.append("prefix:");
+    generator.generate(component.get(), stringSink);
+    assert(stringSink.str() == "prefix:" + expected);
+    assert(stringSink.size() == expected.size() + 7);
+
+    // FileSink with a tiny buffer exercises flush and large-write paths
+    auto path = std::filesystem::temp_directory_path() / "artic_html_sink_test.html";
+    {
+        FileSink fileSink(path, 16);
+        assert(fileSink.isOpen());
+        generator.generate(component.get(), fileSink);
+        assert(fileSink.size() == expected.size());
+        assert(fileSink.close());
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    std::stringstream written;
+    written << file.rdbuf();
+    file.close();
+    std::filesystem::remove(path);
+
+    assert(written.str() == expected);
+
+    std::cout << "PASSED ✓\n";
+}
+
+void test15_FormatPolicies() {
+    std::cout << "Test 15: Pretty, compact and minified formatting... ";
+
+    std::string source = R"(<div><p>  Hi  </p>{/* note */}</div>)";
+
+    Lexer lexer(source);
+    auto tokens = lexer.tokenize();
+
+    Parser parser(tokens);
+    auto component = parser.parse();
+
+    HtmlGeneratorOptions options;
+    options.fullHtml = false;
+    options.includeDoctype = false;
+
+    // Pretty: indentation and newlines
+    std::string pretty = HtmlGenerator(options).generate(component.get());
+    assert_contains(pretty, "<div>\n", "Test 15");
+    assert_contains(pretty, "\n  <p>", "Test 15");
+
+    // Compact: no added whitespace, text kept as written
+    options.pretty = false;
+    std::string compact = HtmlGenerator(options).generate(component.get());
+    assert(compact.find('\n') == std::string::npos);
+    assert_contains(compact, "<div><p>", "Test 15");
+
+    // Minified: compact plus trimmed text; minify overrides pretty
+    options.pretty = true;
+    options.minify = true;
+    std::string minified = HtmlGenerator(options).generate(component.get());
+    assert(minified.find('\n') == std::string::npos);
+    assert(minified.size() <= compact.size());
+
+    std::cout << "PASSED ✓\n";
+}
+
+void test16_FragmentCache() {
+    std::cout << "Test 16: Repeated component uses reuse rendered fragments... ";
+
+    auto dir = std::filesystem::temp_directory_path() / "artic_fragment_cache_test";
+    std::filesystem::create_directories(dir);
+
+    std::ofstream(dir / "Badge.atc") << R"(
+        <span class:(badge)>{label}<slot /></span>
+    )";
+
+    // The Badge use site inside Row is rendered once per Row
+    std::ofstream(dir / "Row.atc") << "use { Badge } from \"" << (dir / "Badge.atc").string() << "\"\n" << R"(
+        <p>{n}<Badge label="row"><b>!</b></Badge></p>
+    )";
+
+    std::ofstream(dir / "Page.atc") << "use { Badge } from \"" << (dir / "Badge.atc").string() << "\"\n"
+                                    << "use { Row } from \"" << (dir / "Row.atc").string() << "\"\n" << R"(
+        <ul>
+            <li><Badge label="new" /></li>
+            <li><Badge label="new" /></li>
+            <li><Badge label="old" /></li>
+            <li><Badge label="new"><b>!</b></Badge></li>
+            <li><Badge label="new"><b>!</b></Badge></li>
+            <li><Row n="1" /></li>
+            <li><Row n="2" /></li>
+        </ul>
+    )";
+
+    ComponentRegistry registry;
+    Component* page = registry.loadComponent((dir / "Page.atc").string());
+    assert(page);
+
+    HtmlGeneratorOptions options;
+    options.cacheFragments = false;
+    std::string uncached = HtmlGenerator(options, &registry).generate(page);
+
+    options.cacheFragments = true;
+    HtmlGenerator generator(options, &registry);
+    std::string cached = generator.generate(page);
+
+    std::filesystem::remove_all(dir);
+
+    // Same output; repeated (props, slot content nodes) pairs hit the cache.
+    // Equal slot markup at two use sites is different content: both render
+    assert(cached == uncached);
+    auto stats = generator.fragmentCacheStats();
+    assert(stats.misses == 7);  // new, old, new+! twice, Row 1 and its Badge, Row 2
+    assert(stats.hits == 2);    // Second plain "new", Row 2's Badge
+    assert(stats.entries == 7);
+
+    std::cout << "PASSED ✓\n";
+}
+
+void test17_TemplateProgram() {
+    std::cout << "Test 17: Template IR coalesces static chunks... ";
+
+    // Consecutive writes merge into one chunk; holes split chunks
+    ProgramBuilder builder;
+    builder << "<li>" << "<b>";
+    builder.addExpression("label", "<!--{label}-->", TemplateExpression::compile("label"));
+    builder << "</b>" << "</li>";
+    auto program = builder.finish();
+
+    const auto& code = program->instructions();
+    assert(code.size() == 3);
+    assert(code[0].op == TemplateOp::Static);
+    assert(program->chunk(code[0]) == "<li><b>");
+    assert(code[1].op == TemplateOp::Expression);
+    assert(code[1].name == "label");
+    assert(program->chunk(code[1]) == "<!--{label}-->");
+    assert(program->chunk(code[2]) == "</b></li>");
+    assert(program->usesContext());
+
+    // A generator compiles once and renders identically on every call
+    std::string source = R"(
+        <nav class:(menu)>
+            <a href="/">Home</a>
+            <p>{title}</p>
+        </nav>
+    )";
+
+    Lexer lexer(source);
+    auto tokens = lexer.tokenize();
+
+    Parser parser(tokens);
+    auto component = parser.parse();
+
+    HtmlGenerator generator;
+    std::string first = generator.generate(component.get());
+    std::string second = generator.generate(component.get());
+    assert(first == second);
+    assert_contains(first, "<!-- Expression: {title} -->", "Test 17");
+
+    std::cout << "PASSED ✓\n";
+}
+
+void test18_HtmlEscaping() {
+    std::cout << "Test 18: Text and attribute escaping (" << HtmlEscape::kernelName() << ")... ";
+
+    assert(HtmlEscape::escape("Tom & Jerry <3") == "Tom &amp; Jerry &lt;3");
+    assert(HtmlEscape::escape("say \"hi\"") == "say \"hi\"");
+    assert(HtmlEscape::escape("say \"hi\" 'x'", EscapeContext::Attribute) == "say &quot;hi&quot; &#39;x&#39;");
+    assert(HtmlEscape::escape("&copy; &#169; &#xA9; & &x") == "&amp;copy; &amp;#169; &amp;#xA9; &amp; &amp;x");
+    assert(HtmlEscape::escape("&copy; &#169; &#xA9; & &x", EscapeContext::Text, EntityMode::Preserve)
+           == "&copy; &#169; &#xA9; &amp; &amp;x");
+
+    // Vector kernel agrees with the scalar scan at every offset and block boundary
+    for (size_t length = 0; length <= 80; length++) {
+        for (size_t hit = 0; hit <= length; hit++) {
+            std::string text(length, 'a');
+            if (hit < length) {
+                text[hit] = '"';
+            }
+            for (auto context : {EscapeContext::Text, EscapeContext::Attribute}) {
+                for (size_t from = 0; from <= length; from += 7) {
+                    assert(HtmlEscape::findSpecial(text, from, context) ==
+                           HtmlEscape::findSpecialScalar(text, from, context));
+                }
+            }
+        }
+    }
+
+    // Template text, attribute values and substituted props are escaped
+    auto dir = std::filesystem::temp_directory_path() / "artic_escape_test";
+    std::filesystem::create_directories(dir);
+
+    std::ofstream(dir / "Tag.atc") << R"(
+        <span>{label}</span>
+    )";
+
+    std::ofstream(dir / "Page.atc") << "use { Tag } from \"" << (dir / "Tag.atc").string() << "\"\n" << R"(
+        <div>
+            <a href="/search?q=a&b=c">Search</a>
+            <Tag label="<script>" />
+        </div>
+    )";
+
+    ComponentRegistry registry;
+    Component* page = registry.loadComponent((dir / "Page.atc").string());
+    assert(page);
+
+    HtmlGeneratorOptions options;
+    options.includeDoctype = false;
+    std::string html = HtmlGenerator(options, &registry).generate(page);
+
+    std::filesystem::remove_all(dir);
+
+    assert_contains(html, "href=\"/search?q=a&amp;b=c\"", "Test 18");
+    assert_contains(html, "<span>&lt;script&gt;</span>", "Test 18");
+    assert(html.find("<script>") == std::string::npos);
+
+    // Text nodes keep character references written in the source
+    TextNode text("Tom & Jerry &copy; 1 < 2");
+    assert(HtmlGenerator().generateNode(&text) == "Tom &amp; Jerry &copy; 1 &lt; 2");
+
+    std::cout << "PASSED ✓\n";
+}
+
+void test19_Minifier() {
+    std::cout << "Test 19: Minified output drops optional syntax... ";
+
+    std::string source = R"(
+        <div class:(box)>
+            <p>Hello <b>world</b>
+               again</p>
+            <pre>keep
+ this</pre>
+            <ul>
+                <li>One</li>
+                <li>Two</li>
+            </ul>
+            <input type="text" placeholder="Search here" />
+            <a href="/x">link</a>
+            <p>{missing}</p>
+        </div>
+    )";
+
+    Lexer lexer(source);
+    auto tokens = lexer.tokenize();
+
+    Parser parser(tokens);
+    auto component = parser.parse();
+
+    HtmlGeneratorOptions options;
+    options.minify = true;
+    std::string html = HtmlGenerator(options).generate(component.get());
+
+    // Document shell without newlines or unneeded quotes
+    assert(html.find('\n') == html.find("keep ") + 5);
+    assert_contains(html, "<!DOCTYPE html><html lang=en><head><meta charset=UTF-8>", "Test 19");
+    assert_contains(html, "content=\"width=device-width, initial-scale=1.0\"", "Test 19");
+
+    // Whitespace collapses, <pre> content is kept verbatim
+    assert_contains(html, "<div class=box><p>", "Test 19");
+    assert_contains(html, "</b> again", "Test 19");
+    assert_contains(html, "<pre>keep \n this</pre>", "Test 19");
+
+    // Optional end tags, void elements and placeholders
+    assert_contains(html, "<ul><li>One<li>Two</ul>", "Test 19");
+    assert_contains(html, "again<pre>", "Test 19");
+    assert_contains(html, "<input type=text placeholder=\"Search here\">", "Test 19");
+    assert_contains(html, "<a href=/x>link</a><p></div>", "Test 19");
+    assert(html.find("<!--") == std::string::npos);
+
+    // Each transformation can be turned off
+    options.removeAttributeQuotes = false;
+    options.omitOptionalTags = false;
+    std::string conservative = HtmlGenerator(options).generate(component.get());
+    assert_contains(conservative, "<ul><li>One</li><li>Two</li></ul>", "Test 19");
+    assert_contains(conservative, "<div class=\"box\">", "Test 19");
+
+    std::cout << "PASSED ✓\n";
+}
+
+void test20_RenderDepth() {
+    std::cout << "Test 20: Deep templates render without recursion, recursive components fail cleanly... ";
+
+    // Deeply nested markup compiles with an explicit stack
+    std::string source;
+    for (int i = 0; i < 3000; i++) source += "<div>";
+    source += "x";
+    for (int i = 0; i < 3000; i++) source += "</div>";
+
+    Lexer lexer(source);
+    auto tokens = lexer.tokenize();
+
+    Parser parser(tokens, 4096);
+    auto component = parser.parse();
+
+    HtmlGeneratorOptions options;
+    options.minify = true;
+    options.fullHtml = false;
+    options.includeDoctype = false;
+    std::string html = HtmlGenerator(options).generate(component.get());
+    assert(html.size() == 3000 * std::string("<div></div>").size() + 1);
+
+    // A component that uses itself hits the render depth limit
+    auto dir = std::filesystem::temp_directory_path() / "artic_render_depth_test";
+    std::filesystem::create_directories(dir);
+    std::ofstream(dir / "Loop.atc") << "use { Loop } from \"./Loop.atc\"\n<div><Loop /></div>\n";
+
+    ComponentRegistry registry;
+    Component* loop = registry.loadComponent((dir / "Loop.atc").string());
+    std::filesystem::remove_all(dir);
+    assert(loop);
+
+    options.maxRenderDepth = 64;
+    bool threw = false;
+    try {
+        HtmlGenerator(options, &registry).generate(loop);
+    } catch (const RenderError& e) {
+        threw = std::string(e.what()).find("<Loop>") != std::string::npos;
+    }
+    assert(threw);
+
+    std::cout << "PASSED ✓\n";
+}
+
+void test21_ExpressionFolding() {
+    std::cout << "Test 21: Expressions fold at compile time and evaluate against props... ";
+
+    // Evaluator semantics
+    auto eval = [](const std::string& source) {
+        auto expr = TemplateExpression::compile(source);
+        assert(expr);
+        auto value = expr->evaluate(nullptr);
+        return value ? value->toString() : std::string("<none>");
+    };
+    assert(eval("\"a\" + 1 + 2") == "a12");
+    assert(eval("1 + 2 * 3") == "7");
+    assert(eval("(1 + 2) * 3") == "9");
+    assert(eval("7 / 2") == "3.5");
+    assert(eval("1 / 0") == "<none>");
+    assert(eval("2 > 1 ? 'yes' : 'no'") == "yes");
+    assert(eval("!true || 'x'") == "x");
+    assert(eval("'3' == 3 && '3' !== 3") == "true");
+
+    // Number#toString formatting: positional below 1e21 and down to 1e-7
+    assert(eval("1234567") == "1234567");
+    assert(eval("10000000000000000") == "10000000000000000");
+    assert(eval("100000000000000000000") == "100000000000000000000");
+    assert(eval("1000000000000000000000") == "1e+21");
+    assert(eval("0 - 1234.5") == "-1234.5");
+    assert(eval("0.1 + 0.2") == "0.30000000000000004");
+    assert(eval("0.000001") == "0.000001");
+    assert(eval("0.0000001") == "1e-7");
+    assert(eval("0.00000015") == "1.5e-7");
+
+    // Relational comparisons with NaN are false
+    assert(eval("'NaN' <= 1") == "false");
+    assert(eval("'NaN' >= 1") == "false");
+    assert(eval("1 < 'NaN'") == "false");
+    assert(eval("'NaN' > 'NaN' * 1") == "false");
+    assert(!TemplateExpression::compile("items.map(render)"));
+    assert(!TemplateExpression::compile(std::string(1000, '(') + "1" + std::string(1000, ')')));
+
+    auto ref = TemplateExpression::compile("props.count * 2 + count");
+    assert(ref && !ref->isConstant() && ref->references().size() == 1);
+    assert(*TemplateExpression::compile(" props.title ")->simpleReference() == "title");
+
+    // Constants become static text; props resolve from attributes (typed by
+    // the declaration) or from declared defaults
+    auto dir = std::filesystem::temp_directory_path() / "artic_expression_test";
+    std::filesystem::create_directories(dir);
+    std::ofstream(dir / "Badge.atc")
+        << "props {\n  label: string = \"new\",\n  count: number = 1\n}\n"
+        << "<span>{label + \": \" + count * 10}</span>\n";
+    std::ofstream(dir / "Page.atc")
+        << "use { Badge } from \"./Badge.atc\"\n"
+        << "<div><b>{\"&copy; \" + 2000 + 24}</b><Badge count=\"2\" /><Badge label=\"<x>\" /><i>{other}</i></div>\n";
+
+    ComponentRegistry registry;
+    Component* page = registry.loadComponent((dir / "Page.atc").string());
+    std::filesystem::remove_all(dir);
+    assert(page);
+
+    HtmlGeneratorOptions options;
+    options.minify = true;
+    options.fullHtml = false;
+    options.includeDoctype = false;
+    HtmlGenerator generator(options, &registry);
+
+    const auto& code = generator.componentProgram(page).instructions();
+    assert(std::none_of(code.begin(), code.end(), [](const TemplateInstruction& instruction) {
+        return instruction.op == TemplateOp::Expression && instruction.expression && instruction.expression->isConstant();
+    }));
+
+    std::string html = generator.generate(page);
+    assert(html.find("<b>&copy; 200024</b>") != std::string::npos);
+    assert(html.find("<span>new: 20</span>") != std::string::npos);
+    assert(html.find("<span>&lt;x&gt;: 10</span>") != std::string::npos);
+    assert(html.find("<i></i>") != std::string::npos);
+
+    std::cout << "PASSED ✓\n";
+}
+
+void test22_RenderProfile() {
+    std::cout << "Test 22: Render profile attributes bytes and expansions per component... ";
+
+    auto dir = std::filesystem::temp_directory_path() / "artic_render_profile_test";
+    std::filesystem::create_directories(dir);
+    std::ofstream(dir / "Icon.atc") << "<i>*</i>\n";
+    std::ofstream(dir / "Card.atc")
+        << "use { Icon } from \"./Icon.atc\"\n"
+        << "<div><Icon />{label}</div>\n";
+    std::ofstream(dir / "Page.atc")
+        << "use { Card } from \"./Card.atc\"\n"
+        << "<main>\n"
+        << "<Card label=\"hello\" />\n"
+        << "<Card label=\"hello\" />\n"
+        << "</main>\n";
+
+    ComponentRegistry registry;
+    Component* page = registry.loadComponent((dir / "Page.atc").string());
+    std::filesystem::remove_all(dir);
+    assert(page);
+
+    HtmlGeneratorOptions options;
+    options.minify = true;
+    options.fullHtml = false;
+    options.includeDoctype = false;
+    std::string plain = HtmlGenerator(options, &registry).generate(page);
+
+    RenderProfile profile("Page");
+    options.renderProfile = &profile;
+    std::string html = HtmlGenerator(options, &registry).generate(page);
+
+    // Profiling does not change the output
+    assert(html == plain);
+
+    auto components = profile.byComponent();
+    auto find = [&](const std::string& name) {
+        auto it = std::find_if(components.begin(), components.end(),
+                               [&](const RenderCostEntry& entry) { return entry.name == name; });
+        assert(it != components.end());
+        return it->cost;
+    };
+
+    // The second Card is copied from the fragment cache: Icon renders once
+    RenderCost pageCost = find("Page");
+    RenderCost card = find("Card");
+    RenderCost icon = find("Icon");
+    assert(components.front().name == "Page");
+    assert(pageCost.inclusiveBytes == html.size());
+    assert(card.expansions == 2 && card.cacheHits == 1);
+    assert(icon.expansions == 1 && icon.inclusiveBytes == std::string("<i>*</i>").size());
+    assert(card.inclusiveBytes == 2 * std::string("<div><i>*</i>hello</div>").size());
+    assert(pageCost.selfBytes + card.inclusiveBytes == pageCost.inclusiveBytes);
+    assert(card.selfBytes + icon.inclusiveBytes == card.inclusiveBytes);
+
+    // One call site per use: lines 3 and 4 of Page, line 2 of Card
+    auto sites = profile.byCallSite();
+    assert(sites.size() == 3);
+    assert(std::any_of(sites.begin(), sites.end(),
+                       [](const RenderCostEntry& entry) { return entry.name.rfind("Page:3:", 0) == 0; }));
+    assert(std::any_of(sites.begin(), sites.end(),
+                       [](const RenderCostEntry& entry) { return entry.name.rfind("Card:2:", 0) == 0; }));
+
+    // Folded stacks: self bytes add up to the whole page
+    std::istringstream folded(profile.foldedStacks(RenderMetric::Bytes));
+    std::string stack;
+    size_t weight = 0;
+    size_t total = 0;
+    bool sawIcon = false;
+    while (folded >> stack >> weight) {
+        total += weight;
+        sawIcon = sawIcon || stack == "Page;Card;Icon";
+    }
+    assert(sawIcon);
+    assert(total == html.size());
+
+    std::cout << "PASSED ✓\n";
+}
+
+void test23_DeepSlotFragmentKey() {
+    std::cout << "Test 23: Slot content nested to the depth limit is cached without recursion... ";
+
+    auto dir = std::filesystem::temp_directory_path() / "artic_deep_slot_test";
+    std::filesystem::create_directories(dir);
+    std::ofstream(dir / "Box.atc") << "<section><slot /></section>\n";
+
+    // <Box> plus its slot body fill the parser's whole nesting budget
+    size_t divs = Parser::DEFAULT_MAX_DEPTH - 1;
+    std::string body;
+    for (size_t i = 0; i < divs; i++) body += "<div>";
+    body += "x";
+    for (size_t i = 0; i < divs; i++) body += "</div>";
+
+    std::ofstream(dir / "Page.atc") << "use { Box } from \"./Box.atc\"\n<main>\n"
+                                    << "<Box>" << body << "</Box>\n</main>\n";
+
+    ComponentRegistry registry;
+    registry.setMaxTemplateDepth(Parser::DEFAULT_MAX_DEPTH + 1);  // <main> wraps it
+    Component* page = registry.loadComponent((dir / "Page.atc").string());
+    std::filesystem::remove_all(dir);
+    assert(page);
+
+    HtmlGeneratorOptions options;
+    options.minify = true;
+    options.fullHtml = false;
+    options.includeDoctype = false;
+    options.cacheFragments = false;
+    std::string uncached = HtmlGenerator(options, &registry).generate(page);
+
+    options.cacheFragments = true;
+    HtmlGenerator generator(options, &registry);
+    std::string cached = generator.generate(page);
+
+    assert(cached == uncached);
+    assert(cached.size() == std::string("<main><section></section></main>").size() + 1 +
+                            divs * std::string("<div></div>").size());
+    assert(generator.fragmentCacheStats().misses == 1);
+
+    std::cout << "PASSED ✓\n";
+}
+
 int main() {
     std::cout << "=================================\n";
     std::cout << "  HTML GENERATOR UNIT TESTS\n";
@@ -371,6 +919,16 @@ int main() {
         test11_CompleteComponent();
         test12_Button();
         test13_Form();
+        test14_OutputSinks();
+        test15_FormatPolicies();
+        test16_FragmentCache();
+        test17_TemplateProgram();
+        test18_HtmlEscaping();
+        test19_Minifier();
+        test20_RenderDepth();
+        test21_ExpressionFolding();
+        test22_RenderProfile();
+        test23_DeepSlotFragmentKey();
 
         std::cout << "\n=================================\n";
         std::cout << "  ALL TESTS PASSED! ✓\n";
@@ -2,10 +2,15 @@
 #include <iostream>
 #include <string>
 #include <cassert>
+#include <cstdlib>
 
 #include "compiler/Compiler.h"
 #include "compiler/CompilerOptions.h"
 #include "shared/utils/FileSystem.h"
+#include "shared/utils/GzipEstimator.h"
+#include "shared/utils/Logger.h"
+#include "shared/utils/Metrics.h"
+#include <vector>
 
 using namespace artic;
 
@@ -230,6 +235,672 @@ void test8_IncludeDoctype() {
     std::cout << "PASSED ✓\n";
 }
 
+void test9_MangleClassNames() {
+    std::cout << "Test 9: Mangle utility class names... ";
+
+    std::string source = R"(
+        @utility
+        page_title {
+            text:2xl
+        }
+
+        @utility
+        card_content {
+            p:4
+        }
+
+        <div class:(card_content)>
+            <h1 class:(page_title)>Title</h1>
+            <p class:(card_content external)>One</p>
+            <p class:(card_content)>Two</p>
+            <span class="card_content b">Three</span>
+        </div>
+    )";
+
+    std::string tempFile = "test9.atc";
+    FileSystem::writeFile(tempFile, source);
+
+    CompilerOptions options;
+    options.inputFile = tempFile;
+    options.mangleClassNames = true;
+    options.silent = true;
+
+    Compiler compiler(options);
+    auto result = compiler.compileToString();
+
+    std::filesystem::remove(tempFile);
+
+    assert(result.success);
+
+    // Most used class gets the shortest name; unknown classes are untouched
+    // and short names skip them ("b" is used as a plain class)
+    assert(result.generatedCss.find(".a {") != std::string::npos);
+    assert(result.generatedCss.find(".c {") != std::string::npos);
+    assert(result.generatedCss.find(".b {") == std::string::npos);
+    assert(result.generatedCss.find("card_content") == std::string::npos);
+    assert(result.generatedHtml.find("class=\"a\"") != std::string::npos);
+    assert(result.generatedHtml.find("class=\"c\"") != std::string::npos);
+    assert(result.generatedHtml.find("class=\"a external\"") != std::string::npos);
+    assert(result.generatedHtml.find("class=\"a b\"") != std::string::npos);
+    assert(result.generatedHtml.find("card_content") == std::string::npos);
+    assert(result.classMap.find("\"card_content\": \"a\"") != std::string::npos);
+    assert(result.classMap.find("\"page_title\": \"c\"") != std::string::npos);
+
+    std::cout << "PASSED ✓\n";
+}
+
+void test10_SsrMode() {
+    std::cout << "Test 10: SSR mode generates C++ render functions... ";
+
+    std::string source = R"(
+        props {
+            title: string,
+            count?: number = 3
+        }
+
+        <section>
+            <h1>{title}</h1>
+            <p>{count}</p>
+            <slot />
+        </section>
+    )";
+
+    std::string tempFile = "test10.atc";
+    FileSystem::writeFile(tempFile, source);
+
+    CompilerOptions options;
+    options.inputFile = tempFile;
+    options.outputDir = "test10_output";
+    options.mode = CompilationMode::SSR;
+    options.silent = true;
+
+    Compiler compiler(options);
+    bool success = compiler.compile();
+
+    std::filesystem::remove(tempFile);
+
+    assert(success);
+    assert(FileSystem::fileExists(options.getCssOutputPath()));
+    assert(!FileSystem::fileExists(options.getHtmlOutputPath()));
+
+    auto ssrPath = options.getSsrOutputPath();
+    auto header = FileSystem::readFile(ssrPath / "Test10.h");
+    auto sourceFile = FileSystem::readFile(ssrPath / "Test10.cpp");
+    auto cmake = FileSystem::readFile(ssrPath / "CMakeLists.txt");
+    assert(header && sourceFile && cmake);
+    assert(FileSystem::fileExists(ssrPath / "artic_ssr_runtime.h"));
+
+    // Typed props from the props block, default slot as a callback
+    assert(header->find("std::string title;") != std::string::npos);
+    assert(header->find("double count = 3;") != std::string::npos);
+    assert(header->find("std::function<void(std::string&)> children;") != std::string::npos);
+    assert(header->find("void renderTest10Page(") != std::string::npos);
+
+    // Static chunks are appended directly; props are escaped
+    assert(sourceFile->find("out.append(\"<section>") != std::string::npos);
+    assert(sourceFile->find("artic_ssr::appendEscaped(out, props.title);") != std::string::npos);
+    assert(sourceFile->find("artic_ssr::appendNumber(out, props.count);") != std::string::npos);
+    assert(cmake->find("add_library(artic_pages STATIC") != std::string::npos);
+
+    // Cleanup
+    std::filesystem::remove_all("test10_output");
+
+    std::cout << "PASSED ✓\n";
+}
+
+void test11_PhaseProfile() {
+    std::cout << "Test 11: Phase profile... ";
+
+    std::string source = R"(
+        @utility
+        card {
+            px:4 py:2
+        }
+
+        <div class:(card)>Profiled</div>
+    )";
+
+    std::string tempFile = "test11.atc";
+    FileSystem::writeFile(tempFile, source);
+
+    CompilerOptions options;
+    options.inputFile = tempFile;
+    options.silent = true;
+
+    Compiler compiler(options);
+    auto first = compiler.compileToString();
+    assert(first.success);
+
+    // Every phase but write ran on the first compilation and allocated
+    // (allocations are only counted in ARTIC_MEMORY_PROFILING builds)
+    const auto& profile = compiler.profile();
+    for (size_t phase = 0; phase < COMPILATION_PHASE_COUNT; phase++) {
+        bool ran = static_cast<CompilationPhase>(phase) != CompilationPhase::Write;
+        assert((profile.time[phase].count() > 0) == ran);
+        assert((profile.allocations[phase].count > 0) == (ran && MemoryStats::available()));
+    }
+
+    // One entry per loaded file, matching the read + lex + parse totals
+    assert(profile.files.size() == 1);
+    assert(profile.files[0].path.find("test11.atc") != std::string::npos);
+    assert(profile.files[0].cost.allocations.count ==
+           profile.allocations[0].count + profile.allocations[1].count + profile.allocations[2].count);
+    assert(profile.toJson().find("\"parse\": {\"time_ms\": ") != std::string::npos);
+
+    // The component stays loaded: the second compilation only generates
+    auto second = compiler.compileToString();
+    std::filesystem::remove(tempFile);
+
+    assert(second.success);
+    assert(second.generatedHtml == first.generatedHtml);
+    assert(compiler.profile()[CompilationPhase::Read].count() == 0);
+    assert(compiler.profile()[CompilationPhase::Lex].count() == 0);
+    assert(compiler.profile()[CompilationPhase::Parse].count() == 0);
+    assert(compiler.profile()[CompilationPhase::Html].count() > 0);
+    assert(compiler.profile().files.empty());
+
+    std::cout << "PASSED ✓\n";
+}
+
+void test12_SizeBudgets() {
+    std::cout << "Test 12: Size report and budgets... ";
+
+    // Budget specs
+    auto general = SizeBudget::parse("html-gzip=20kb");
+    assert(general && general->route.empty() && general->metric == BudgetMetric::HtmlGzip);
+    assert(general->limit == 20 * 1024);
+    auto scoped = SizeBudget::parse("/docs:css=512");
+    assert(scoped && scoped->route == "/docs" && scoped->limit == 512);
+    assert(!SizeBudget::parse("html"));
+    assert(!SizeBudget::parse("js=1kb"));
+    assert(!SizeBudget::parse("css=12parsecs"));
+
+    // Gzip estimate: repetitive markup compresses far below its size
+    std::string repeated;
+    for (int i = 0; i < 500; i++) {
+        repeated += "<li><a href=\"/item\">Item</a></li>\n";
+    }
+    size_t estimate = GzipEstimator::estimate(repeated);
+    assert(estimate > 18 && estimate < repeated.size() / 20);
+
+    // Fed in small chunks (as a sink sees writes), the estimate is unchanged
+    std::string large;
+    for (int i = 0; i < 4000; i++) {
+        large += "<p class=\"c" + std::to_string(i % 97) + "\">Paragraph " + std::to_string(i * 7919) + "</p>\n";
+    }
+    GzipEstimator chunked;
+    for (size_t i = 0; i < large.size(); i += 13) {
+        chunked.update(std::string_view(large).substr(i, 13));
+    }
+    assert(chunked.finish() == GzipEstimator::estimate(large));
+
+    std::string source = R"(
+        @route("/docs")
+
+        @utility
+        card {
+            px:4 py:2 bg:blue-500 rounded:md
+        }
+
+        @utility
+        tag {
+            px:1
+        }
+
+        <section class:(card)><span class:(tag)>Docs</span></section>
+    )";
+
+    std::string tempFile = "test12.atc";
+    FileSystem::writeFile(tempFile, source);
+
+    CompilerOptions options;
+    options.inputFile = tempFile;
+    options.outputDir = "test12_output";
+    options.silent = true;
+    options.sizeReport = true;
+    options.budgets = {*SizeBudget::parse("html=1b"), *SizeBudget::parse("/docs:html=100kb"),
+                       *SizeBudget::parse("/other:css=1b")};
+
+    // The route-specific budget replaces the general one; /other does not apply
+    Compiler compiler(options);
+    assert(compiler.compile());
+
+    const auto& report = compiler.sizeReport();
+    assert(report && report->route == "/docs");
+    auto writtenHtml = FileSystem::readFile(options.getHtmlOutputPath());
+    assert(report->htmlBytes == writtenHtml->size());
+    assert(report->htmlGzipBytes == GzipEstimator::estimate(*writtenHtml));
+    assert(report->cssBytes > 0 && report->cssGzipBytes > 0);
+    assert(report->utilities.size() == 2 && report->utilities[0].name == "card");
+    assert(report->format().find("CSS by utility") != std::string::npos);
+
+    // Exceeded budget fails the build
+    options.budgets.push_back(*SizeBudget::parse("css-gzip=10"));
+    Compiler strict(options);
+    bool success = strict.compile();
+
+    std::filesystem::remove(tempFile);
+    std::filesystem::remove_all("test12_output");
+
+    assert(!success);
+    assert(strict.getLastError().find("css-gzip") != std::string::npos);
+
+    std::cout << "PASSED ✓\n";
+}
+
+void test13_Logging() {
+    std::cout << "Test 13: Levelled logging... ";
+
+    struct CaptureSink : LogSink {
+        std::vector<std::pair<LogLevel, std::string>> lines;
+        void write(LogLevel level, std::string_view message) override {
+            lines.emplace_back(level, std::string(message));
+        }
+    };
+
+    // Disabled levels never build their message. Levels below the
+    // ARTIC_MIN_LOG_LEVEL floor are not compiled in at all.
+    constexpr bool warningCompiledIn = logLevelCompiledIn(LogLevel::Warning);
+    CaptureSink sink;
+    Logger logger(LogLevel::Warning, &sink);
+    int formatted = 0;
+    auto message = [&] { formatted++; return std::string("built"); };
+    ARTIC_LOG_DEBUG(logger, message());
+    ARTIC_LOG_INFO(logger, message());
+    ARTIC_LOG_WARNING(logger, message());
+    assert(formatted == (warningCompiledIn ? 1 : 0));
+    assert(sink.lines.size() == (warningCompiledIn ? 1u : 0u));
+    assert(sink.lines.empty() || sink.lines[0].first == LogLevel::Warning);
+
+    std::string tempFile = "test13.atc";
+    FileSystem::writeFile(tempFile, "<div>Logged</div>");
+
+    CompilerOptions options;
+    options.inputFile = tempFile;
+    options.silent = true;
+
+    // Silent: nothing reaches the sink
+    CaptureSink silentSink;
+    Compiler silent(options);
+    silent.setLogSink(&silentSink);
+    assert(silent.compileToString().success);
+    assert(silentSink.lines.empty());
+
+    // Verbose: progress and details
+    options.silent = false;
+    options.verbose = true;
+    options.outputDir = "test13_output";
+    CaptureSink verboseSink;
+    Compiler verbose(options);
+    verbose.setLogSink(&verboseSink);
+    assert(verbose.compile());
+
+    // Errors are logged even when not verbose
+    options.verbose = false;
+    options.inputFile = "test13_missing.atc";
+    CaptureSink errorSink;
+    Compiler failing(options);
+    failing.setLogSink(&errorSink);
+    bool failed = !failing.compile();
+
+    std::filesystem::remove(tempFile);
+    std::filesystem::remove_all("test13_output");
+
+    bool hasDebug = false;
+    for (const auto& [level, text] : verboseSink.lines) {
+        hasDebug = hasDebug || level == LogLevel::Debug;
+    }
+    assert(hasDebug == logLevelCompiledIn(LogLevel::Debug));
+    assert(failed);
+    bool hasError = false;
+    for (const auto& [level, text] : errorSink.lines) {
+        assert(level != LogLevel::Debug);
+        hasError = hasError || level == LogLevel::Error;
+    }
+    assert(hasError == logLevelCompiledIn(LogLevel::Error));
+
+    std::cout << "PASSED ✓\n";
+}
+
+void test14_Metrics() {
+    std::cout << "Test 14: Metrics registry... ";
+
+    // Same name and labels: same series; buckets are cumulative in the export
+    MetricsRegistry metrics;
+    Counter& hits = metrics.counter("test_hits_total", "Hits", {{"kind", "a\"b"}});
+    assert(&hits == &metrics.counter("test_hits_total", "Hits", {{"kind", "a\"b"}}));
+    hits.inc(3);
+    Histogram& latency = metrics.histogram("test_seconds", "Latency", {0.1, 1});
+    latency.observe(0.05);
+    latency.observe(0.5);
+    latency.observe(5);
+    assert(latency.count() == 3 && latency.bucketCounts() == std::vector<std::uint64_t>({1, 1, 1}));
+
+    std::string text = metrics.toPrometheus();
+    assert(text.find("# TYPE test_hits_total counter\n") != std::string::npos);
+    assert(text.find("test_hits_total{kind=\"a\\\"b\"} 3\n") != std::string::npos);
+    assert(text.find("test_seconds_bucket{le=\"0.1\"} 1\n") != std::string::npos);
+    assert(text.find("test_seconds_bucket{le=\"1\"} 2\n") != std::string::npos);
+    assert(text.find("test_seconds_bucket{le=\"+Inf\"} 3\n") != std::string::npos);
+    assert(text.find("test_seconds_count 3\n") != std::string::npos);
+
+    bool rejected = false;
+    try {
+        metrics.histogram("test_hits_total", "Hits", {1});
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    assert(rejected);
+
+    // Compilers sharing a registry accumulate into the same series
+    std::string tempFile = "test14.atc";
+    FileSystem::writeFile(tempFile, "<div>Counted</div>");
+
+    MetricsRegistry compilerMetrics;
+    CompilerOptions options;
+    options.inputFile = tempFile;
+    options.silent = true;
+    options.metrics = &compilerMetrics;
+
+    Compiler first(options);
+    auto result = first.compileToString();
+    Compiler second(options);
+    second.compileToString();
+    second.compileToString();
+
+    options.inputFile = "test14_missing.atc";
+    Compiler failing(options);
+    failing.compileToString();
+
+    std::filesystem::remove(tempFile);
+
+    assert(result.success);
+    CompilerMetrics series(compilerMetrics);
+    assert(series.compilations.value() == 4);
+    assert(series.failures.value() == 1);
+    assert(series.filesParsed.value() == 2);
+    assert(series.componentCacheHits.value() == 1);
+    assert(series.tokensLexed.value() > 0);
+    assert(series.htmlBytes.value() == 3 * result.generatedHtml.size());
+    assert(series.compileSeconds.count() == 4);
+    assert(series.phaseSeconds[static_cast<size_t>(CompilationPhase::Lex)]->count() == 4);
+
+    std::cout << "PASSED ✓\n";
+}
+
+void test15_SharedRegistry() {
+    std::cout << "Test 15: Shared registry with a memory budget... ";
+
+    std::filesystem::create_directories("test15_site");
+    FileSystem::writeFile("test15_site/Badge.atc", "<span>Badge</span>");
+    FileSystem::writeFile("test15_site/Card.atc",
+                          "use { Badge } from \"./Badge\"\n<div class=\"card\"><Badge /><slot /></div>");
+    FileSystem::writeFile("test15_site/Home.atc", "use { Card } from \"./Card\"\n<Card>Home</Card>");
+    FileSystem::writeFile("test15_site/About.atc", "use { Card } from \"./Card\"\n<Card>About</Card>");
+    FileSystem::writeFile("test15_site/Plain.atc", "<p>Plain</p>");
+
+    std::vector<std::string> pages = {"Home", "About", "Plain", "Home"};
+
+    auto optionsFor = [](const std::string& page) {
+        CompilerOptions options;
+        options.inputFile = "test15_site/" + page + ".atc";
+        options.silent = true;
+        return options;
+    };
+
+    // Reference: one registry per page
+    std::vector<std::string> expected;
+    for (const auto& page : pages) {
+        Compiler compiler(optionsFor(page));
+        expected.push_back(compiler.compileToString().generatedHtml);
+    }
+
+    // Unbounded: shared components are parsed once
+    ComponentRegistry unbounded;
+    for (size_t i = 0; i < pages.size(); i++) {
+        Compiler compiler(optionsFor(pages[i]), unbounded);
+        auto result = compiler.compileToString();
+        assert(result.success && result.generatedHtml == expected[i]);
+        assert(unbounded.closure(unbounded.getComponent(pages[i])).size() == (pages[i] == "Plain" ? 1 : 3));
+    }
+    assert(unbounded.getAllComponents().size() == 5);
+
+    // 1-byte budget: only the page being compiled stays; the rest is parsed again
+    MetricsRegistry metrics;
+    ComponentRegistry bounded;
+    bounded.setMemoryBudget(1);
+    for (size_t i = 0; i < pages.size(); i++) {
+        CompilerOptions options = optionsFor(pages[i]);
+        options.metrics = &metrics;
+        Compiler compiler(options, bounded);
+        auto result = compiler.compileToString();
+        assert(result.success && result.generatedHtml == expected[i]);
+    }
+
+    // Unpinning the last page evicted everything
+    CompilerMetrics series(metrics);
+    assert(series.componentEvictions.value() > 0);
+    assert(bounded.getAllComponents().empty() && bounded.memoryUsage() == 0);
+
+    // An import evicted while its importer stayed cached is loaded again
+    ComponentRegistry badgeOnly;
+    badgeOnly.loadComponent("test15_site/Badge.atc");
+    size_t badgeBytes = badgeOnly.memoryUsage();
+    assert(badgeBytes > 0);  // Measured from the AST, whatever the build
+
+    ComponentRegistry registry;
+    registry.loadComponent("test15_site/Home.atc");
+    registry.loadComponent("test15_site/Plain.atc");
+    registry.setMemoryBudget(registry.memoryUsage() - badgeBytes);
+    registry.loadComponent("test15_site/Plain.atc");  // Evicts Badge, least recently used
+    assert(!registry.hasComponent("Badge") && registry.hasComponent("Card"));
+
+    Component* home = registry.loadComponent("test15_site/Home.atc");
+    assert(home && registry.hasComponent("Badge"));
+    assert(registry.closure(home).size() == 3);
+
+    std::filesystem::remove_all("test15_site");
+
+    std::cout << "PASSED ✓\n";
+}
+
+void test16_StreamingMode() {
+    std::cout << "Test 16: Streaming mode... ";
+
+    std::filesystem::create_directories("test16_site");
+    FileSystem::writeFile("test16_site/Card.atc",
+                          "props {\n  title: string = \"Card\"\n}\n<div class=\"card\"><h2>{title}</h2><slot /></div>");
+
+    // Many top-level nodes, some using the imported component
+    std::string page = "use { Card } from \"./Card\"\n"
+                       "@utility\ncard {\n  px:4 py:2\n}\n";
+    for (int i = 0; i < 50; i++) {
+        std::string n = std::to_string(i);
+        page += "<section class:(card)><p>Item " + n + "</p><ul><li>a</li><li>b</li></ul></section>\n";
+        page += "<Card title=\"T" + n + "\"><span>Body " + n + "</span></Card>\n";
+    }
+    FileSystem::writeFile("test16_site/Page.atc", page);
+
+    auto compileTo = [](const std::string& dir, bool stream, bool minify) {
+        CompilerOptions options;
+        options.inputFile = "test16_site/Page.atc";
+        options.outputDir = dir;
+        options.minifyHtml = minify;
+        options.streamTemplate = stream;
+        options.silent = true;
+
+        Compiler compiler(options);
+        assert(compiler.compile());
+        assert(compiler.profile().files.size() == 2);
+        return *FileSystem::readFile(dir + "/index.html") + *FileSystem::readFile(dir + "/style.css");
+    };
+
+    // Byte for byte what a whole-AST compilation writes
+    for (bool minify : {false, true}) {
+        std::string expected = compileTo("test16_full", false, minify);
+        std::string streamed = compileTo("test16_stream", true, minify);
+        assert(expected.find("<h2>T49</h2>") != std::string::npos);
+        assert(streamed == expected);
+    }
+
+    // Needs the whole template
+    CompilerOptions mangled;
+    mangled.inputFile = "test16_site/Page.atc";
+    mangled.outputDir = "test16_stream";
+    mangled.streamTemplate = true;
+    mangled.mangleClassNames = true;
+    mangled.silent = true;
+    Compiler rejected(mangled);
+    assert(!rejected.compile());
+
+    // A syntax error after some nodes were written still fails the build
+    FileSystem::writeFile("test16_site/Broken.atc", "<p>One</p>\n<div>Unclosed\n");
+    CompilerOptions broken;
+    broken.inputFile = "test16_site/Broken.atc";
+    broken.outputDir = "test16_stream";
+    broken.streamTemplate = true;
+    broken.silent = true;
+    Compiler failing(broken);
+    assert(!failing.compile());
+    assert(failing.getLastError().find("Parse error") != std::string::npos);
+
+    std::filesystem::remove_all("test16_site");
+    std::filesystem::remove_all("test16_full");
+    std::filesystem::remove_all("test16_stream");
+
+    std::cout << "PASSED ✓\n";
+}
+
+void test17_FailedBuildKeepsOutput() {
+    std::cout << "Test 17: Failed build keeps the previous output... ";
+
+    std::filesystem::create_directories("test17_site");
+    FileSystem::writeFile("test17_site/Inner.atc", "<p>Inner</p>");
+    FileSystem::writeFile("test17_site/Outer.atc", "use { Inner } from \"./Inner\"\n<Inner />");
+    FileSystem::writeFile("test17_site/Page.atc", "use { Outer } from \"./Outer\"\n<div>Before</div>\n<Outer />");
+
+    CompilerOptions options;
+    options.inputFile = "test17_site/Page.atc";
+    options.outputDir = "test17_out";
+    options.silent = true;
+
+    Compiler good(options);
+    assert(good.compile());
+    std::string previous = *FileSystem::readFile("test17_out/index.html");
+
+    // Rendering fails after part of the page was written
+    options.maxTemplateDepth = 2;
+    for (bool stream : {false, true}) {
+        options.streamTemplate = stream;
+        Compiler failing(options);
+        assert(!failing.compile());
+        assert(failing.getLastError().find("Render depth") != std::string::npos);
+        assert(*FileSystem::readFile("test17_out/index.html") == previous);
+        assert(!std::filesystem::exists("test17_out/index.html.tmp"));
+    }
+
+    std::filesystem::remove_all("test17_site");
+    std::filesystem::remove_all("test17_out");
+
+    std::cout << "PASSED ✓\n";
+}
+
+void test18_SsrNestedSlots() {
+    std::cout << "Test 18: SSR slot callbacks do not shadow the output string... ";
+
+    std::filesystem::create_directories("test18_site");
+    FileSystem::writeFile("test18_site/Card.atc", "<div class=\"card\"><slot /></div>");
+    FileSystem::writeFile("test18_site/Page.atc",
+                          "use { Card } from \"./Card\"\n<main><Card><Card><b>Inner</b></Card></Card></main>");
+
+    CompilerOptions options;
+    options.inputFile = "test18_site/Page.atc";
+    options.outputDir = "test18_out";
+    options.mode = CompilationMode::SSR;
+    options.silent = true;
+
+    Compiler compiler(options);
+    assert(compiler.compile());
+
+    auto source = FileSystem::readFile(options.getSsrOutputPath() / "Page.cpp");
+    assert(source);
+
+    // Each nested callback appends to its own parameter
+    assert(source->find("[&](std::string& out)") == std::string::npos);
+    assert(source->find("slots1.children = [&](std::string& slotOut1) {") != std::string::npos);
+    assert(source->find("slots2.children = [&](std::string& slotOut2) {") != std::string::npos);
+    assert(source->find("renderCard(slotOut1, props2, slots2);") != std::string::npos);
+    assert(source->find("slotOut2.append(\"<b>Inner</b>\"") != std::string::npos);
+    assert(source->find("renderCard(out, props1, slots1);") != std::string::npos);
+
+    std::filesystem::remove_all("test18_site");
+    std::filesystem::remove_all("test18_out");
+
+    std::cout << "PASSED ✓\n";
+}
+
+void test19_SsrMatchesStaticOutput() {
+    std::cout << "Test 19: Compiled SSR render functions match static output... ";
+
+#ifdef ARTIC_TEST_CXX
+    std::filesystem::create_directories("test19_site");
+    FileSystem::writeFile("test19_site/Badge.atc",
+                          "props {\n  label: string = \"a & b &amp; <c> 'd'\",\n  count: number = 1234567,\n"
+                          "  on: boolean = true\n}\n"
+                          "<span>{label} {count}<slot /></span>"
+                          "<i>{label + \"!\"}</i><u>{on ? \"yes\" : count}</u><s>{count * 2 + 0.5}</s>"
+                          "<em>{count > 5 && !on || label}</em><q>{count / 0}</q><b>{'' + (count === 0.0000001)}</b>");
+    FileSystem::writeFile("test19_site/Page.atc",
+                          "use { Badge } from \"./Badge\"\n"
+                          "<main><Badge /><Badge count=\"10000000000000000\"><b>x</b></Badge>"
+                          "<Badge label=\"&copy; &#169;\" count=\"0.0000001\" on=\"false\" /></main>");
+
+    CompilerOptions options;
+    options.inputFile = "test19_site/Page.atc";
+    options.outputDir = "test19_out";
+    options.minifyHtml = true;  // SSR static chunks are never indented
+    options.silent = true;
+
+    Compiler ssg(options);
+    assert(ssg.compile());
+    auto expected = FileSystem::readFile(options.getHtmlOutputPath());
+    assert(expected);
+
+    options.mode = CompilationMode::SSR;
+    Compiler ssr(options);
+    assert(ssr.compile());
+
+    // Build the generated sources with a small driver and run it
+    auto ssrPath = options.getSsrOutputPath();
+    FileSystem::writeFile((ssrPath / "main.cpp").string(),
+                          "#include \"Page.h\"\n#include <iostream>\n"
+                          "int main() { std::string out; artic_pages::renderPagePage(out, {}); std::cout << out; }\n");
+    std::string dir = ssrPath.string();
+    std::string command = std::string("\"") + ARTIC_TEST_CXX + "\" -std=c++17 -Wall -Wextra -Wshadow -Werror" +
+                          " -I" + dir + " " + dir + "/Badge.cpp " + dir + "/Page.cpp " + dir + "/main.cpp" +
+                          " -o " + dir + "/page && " + dir + "/page > " + dir + "/page.html";
+    assert(std::system(command.c_str()) == 0);
+
+    auto rendered = FileSystem::readFile(ssrPath / "page.html");
+    assert(rendered && *rendered == *expected);
+    assert(expected->find("1234567") != std::string::npos);
+    assert(expected->find("10000000000000000") != std::string::npos);
+    assert(expected->find("1e-7") != std::string::npos);
+    assert(expected->find("a &amp; b &amp; &lt;c&gt; 'd'") != std::string::npos);
+    assert(expected->find("&copy; &#169;") != std::string::npos);
+    assert(expected->find("<i>&copy; &#169;!</i><u>1e-7</u><s>0.5000002</s><em>&copy; &#169;</em><q></q><b>true</b>") !=
+           std::string::npos);
+    assert(expected->find("<u>yes</u><s>2469134.5</s><em>a &amp; b") != std::string::npos);
+
+    std::filesystem::remove_all("test19_site");
+    std::filesystem::remove_all("test19_out");
+
+    std::cout << "PASSED ✓\n";
+#else
+    std::cout << "SKIPPED (no compiler for generated sources)\n";
+#endif
+}
+
 int main() {
     std::cout << "=================================\n";
     std::cout << "  COMPILER UNIT TESTS\n";
@@ -244,6 +915,17 @@ int main() {
         test6_CompileToDisk();
         test7_MinifyCss();
         test8_IncludeDoctype();
+        test9_MangleClassNames();
+        test10_SsrMode();
+        test11_PhaseProfile();
+        test12_SizeBudgets();
+        test13_Logging();
+        test14_Metrics();
+        test15_SharedRegistry();
+        test16_StreamingMode();
+        test17_FailedBuildKeepsOutput();
+        test18_SsrNestedSlots();
+        test19_SsrMatchesStaticOutput();
 
         std::cout << "\n=================================\n";
         std::cout << "  ALL TESTS PASSED! ✓\n";
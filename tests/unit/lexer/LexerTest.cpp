@@ -14,7 +14,7 @@ void testBasicTokens() {
     Lexer lexer("( ) { } [ ] , ; : = => < > </ />");
     auto tokens = lexer.tokenize();
 
-    assert(tokens.size() == 17); // 16 tokens + EOF
+    assert(tokens.size() == 16); // 15 tokens + EOF
     assert(tokens[0].type == TokenType::LPAREN);
     assert(tokens[1].type == TokenType::RPAREN);
     assert(tokens[2].type == TokenType::LBRACE);
@@ -217,6 +217,25 @@ void testLineAndColumn() {
     std::cout << "PASSED\n";
 }
 
+void testOperators() {
+    std::cout << "Test: Operators... ";
+
+    Lexer lexer("= : ? | . + - * ! % &");
+    auto tokens = lexer.tokenize();
+
+    assert(tokens.size() == 12); // 11 operators + EOF
+    for (size_t i = 0; i + 1 < tokens.size(); i++) {
+        assert(tokens[i].isOperator());
+    }
+    assert(tokens[10].type == TokenType::AMPERSAND);
+    assert(!tokens[11].isOperator());
+
+    Token paren(TokenType::LPAREN, "(", 1, 1);
+    assert(!paren.isOperator());
+
+    std::cout << "PASSED\n";
+}
+
 int main() {
     std::cout << "=== Artic Lexer Tests ===\n\n";
 
@@ -229,6 +248,7 @@ int main() {
     testComments();
     testCompleteExample();
     testLineAndColumn();
+    testOperators();
 
     std::cout << "\n=== All Tests Passed! ===\n";
 
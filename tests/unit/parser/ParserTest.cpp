@@ -267,6 +267,77 @@ void test11_CompleteComponent() {
     std::cout << "PASSED ✓\n";
 }
 
+void test12_NestingDepthLimit() {
+    std::cout << "[TEST 12] Deep nesting and depth limit... ";
+
+    // Nesting is parsed without recursion; siblings after deep subtrees attach correctly
+    std::string source;
+    for (int i = 0; i < 2000; i++) source += "<div>";
+    source += "deep";
+    for (int i = 0; i < 2000; i++) source += "</div>";
+    source = "<section>" + source + "<p>after</p></section>";
+
+    Lexer lexer(source);
+    auto tokens = lexer.tokenize();
+
+    Parser parser(tokens, 4096);
+    auto component = parser.parse();
+
+    auto* section = dynamic_cast<Element*>(component->templateNodes[0].get());
+    assert(section != nullptr);
+    assert(section->children.size() == 2);
+    auto* after = dynamic_cast<Element*>(section->children[1].get());
+    assert(after != nullptr && after->tagName == "p");
+
+    // Exceeding the limit is a parse error, not a crash
+    bool threw = false;
+    try {
+        Parser limited(tokens, 100);
+        limited.parse();
+    } catch (const ParseError& e) {
+        threw = std::string(e.what()).find("maximum depth of 100") != std::string::npos;
+    }
+    assert(threw);
+
+    // Mismatched closing tags are still reported for the innermost element
+    Lexer badLexer("<div><span>x</div></span>");
+    auto badTokens = badLexer.tokenize();
+    threw = false;
+    try {
+        Parser bad(badTokens);
+        bad.parse();
+    } catch (const ParseError& e) {
+        threw = std::string(e.what()).find("'div' doesn't match opening tag 'span'") != std::string::npos;
+    }
+    assert(threw);
+
+    std::cout << "PASSED ✓\n";
+}
+
+void test13_ExpressionSource() {
+    std::cout << "[TEST 13] Expression source is kept verbatim... ";
+
+    Lexer lexer(R"(<p>{title + " - " + count*2}</p><p>{ok && !done ? 'a' : "b"}</p>)");
+    auto tokens = lexer.tokenize();
+
+    Parser parser(tokens);
+    auto component = parser.parse();
+
+    auto expressionOf = [&](size_t index) {
+        auto* p = dynamic_cast<Element*>(component->templateNodes[index].get());
+        assert(p != nullptr && p->children.size() == 1);
+        auto* expr = dynamic_cast<ExpressionNode*>(p->children[0].get());
+        assert(expr != nullptr);
+        return expr->expression;
+    };
+
+    // Strings are re-quoted and spacing follows the source
+    assert(expressionOf(0) == R"(title + " - " + count*2)");
+    assert(expressionOf(1) == R"(ok && !done ? "a" : "b")");
+
+    std::cout << "PASSED ✓" << std::endl;
+}
+
 int main() {
     std::cout << "=================================\n";
     std::cout << "  ARTIC PARSER TESTS (Phase 1)  \n";
@@ -284,6 +355,8 @@ int main() {
         test9_SelfClosingElement();
         test10_NestedElements();
         test11_CompleteComponent();
+        test12_NestingDepthLimit();
+        test13_ExpressionSource();
 
         std::cout << "\n=================================\n";
         std::cout << "  ALL TESTS PASSED!  \n";